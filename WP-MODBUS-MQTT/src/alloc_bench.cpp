@@ -0,0 +1,66 @@
+#include "alloc_bench.h"
+
+#ifdef ALLOC_BENCH
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+
+volatile uint32_t allocPollCycle = 0;
+volatile uint32_t allocPublish = 0;
+
+static TaskHandle_t benchTasks[ALLOC_SLOTS] = {};
+// Jeder Zaehler wird nur vom eigenen Task erhoeht -> kein Lock noetig; gelesen wird er ebenfalls dort.
+static volatile uint32_t benchCounts[ALLOC_SLOTS] = {};
+
+void allocBenchRegister(uint8_t slot)
+{
+	if (slot < ALLOC_SLOTS)
+	{
+		benchCounts[slot] = 0;
+		benchTasks[slot] = xTaskGetCurrentTaskHandle();
+	}
+}
+
+uint32_t allocBenchCount(uint8_t slot)
+{
+	return slot < ALLOC_SLOTS ? benchCounts[slot] : 0;
+}
+
+// Vor dem Scheduler-Start bzw. aus nicht registrierten Tasks: nicht zaehlen.
+static inline void countAlloc()
+{
+	TaskHandle_t self = xTaskGetCurrentTaskHandle();
+	for (uint8_t i = 0; i < ALLOC_SLOTS; ++i)
+	{
+		if (self != nullptr && benchTasks[i] == self)
+		{
+			benchCounts[i] = benchCounts[i] + 1;
+			return;
+		}
+	}
+}
+
+extern "C"
+{
+	void *__real_malloc(size_t size);
+	void *__real_calloc(size_t n, size_t size);
+	void *__real_realloc(void *ptr, size_t size);
+
+	void *__wrap_malloc(size_t size)
+	{
+		countAlloc();
+		return __real_malloc(size);
+	}
+
+	void *__wrap_calloc(size_t n, size_t size)
+	{
+		countAlloc();
+		return __real_calloc(n, size);
+	}
+
+	void *__wrap_realloc(void *ptr, size_t size)
+	{
+		countAlloc();
+		return __real_realloc(ptr, size);
+	}
+}
+#endif // ALLOC_BENCH
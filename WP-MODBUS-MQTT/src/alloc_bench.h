@@ -0,0 +1,32 @@
+#ifndef SRC_ALLOC_BENCH_H_
+#define SRC_ALLOC_BENCH_H_
+
+#include "Arduino.h"
+
+// Allokationszaehler fuer die Messung "Heap-Allokationen je Poll-Zyklus und /data-Publish" (nur in
+// den Bench-Builds, -DALLOC_BENCH, siehe platformio.ini). malloc/calloc/realloc werden per Linker
+// (-Wl,--wrap=...) umgeleitet; gezaehlt wird nur, was ein registrierter Task selbst anfordert
+// (Worker bzw. Loop), damit AsyncTCP/WiFi die Zahl nicht verfaelschen. operator new und String
+// landen ebenfalls in malloc/realloc. Gezaehlt werden Aufrufe, nicht Bytes; realloc zaehlt immer
+// mit (String-Wachstum ist genau die gesuchte Last).
+//
+// Vergleich alte/neue Log-Aufrufe: ESP32_alloc_bench (LOGF wie im Betrieb) gegen
+// ESP32_alloc_bench_legacy (-DLOG_EAGER_STRING, log.h: jede Meldung baut vor der Level-Pruefung
+// einen String wie die frueheren log(level, "..." + String(x)) -Aufrufe).
+
+#define ALLOC_SLOT_WORKER 0 // Modbus-Worker: Poll-Transaktionen
+#define ALLOC_SLOT_LOOP 1	// Loop-Task: publishModbusUpdate()
+#define ALLOC_SLOTS 2
+
+#ifdef ALLOC_BENCH
+// Den aufrufenden Task fuer slot zaehlen lassen (einmal beim Task-Start).
+void allocBenchRegister(uint8_t slot);
+// Allokationen des Tasks von slot seit dem Registrieren (Differenz zweier Werte = Kosten dazwischen).
+uint32_t allocBenchCount(uint8_t slot);
+
+// Ergebnis des letzten vollstaendigen Poll-Zyklus bzw. Publishs (fuer das /status-JSON).
+extern volatile uint32_t allocPollCycle;
+extern volatile uint32_t allocPublish;
+#endif // ALLOC_BENCH
+
+#endif // SRC_ALLOC_BENCH_H_
@@ -0,0 +1,108 @@
+#ifndef SRC_JSON_POOL_H_
+#define SRC_JSON_POOL_H_
+
+#include <ArduinoJson.h>
+
+// Bump-Allocator fuer ArduinoJson ueber einen festen, statischen Puffer. Fuer den periodischen
+// /data-Publish: bisher holte jedes JsonDocument seine Slot-Pools und kopierten Schluessel vom Heap,
+// dazu kam der malloc()-Puffer fuers Serialisieren -> Heap-Churn und Fragmentierung im heissesten
+// Pfad. Mit diesem Allocator bleibt der Heap unberuehrt.
+//
+// Gebrauch (nur aus EINEM Task, genau ein Dokument zur Zeit):
+//   pool.reset();
+//   { JsonDocument doc(&pool); ... }   // Dokument muss vor dem naechsten reset() zerstoert sein
+// Jeder Block traegt seine Groesse im Kopf (fuer reallocate). deallocate gibt nur den zuletzt
+// vergebenen Block zurueck (LIFO, z.B. shrinkToFit/Pool-Liste), alles andere erst reset().
+// Ist der Puffer voll, liefert allocate nullptr -> ArduinoJson meldet doc.overflowed().
+template <size_t N>
+class JsonPoolAllocator : public ArduinoJson::Allocator
+{
+public:
+	void *allocate(size_t size) override
+	{
+		size_t need = kHeader + align(size);
+		if (used_ + need > N)
+		{
+			failures_++;
+			return nullptr;
+		}
+		uint8_t *block = buf_ + used_;
+		*reinterpret_cast<size_t *>(block) = size;
+		last_ = block + kHeader;
+		used_ += need;
+		if (used_ > highWater_)
+		{
+			highWater_ = used_;
+		}
+		return last_;
+	}
+
+	void deallocate(void *ptr) override
+	{
+		if (ptr != nullptr && ptr == last_)
+		{
+			used_ = static_cast<uint8_t *>(ptr) - kHeader - buf_;
+			last_ = nullptr;
+		}
+	}
+
+	void *reallocate(void *ptr, size_t new_size) override
+	{
+		if (ptr == nullptr)
+		{
+			return allocate(new_size);
+		}
+		size_t *size = reinterpret_cast<size_t *>(static_cast<uint8_t *>(ptr) - kHeader);
+		if (ptr == last_)
+		{
+			// Letzter Block: an Ort und Stelle wachsen/schrumpfen
+			size_t begin = static_cast<uint8_t *>(ptr) - buf_;
+			if (begin + align(new_size) > N)
+			{
+				failures_++;
+				return nullptr;
+			}
+			*size = new_size;
+			used_ = begin + align(new_size);
+			if (used_ > highWater_)
+			{
+				highWater_ = used_;
+			}
+			return ptr;
+		}
+		if (new_size <= *size)
+		{
+			*size = new_size;
+			return ptr;
+		}
+		void *moved = allocate(new_size);
+		if (moved != nullptr)
+		{
+			memcpy(moved, ptr, *size);
+		}
+		return moved;
+	}
+
+	void reset()
+	{
+		used_ = 0;
+		last_ = nullptr;
+	}
+
+	// Fuer das /status-JSON: groesste Belegung seit Boot bzw. Zahl der Ueberlaeufe.
+	size_t highWater() const { return highWater_; }
+	uint32_t failures() const { return failures_; }
+
+private:
+	static constexpr size_t kAlign = 8;
+	static constexpr size_t kHeader = (sizeof(size_t) + kAlign - 1) & ~(kAlign - 1);
+	static constexpr size_t align(size_t n) { return (n + kAlign - 1) & ~(kAlign - 1); }
+
+	alignas(8) uint8_t buf_[N];
+	size_t used_ = 0;
+	uint8_t *last_ = nullptr;
+	size_t highWater_ = 0;
+	uint32_t failures_ = 0;
+};
+
+#endif // SRC_JSON_POOL_H_
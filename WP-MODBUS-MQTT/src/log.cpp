@@ -1,16 +1,56 @@
 #include "log.h"
+#include "log_syslog.h"
 
 #include <LittleFS.h>
+#include <stdarg.h>
 #include <time.h>
 #include <esp_system.h>
+#include <esp_attr.h>
+#include <esp_rom_crc.h>
+#include <stddef.h>
 #include "freertos/FreeRTOS.h"
 #include "freertos/semphr.h"
+#include "freertos/task.h"
 
 volatile int16_t fileLogLevel = LOG_LEVEL_WARNING;
 
 static SemaphoreHandle_t logMutex = nullptr;
 static bool fileLogReady = false;
 
+// RAM-Ring fuer fertige Logzeilen. head/tail zaehlen monoton (Position = Wert % LOG_RING_BYTES).
+// Produzenten (beliebige Tasks) reservieren und kopieren unter logRingMux (nur memcpy, keine I/O);
+// es gibt genau einen Konsumenten zur Zeit (Writer-Task bzw. flushFileLog, beide unter logMutex),
+// der [tail, head) ausserhalb des Spinlocks schreibt — Produzenten fassen diesen Bereich nie an.
+static char logRing[LOG_RING_BYTES];
+static size_t ringHead = 0;
+static size_t ringTail = 0;
+static portMUX_TYPE logRingMux = portMUX_INITIALIZER_UNLOCKED;
+static TaskHandle_t logWriterHandle = nullptr;
+static volatile uint32_t droppedLines = 0;
+static uint32_t reportedDrops = 0; // bereits als Hinweiszeile ins Log geschrieben (nur Konsument)
+static volatile uint32_t flashWrites = 0;
+// Segmente des laufenden Sets (nur Konsument bzw. initFileLog, unter logMutex).
+static uint32_t curFirstSeq = 0;
+static uint32_t curLastSeq = 0;
+static size_t curSegBytes = 0; // Groesse des juengsten Segments, statt f.size() je Flush
+static uint32_t curStoredBytes = 0; // belegte Flash-Bytes der abgeschlossenen Segmente von current
+static bool curSyncHasEpoch = false; // letzter Zeit-Sync im juengsten Segment hatte schon die Wanduhr
+static bool previousIsCrash = false;
+
+// Breadcrumb-Ring im RTC-RAM (siehe LOG_CRUMB_BYTES). RTC_NOINIT: wird beim Reset NICHT genullt.
+// head zaehlt monoton wie beim RAM-Ring; crc deckt magic + head ab und wird je Zeile nachgefuehrt.
+#define LOG_CRUMB_MAGIC 0x4C435242UL // "LCRB"
+typedef struct
+{
+	uint32_t magic;
+	uint32_t head;
+	uint32_t crc;
+} crumb_header_t;
+static RTC_NOINIT_ATTR crumb_header_t crumbHeader;
+static RTC_NOINIT_ATTR uint8_t crumbRing[LOG_CRUMB_BYTES];
+static portMUX_TYPE crumbMux = portMUX_INITIALIZER_UNLOCKED;
+static bool crumbsReady = false; // erst nach der Auswertung in initFileLog beschreiben
+
 bool logFsLock(uint32_t timeout_ms)
 {
 	if (logMutex == nullptr)
@@ -29,17 +69,110 @@ void logFsUnlock()
 }
 
 // Wanduhr-Zeitstempel via NTP (configTime() laeuft beim WLAN-Setup). Solange NTP noch nicht
-// synchron ist (fruehe Bootphase), Fallback auf Uptime "+<millis>ms".
-static String logTimestamp()
+// synchron ist (fruehe Bootphase), Fallback auf Uptime "+<millis>ms". Schreibt nach buf (>= 20).
+static void logTimestamp(char *buf, size_t len)
 {
 	struct tm now;
 	if (getLocalTime(&now, 0))
 	{
-		char buf[20];
-		strftime(buf, sizeof(buf), "%Y-%m-%d %H:%M:%S", &now);
-		return String(buf);
+		strftime(buf, len, "%Y-%m-%d %H:%M:%S", &now);
+		return;
+	}
+	snprintf(buf, len, "+%lums", (unsigned long)millis());
+}
+
+// Unix-Sekunden fuer Zeit-Sync-Records; 0 = NTP noch nicht synchron (Uhr steht dann bei 1970).
+static uint32_t logEpochNow()
+{
+	time_t now = time(nullptr);
+	return now > 1600000000 ? (uint32_t)now : 0;
+}
+
+// Formatstring-Registry: Meldungs-ID -> Formatstring (liegt im Flash, Zeiger bleibt gueltig).
+// Offene Adressierung; ein Platz wird genau einmal belegt (fmt vor id), Leser brauchen keinen Lock.
+typedef struct
+{
+	volatile uint32_t id; // 0 = frei
+	const char *volatile fmt;
+} log_fmt_slot_t;
+static log_fmt_slot_t fmtRegistry[LOG_FMT_REGISTRY_SIZE];
+static portMUX_TYPE fmtMux = portMUX_INITIALIZER_UNLOCKED;
+
+static const char *lookupFormat(uint32_t id)
+{
+	for (uint32_t i = 0; i < LOG_FMT_REGISTRY_SIZE; ++i)
+	{
+		const log_fmt_slot_t &slot = fmtRegistry[(id + i) & (LOG_FMT_REGISTRY_SIZE - 1)];
+		if (slot.id == id)
+		{
+			return slot.fmt;
+		}
+		if (slot.id == 0)
+		{
+			break;
+		}
+	}
+	return nullptr;
+}
+
+static void registerFormat(uint32_t id, const char *format)
+{
+	if (lookupFormat(id) != nullptr)
+	{
+		return; // der Normalfall: nur ein paar Vergleiche, kein Lock
+	}
+	portENTER_CRITICAL(&fmtMux);
+	for (uint32_t i = 0; i < LOG_FMT_REGISTRY_SIZE; ++i)
+	{
+		log_fmt_slot_t &slot = fmtRegistry[(id + i) & (LOG_FMT_REGISTRY_SIZE - 1)];
+		if (slot.id == id)
+		{
+			break; // parallel eingetragen
+		}
+		if (slot.id == 0)
+		{
+			slot.fmt = format;
+			slot.id = id;
+			break;
+		}
+	}
+	portEXIT_CRITICAL(&fmtMux);
+}
+
+// Snprintf-Rueckgabe auf den tatsaechlich geschriebenen Teil begrenzen (room inkl. Terminator).
+static size_t clampWritten(int m, size_t room)
+{
+	if (m < 0 || room == 0)
+	{
+		return 0;
 	}
-	return "+" + String(millis()) + "ms";
+	return (size_t)m < room ? (size_t)m : room - 1;
+}
+
+// Meldungstext eines Records (ohne Zeit/Level/Zeilenende, terminiert) nach out; Rueckgabe = Laenge.
+static size_t recordMessage(const log_record_t &rec, char *out, size_t len)
+{
+	size_t n = 0;
+	if (rec.msg_id == LOG_MSG_TEXT)
+	{
+		n = rec.payload_len < len - 1 ? rec.payload_len : len - 1;
+		memcpy(out, rec.payload, n);
+	}
+	else if (const char *format = lookupFormat(rec.msg_id))
+	{
+		return logRecordFormat(out, len, format, rec.payload, rec.payload_len);
+	}
+	else
+	{
+		// Formatstring in diesem Boot (noch) unbekannt: ID + Rohbytes, tools/logdecode.py kennt ihn.
+		n = clampWritten(snprintf(out, len, "[#%08lx]", (unsigned long)rec.msg_id), len);
+		for (size_t i = 0; i < rec.payload_len && len - n > 3; ++i)
+		{
+			n += snprintf(out + n, len - n, " %02x", rec.payload[i]);
+		}
+	}
+	out[n] = 0;
+	return n;
 }
 
 static const char *resetReasonStr()
@@ -60,70 +193,918 @@ static const char *resetReasonStr()
 	}
 }
 
-// Kappt /log.txt auf die letzte Haelfte (Tail-Erhalt), ohne grosse RAM-Allokation: kopiert ab
-// dem Schnittpunkt chunkweise in /log.tmp und benennt um. Wird aus log() unter gehaltenem Mutex
-// gerufen, sobald die Datei FILE_LOG_MAX_BYTES ueberschreitet.
-static void trimCurrentLog()
+static void segmentPath(char *buf, size_t len, const char *set, uint32_t seq, const char *ext = "log")
+{
+	snprintf(buf, len, "%s/%lu.%s", set, (unsigned long)seq, ext);
+}
+
+// Kleinste/groesste Segmentnummer eines Sets (Verzeichnis-Scan, hoechstens LOG_SEGMENT_MAX_COUNT
+// Eintraege). false = Set leer bzw. nicht vorhanden. Aufrufer haelt logMutex (bzw. Boot).
+static bool segmentRange(const char *set, uint32_t *first, uint32_t *last)
+{
+	File dir = LittleFS.open(set);
+	if (!dir || !dir.isDirectory())
+	{
+		return false;
+	}
+	bool any = false;
+	for (File f = dir.openNextFile(); f; f = dir.openNextFile())
+	{
+		const char *name = strrchr(f.name(), '/');
+		uint32_t seq = strtoul(name != nullptr ? name + 1 : f.name(), nullptr, 10);
+		if (!any || seq < *first)
+		{
+			*first = seq;
+		}
+		if (!any || seq > *last)
+		{
+			*last = seq;
+		}
+		any = true;
+	}
+	return any;
+}
+
+// Belegte Bytes der Datei (0 = fehlt).
+static uint32_t storedSize(const char *path)
+{
+	File f = LittleFS.open(path, "r");
+	uint32_t size = f ? f.size() : 0;
+	f.close();
+	return size;
+}
+
+// Loescht ein Segment in jeder Form (.lz, .log, Rest eines abgebrochenen Umschreibens) und liefert
+// die dadurch frei gewordenen Bytes.
+static uint32_t removeSegment(const char *set, uint32_t seq)
+{
+	static const char *const exts[] = {"lz", "log", "tmp"};
+	uint32_t freed = 0;
+	char path[32];
+	for (const char *ext : exts)
+	{
+		segmentPath(path, sizeof(path), set, seq, ext);
+		if (LittleFS.exists(path))
+		{
+			freed += storedSize(path);
+			LittleFS.remove(path);
+		}
+	}
+	return freed;
+}
+
+// Loescht alle Segmente eines Sets und das Verzeichnis selbst.
+static void removeSet(const char *set)
+{
+	uint32_t first, last;
+	if (segmentRange(set, &first, &last))
+	{
+		for (uint32_t seq = first; seq <= last; ++seq)
+		{
+			removeSegment(set, seq);
+		}
+	}
+	LittleFS.rmdir(set);
+}
+
+static size_t lzReadFile(void *ctx, uint8_t *buf, size_t len)
+{
+	return ((File *)ctx)[0].read(buf, len);
+}
+
+static size_t lzWriteFile(void *ctx, const uint8_t *buf, size_t len)
+{
+	return ((File *)ctx)[1].write(buf, len);
+}
+
+// Ersetzt ein abgeschlossenes Segment "<seq>.log" durch "<seq>.lz" (ueber "<seq>.tmp"; erst
+// umbenennen, dann das Original loeschen -> ein Reset dazwischen hinterlaesst hoechstens ein
+// Duplikat, gelesen wird dann .lz). Bleibt es unkomprimiert kleiner, bleibt das Original.
+// Rueckgabe: danach belegte Bytes. Aufrufer haelt logMutex (bzw. Boot).
+static uint32_t compressSegment(const char *set, uint32_t seq)
+{
+	char path[32], lzPath[32], tmpPath[32];
+	segmentPath(path, sizeof(path), set, seq);
+	segmentPath(lzPath, sizeof(lzPath), set, seq, "lz");
+	segmentPath(tmpPath, sizeof(tmpPath), set, seq, "tmp");
+	if (LittleFS.exists(lzPath))
+	{
+		if (LittleFS.exists(path))
+		{
+			LittleFS.remove(path); // Rest eines unterbrochenen Laufs
+		}
+		return storedSize(lzPath);
+	}
+	File io[2] = {LittleFS.open(path, "r"), File()};
+	if (!io[0])
+	{
+		return 0;
+	}
+	uint32_t raw = io[0].size();
+	io[1] = LittleFS.open(tmpPath, "w");
+	size_t packed = io[1] ? logLzCompress(raw, lzReadFile, lzWriteFile, io) : 0;
+	io[0].close();
+	io[1].close();
+	if (packed == 0 || packed >= raw)
+	{
+		LittleFS.remove(tmpPath);
+		return raw;
+	}
+	LittleFS.rename(tmpPath, lzPath);
+	LittleFS.remove(path);
+	return packed;
+}
+
+// Beim Boot: alle noch offenen Segmente eines archivierten Sets komprimieren.
+static void compressSet(const char *set)
 {
-	File in = LittleFS.open(FILE_LOG_PATH_CURRENT, "r");
-	if (!in)
+	uint32_t first, last;
+	if (segmentRange(set, &first, &last))
+	{
+		for (uint32_t seq = first; seq <= last; ++seq)
+		{
+			compressSegment(set, seq);
+		}
+	}
+}
+
+// Rotation im laufenden Betrieb: juengstes Segment voll -> komprimieren und das naechste beginnen.
+// Passen die abgeschlossenen Segmente plus ein volles juengstes nicht mehr ins Budget (bzw. sind
+// es mehr als LOG_SEGMENT_MAX_COUNT), faellt das aelteste weg (ein remove, keine Kopie). Das
+// Komprimieren (~8 KB lesen, ~3 KB schreiben) laeuft im Writer-Task; die Produzenten schreiben
+// waehrenddessen weiter in den Ring.
+static void rotateSegmentIfFull()
+{
+	if (curSegBytes < LOG_SEGMENT_BYTES)
 	{
 		return;
 	}
-	size_t size = in.size();
-	size_t keep = FILE_LOG_MAX_BYTES / 2;
-	size_t startAt = (size > keep) ? (size - keep) : 0;
-	in.seek(startAt, SeekSet);
-	// Bis zum naechsten Zeilenumbruch vorruecken, damit die erste Zeile nicht zerschnitten ist.
-	while (in.available())
+	curStoredBytes += compressSegment(FILE_LOG_SET_CURRENT, curLastSeq);
+	curLastSeq++;
+	curSegBytes = 0;
+	while (curFirstSeq < curLastSeq && (curStoredBytes + LOG_SEGMENT_BYTES > FILE_LOG_MAX_BYTES ||
+										curLastSeq - curFirstSeq + 1 > LOG_SEGMENT_MAX_COUNT))
+	{
+		uint32_t freed = removeSegment(FILE_LOG_SET_CURRENT, curFirstSeq++);
+		curStoredBytes -= freed < curStoredBytes ? freed : curStoredBytes;
+	}
+}
+
+// Oeffnet das juengste Segment zum Anhaengen; ein neues (bzw. eines ohne Wanduhr, wenn NTP
+// inzwischen synchron ist) bekommt zuerst einen Zeit-Sync, damit es fuer sich dekodierbar bleibt.
+static File openCurrentSegment(size_t &written)
+{
+	char path[32];
+	segmentPath(path, sizeof(path), FILE_LOG_SET_CURRENT, curLastSeq);
+	File f = LittleFS.open(path, "a");
+	uint32_t epoch = logEpochNow();
+	if (f && (curSegBytes == 0 || (epoch != 0 && !curSyncHasEpoch)))
 	{
-		if (in.read() == '\n')
+		uint8_t rec[16];
+		written += f.write(rec, logRecordEncodeSync(rec, sizeof(rec), millis(), epoch));
+		curSyncHasEpoch = epoch != 0;
+	}
+	return f;
+}
+
+// Kopiert count Bytes ab der monotonen Ring-Position pos nach out (Umlauf am Ring-Ende).
+static void ringCopy(uint8_t *out, size_t pos, size_t count)
+{
+	size_t at = pos % LOG_RING_BYTES;
+	size_t first = count < LOG_RING_BYTES - at ? count : LOG_RING_BYTES - at;
+	memcpy(out, logRing + at, first);
+	memcpy(out + first, logRing, count - first);
+}
+
+// Konsument: verteilt die Records im Ring an ihre Senken -- Datei-Log (alles bis fileLogLevel, mit
+// EINEM open/close ins juengste Segment) und Syslog (bis syslogLevel, log_syslog.h). Im Ring steht,
+// was mindestens eine Senke will (siehe logEmit). Aufrufer haelt logMutex.
+static void flushRingLocked()
+{
+	portENTER_CRITICAL(&logRingMux);
+	size_t head = ringHead;
+	size_t tail = ringTail;
+	uint32_t drops = droppedLines;
+	portEXIT_CRITICAL(&logRingMux);
+	if (head == tail && drops == reportedDrops)
+	{
+		return;
+	}
+	File f;
+	bool opened = false;
+	size_t written = 0;
+	uint8_t rec[LOG_LINE_MAX_BYTES];
+	char message[LOG_LINE_MAX_BYTES];
+	while (tail != head)
+	{
+		size_t avail = head - tail < sizeof(rec) ? head - tail : sizeof(rec);
+		ringCopy(rec, tail, avail);
+		log_record_t parsed;
+		int r = logRecordParse(rec, avail, parsed);
+		if (r <= 0)
 		{
+			tail = head; // kann nicht sein (Produzenten schreiben ganze Records) -> Ring verwerfen
 			break;
 		}
+		if (parsed.level <= fileLogLevel)
+		{
+			if (!opened)
+			{
+				f = openCurrentSegment(written);
+				opened = true;
+			}
+			if (!f)
+			{
+				break; // Rest bleibt im Ring, naechster Versuch beim naechsten Flush
+			}
+			written += f.write(rec, r);
+		}
+		if (syslogActive() && syslogLevel != 0 && parsed.level <= syslogLevel)
+		{
+			recordMessage(parsed, message, sizeof(message));
+			syslogRecord(parsed, rec, r, message);
+		}
+		tail += r;
+	}
+	syslogFlush();
+	if (drops != reportedDrops)
+	{
+		if (!opened)
+		{
+			f = openCurrentSegment(written);
+			opened = true;
+		}
+		if (f)
+		{
+			char line[64];
+			int n = snprintf(line, sizeof(line), "Log-Ring voll: %lu Zeile(n) verworfen", (unsigned long)(drops - reportedDrops));
+			written += f.write(rec, logRecordEncodeRaw(rec, sizeof(rec), LOG_LEVEL_WARNING, millis(), LOG_MSG_TEXT, (const uint8_t *)line, n));
+			reportedDrops = drops;
+		}
+	}
+	portENTER_CRITICAL(&logRingMux);
+	ringTail = tail; // erst jetzt frei fuer die Produzenten
+	portEXIT_CRITICAL(&logRingMux);
+	if (f)
+	{
+		f.close();
+		flashWrites++;
+		curSegBytes += written;
+		rotateSegmentIfFull();
+	}
+}
+
+// Writer-Task: wartet auf das Intervall bzw. einen Weckruf aus log() (Schwelle erreicht).
+static void logWriterTask(void *pvParameters)
+{
+	for (;;)
+	{
+		ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(LOG_FLUSH_INTERVAL_MS));
+		syslogMaintain(); // ggf. DNS, blockiert nur diesen Task (ohne Log-Mutex)
+		if (logFsLock(1000))
+		{
+			flushRingLocked();
+			logFsUnlock();
+		}
 	}
+}
 
-	File out = LittleFS.open(FILE_LOG_PATH_TMP, "w");
-	if (!out)
+void requestFileLogFlush()
+{
+	if (logWriterHandle != nullptr)
 	{
-		in.close();
+		xTaskNotifyGive(logWriterHandle);
+	}
+}
+
+void flushFileLog()
+{
+	if (fileLogReady && logFsLock(1000))
+	{
+		flushRingLocked();
+		logFsUnlock();
+	}
+}
+
+const char *logPreviousSet()
+{
+	return previousIsCrash ? FILE_LOG_SET_CRASH : FILE_LOG_SET_PREVIOUS;
+}
+
+bool logSetExists(const char *set)
+{
+	uint32_t first, last;
+	if (!logFsLock(2000))
+	{
+		return true; // im Zweifel versuchen, logSetRead liefert dann ggf. nichts
+	}
+	bool any = segmentRange(set, &first, &last);
+	logFsUnlock();
+	return any;
+}
+
+// Liest ab cursor.offset aus Segment cursor.seq (0 = Segmentende) und rueckt den Offset vor. Ein
+// komprimiertes Segment wird ab der im Cursor gemerkten Stelle weiter entpackt; liegt der Offset
+// davor (bzw. ist es ein anderes Segment), von vorn -- Bytes vor dem Offset werden verworfen.
+// Aufrufer haelt logMutex.
+static size_t segmentRead(const char *set, log_cursor_t &cursor, uint8_t *buf, size_t len)
+{
+	char path[32];
+	segmentPath(path, sizeof(path), set, cursor.seq, "lz");
+	if (!LittleFS.exists(path))
+	{
+		segmentPath(path, sizeof(path), set, cursor.seq);
+		File f = LittleFS.open(path, "r");
+		size_t n = 0;
+		if (f && f.seek(cursor.offset, SeekSet))
+		{
+			n = f.read(buf, len);
+		}
+		f.close();
+		cursor.offset += n;
+		return n;
+	}
+	File f = LittleFS.open(path, "r");
+	if (!f)
+	{
+		return 0;
+	}
+	log_lz_state_t &st = cursor.lz;
+	if (!cursor.lzValid || cursor.lzSeq != cursor.seq || st.outPos > cursor.offset)
+	{
+		uint8_t header[LOG_LZ_HEADER_BYTES];
+		cursor.lzValid = f.read(header, sizeof(header)) == sizeof(header) && logLzBegin(st, header, sizeof(header));
+		cursor.lzSeq = cursor.seq;
+	}
+	size_t n = 0;
+	if (cursor.lzValid && f.seek(st.inPos, SeekSet))
+	{
+		uint8_t in[128];
+		size_t inLen = 0;
+		while (n == 0 && st.outPos < st.rawSize)
+		{
+			size_t got = f.read(in + inLen, sizeof(in) - inLen);
+			inLen += got;
+			size_t skip = cursor.offset - st.outPos;
+			size_t used;
+			size_t out = logLzDecode(st, in, inLen, &used, buf, skip == 0 ? len : (skip < len ? skip : len));
+			memmove(in, in + used, inLen - used);
+			inLen -= used;
+			if (skip == 0)
+			{
+				n = out;
+			}
+			if (out == 0 && got == 0)
+			{
+				break; // Datei kuerzer als angegeben
+			}
+		}
+	}
+	f.close();
+	cursor.offset += n;
+	return n;
+}
+
+size_t logSetRead(const char *set, log_cursor_t &cursor, uint8_t *buf, size_t len)
+{
+	if (!logFsLock(2000))
+	{
+		return 0;
+	}
+	size_t n = 0;
+	uint32_t first, last;
+	if (segmentRange(set, &first, &last))
+	{
+		if (!cursor.started || cursor.seq < first)
+		{
+			cursor.seq = first; // Beginn bzw. Segment unter dem Cursor wegrotiert
+			cursor.offset = 0;
+			cursor.started = true;
+		}
+		while (n == 0 && cursor.seq <= last)
+		{
+			n = segmentRead(set, cursor, buf, len);
+			if (n > 0)
+			{
+				break;
+			}
+			if (cursor.seq < last)
+			{
+				cursor.seq++; // Segment zu Ende -> naechstes
+				cursor.offset = 0;
+			}
+			else
+			{
+				break; // Ende des juengsten Segments = Ende des Sets
+			}
+		}
+	}
+	logFsUnlock();
+	return n;
+}
+
+// Uhrzeit eines Records: Wanduhr ueber den letzten Zeit-Sync, sonst Uptime "+<ms>ms".
+static void recordTimestamp(const log_text_cursor_t &cursor, const log_record_t &rec, char *buf, size_t len)
+{
+	if (cursor.syncEpoch == 0)
+	{
+		snprintf(buf, len, "+%lums", (unsigned long)rec.uptime_ms);
 		return;
 	}
-	uint8_t buf[512];
-	size_t n;
-	while ((n = in.read(buf, sizeof(buf))) > 0)
+	time_t t = (time_t)cursor.syncEpoch + (int32_t)(rec.uptime_ms - cursor.syncUptime) / 1000;
+	struct tm tm;
+	localtime_r(&t, &tm);
+	strftime(buf, len, "%Y-%m-%d %H:%M:%S", &tm);
+}
+
+// Eine Textzeile (mit Zeilenende) fuer einen Record nach line; 0 = keine Ausgabe (Zeit-Sync, merkt
+// sich nur die Zuordnung Uptime -> Wanduhr im Cursor).
+static size_t renderRecord(log_text_cursor_t &cursor, const log_record_t &rec, char *line, size_t len)
+{
+	if (rec.msg_id == LOG_MSG_TIME_SYNC)
+	{
+		cursor.syncUptime = rec.uptime_ms;
+		cursor.syncEpoch = logRecordSyncEpoch(rec);
+		return 0;
+	}
+	size_t room = len - 1; // Platz fuer das Zeilenende
+	size_t n = 0;
+	if (rec.level != 0)
 	{
-		out.write(buf, n);
+		char ts[24];
+		recordTimestamp(cursor, rec, ts, sizeof(ts));
+		n = clampWritten(snprintf(line, room, "%s [%d] ", ts, rec.level), room);
 	}
-	in.close();
-	out.close();
+	n += recordMessage(rec, line + n, room - n + 1);
+	line[n++] = '\n';
+	return n;
+}
 
-	LittleFS.remove(FILE_LOG_PATH_CURRENT);
-	LittleFS.rename(FILE_LOG_PATH_TMP, FILE_LOG_PATH_CURRENT);
+static bool recordShown(const log_text_cursor_t &cursor, const log_record_t &rec)
+{
+	return rec.msg_id != LOG_MSG_TIME_SYNC && (cursor.maxLevel == 0 || rec.level <= cursor.maxLevel);
 }
 
-// Kopiert eine Datei chunkweise (ohne grosse RAM-Allokation). Genutzt fuer die Crash-Log-Sicherung.
-static void copyFile(const char *src, const char *dst)
+size_t logSetReadText(const char *set, log_text_cursor_t &cursor, char *buf, size_t len)
 {
-	File in = LittleFS.open(src, "r");
-	if (!in)
+	size_t out = 0;
+	char line[LOG_LINE_MAX_BYTES + 48];
+	for (;;)
+	{
+		log_record_t rec;
+		int r = logRecordParse(cursor.pending, cursor.pendingLen, rec);
+		if (r == 0 && cursor.pendingLen == sizeof(cursor.pending))
+		{
+			r = -1; // laenger als jeder Record: an dieser Stelle beginnt keiner
+		}
+		if (r < 0)
+		{
+			// Kein Record (z.B. Rest eines wegrotierten Segments): Byte verwerfen, weitersuchen.
+			memmove(cursor.pending, cursor.pending + 1, --cursor.pendingLen);
+			cursor.pendingOffset++;
+			continue;
+		}
+		if (r == 0)
+		{
+			if (cursor.end != 0 && cursor.pendingLen == 0 && cursor.raw.started &&
+				LOG_POS(cursor.raw.seq, cursor.raw.offset) >= cursor.end)
+			{
+				break; // Stand der Anfrage erreicht, spaeter Geschriebenes gar nicht erst lesen
+			}
+			size_t got = logSetRead(set, cursor.raw, cursor.pending + cursor.pendingLen, sizeof(cursor.pending) - cursor.pendingLen);
+			if (got == 0)
+			{
+				break; // Ende des Sets
+			}
+			if (cursor.pendingLen == 0)
+			{
+				cursor.pendingSeq = cursor.raw.seq;
+				cursor.pendingOffset = cursor.raw.offset - got;
+			}
+			cursor.pendingLen += got;
+			continue;
+		}
+		if (cursor.end != 0 && LOG_POS(cursor.pendingSeq, cursor.pendingOffset) >= cursor.end)
+		{
+			break;
+		}
+		size_t n = recordShown(cursor, rec) || rec.msg_id == LOG_MSG_TIME_SYNC ? renderRecord(cursor, rec, line, sizeof(line)) : 0;
+		if (n > len - out)
+		{
+			if (out > 0)
+			{
+				break; // passt erst in den naechsten Aufruf
+			}
+			n = len; // Puffer kleiner als eine Zeile: gekuerzt ausgeben
+		}
+		memcpy(buf + out, line, n);
+		out += n;
+		cursor.pendingLen -= r;
+		cursor.pendingOffset += r;
+		memmove(cursor.pending, cursor.pending + r, cursor.pendingLen);
+	}
+	return out;
+}
+
+// Parst die Records eines Segments von vorn bis limit (Byte-Offset) und ruft fn(offset, rec) je
+// Record. Liest blockweise ueber einen kleinen Stack-Puffer; der Cursor (Entpack-Fenster) liegt auf
+// dem Heap. Aufrufer haelt logMutex.
+template <typename Fn>
+static void scanSegment(const char *set, uint32_t seq, uint32_t limit, Fn fn)
+{
+	log_cursor_t *cursor = (log_cursor_t *)calloc(1, sizeof(log_cursor_t));
+	if (cursor == nullptr)
 	{
 		return;
 	}
-	File out = LittleFS.open(dst, "w");
-	if (!out)
+	cursor->seq = seq;
+	cursor->started = true;
+	uint8_t buf[2 * LOG_LINE_MAX_BYTES];
+	size_t len = 0;
+	uint32_t base = 0; // Offset von buf[0] im Segment
+	for (;;)
+	{
+		size_t got = segmentRead(set, *cursor, buf + len, sizeof(buf) - len);
+		len += got;
+		size_t pos = 0;
+		while (pos < len && base + pos < limit)
+		{
+			log_record_t rec;
+			int r = logRecordParse(buf + pos, len - pos, rec);
+			if (r == 0 && got > 0 && len - pos < sizeof(buf))
+			{
+				break; // Rest mit dem naechsten Block
+			}
+			if (r <= 0)
+			{
+				pos++;
+				continue;
+			}
+			fn(base + (uint32_t)pos, rec);
+			pos += r;
+		}
+		if (got == 0 || base + pos >= limit)
+		{
+			break;
+		}
+		memmove(buf, buf + pos, len - pos);
+		len -= pos;
+		base += pos;
+	}
+	free(cursor);
+}
+
+// Groesse eines Segments in Rohbytes (komprimiert: aus dem Kopf).
+static uint32_t segmentSize(const char *set, uint32_t seq)
+{
+	char path[32];
+	segmentPath(path, sizeof(path), set, seq, "lz");
+	if (!LittleFS.exists(path))
+	{
+		segmentPath(path, sizeof(path), set, seq);
+		return storedSize(path);
+	}
+	File f = LittleFS.open(path, "r");
+	uint8_t header[LOG_LZ_HEADER_BYTES];
+	uint32_t size = 0;
+	if (!f || f.read(header, sizeof(header)) != sizeof(header) || !logLzRawSize(header, sizeof(header), &size))
+	{
+		size = 0;
+	}
+	f.close();
+	return size;
+}
+
+log_pos_t logSetEnd(const char *set)
+{
+	log_pos_t end = 0;
+	uint32_t first, last;
+	if (logFsLock(2000))
+	{
+		if (segmentRange(set, &first, &last))
+		{
+			end = LOG_POS(last, segmentSize(set, last));
+		}
+		logFsUnlock();
+	}
+	return end;
+}
+
+// Cursor in-place neu aufsetzen: log_cursor_t enthaelt das ~1 KB Entpack-Fenster, eine Zuweisung
+// aus einem Temporary (log_cursor_t{...}) legte das jedes Mal auf den Stack des AsyncTCP-Tasks.
+static void cursorReset(log_cursor_t &cursor, uint32_t seq, uint32_t offset, bool started)
+{
+	cursor.seq = seq;
+	cursor.offset = offset;
+	cursor.started = started;
+	cursor.lzValid = false;
+	cursor.lzSeq = 0;
+}
+
+void logTextSeek(const char *set, log_text_cursor_t &cursor, log_pos_t pos)
+{
+	uint32_t seq = (uint32_t)(pos >> 16);
+	uint32_t offset = (uint32_t)(pos & 0xFFFF);
+	cursor.pendingLen = 0;
+	cursor.syncUptime = 0;
+	cursor.syncEpoch = 0;
+	if (!logFsLock(2000))
+	{
+		return;
+	}
+	uint32_t first, last;
+	if (segmentRange(set, &first, &last))
+	{
+		if (seq < first || seq > last || offset > segmentSize(set, seq))
+		{
+			seq = first; // wegrotiert bzw. Position aus einem frueheren Boot
+			offset = 0;
+		}
+		scanSegment(set, seq, offset, [&cursor](uint32_t, const log_record_t &rec)
+					{
+						if (rec.msg_id == LOG_MSG_TIME_SYNC)
+						{
+							cursor.syncUptime = rec.uptime_ms;
+							cursor.syncEpoch = logRecordSyncEpoch(rec);
+						}
+					});
+		cursorReset(cursor.raw, seq, offset, true);
+		cursor.pendingSeq = seq;
+		cursor.pendingOffset = offset;
+	}
+	logFsUnlock();
+}
+
+void logTextSeekTail(const char *set, log_text_cursor_t &cursor, uint32_t lines)
+{
+	if (lines == 0)
+	{
+		lines = 1;
+	}
+	if (lines > LOG_TAIL_MAX_LINES)
+	{
+		lines = LOG_TAIL_MAX_LINES;
+	}
+	// Vom juengsten Segment rueckwaerts: je Segment die Offsets der letzten lines passenden Records
+	// merken (Ringpuffer, auf dem Heap wie der Scan-Cursor), bis genug zusammen sind. logMutex nur je
+	// Segment halten: zwischen zwei Segmenten kommen Writer-Task und andere Leser dran. Rotiert
+	// waehrenddessen ein Segment weg, endet die Suche dort (logTextSeek faengt am aeltesten vorhandenen an).
+	uint32_t *offsets = (uint32_t *)malloc(lines * sizeof(uint32_t));
+	if (offsets == nullptr)
+	{
+		return;
+	}
+	log_pos_t start = 0;
+	uint32_t first, last;
+	if (!logFsLock(2000))
+	{
+		free(offsets);
+		return;
+	}
+	bool any = segmentRange(set, &first, &last);
+	logFsUnlock();
+	if (any)
+	{
+		uint32_t needed = lines;
+		start = LOG_POS(first, 0);
+		for (uint32_t seq = last + 1; seq-- > first;)
+		{
+			if (!logFsLock(2000))
+			{
+				break;
+			}
+			uint32_t nowFirst, nowLast;
+			if (!segmentRange(set, &nowFirst, &nowLast) || seq < nowFirst)
+			{
+				logFsUnlock();
+				break;
+			}
+			uint32_t count = 0;
+			scanSegment(set, seq, UINT32_MAX, [&](uint32_t off, const log_record_t &rec)
+						{
+							if (recordShown(cursor, rec))
+							{
+								offsets[count++ % lines] = off;
+							}
+						});
+			logFsUnlock();
+			if (count >= needed)
+			{
+				start = LOG_POS(seq, offsets[(count - needed) % lines]);
+				break;
+			}
+			needed -= count;
+		}
+	}
+	free(offsets);
+	logTextSeek(set, cursor, start);
+}
+
+uint32_t logSetSize(const char *set)
+{
+	uint32_t size = 0;
+	uint32_t first, last;
+	if (logFsLock(2000))
+	{
+		if (segmentRange(set, &first, &last))
+		{
+			for (uint32_t seq = first; seq <= last; ++seq)
+			{
+				size += segmentSize(set, seq);
+			}
+		}
+		logFsUnlock();
+	}
+	return size;
+}
+
+void logSetSeekByte(const char *set, log_cursor_t &cursor, uint32_t pos)
+{
+	cursorReset(cursor, 0, 0, false);
+	uint32_t first, last;
+	if (!logFsLock(2000))
+	{
+		return;
+	}
+	if (segmentRange(set, &first, &last))
+	{
+		uint32_t seq = first;
+		for (uint32_t size; seq < last && pos >= (size = segmentSize(set, seq)); ++seq)
+		{
+			pos -= size;
+		}
+		cursorReset(cursor, seq, pos, true);
+	}
+	logFsUnlock();
+}
+
+uint32_t logDroppedLines()
+{
+	return droppedLines;
+}
+
+uint32_t logFlashWrites()
+{
+	return flashWrites;
+}
+
+static uint32_t crumbHeaderCrc()
+{
+	return esp_rom_crc32_le(0, (const uint8_t *)&crumbHeader, offsetof(crumb_header_t, crc));
+}
+
+static void crumbsReset()
+{
+	crumbHeader.magic = LOG_CRUMB_MAGIC;
+	crumbHeader.head = 0;
+	crumbHeader.crc = crumbHeaderCrc();
+}
+
+// Haengt einen fertigen Record an den Breadcrumb-Ring an (nur memcpy ins RTC-RAM).
+static void crumbAppend(const uint8_t *rec, size_t n)
+{
+	portENTER_CRITICAL(&crumbMux);
+	size_t pos = crumbHeader.head % LOG_CRUMB_BYTES;
+	size_t first = n < LOG_CRUMB_BYTES - pos ? n : LOG_CRUMB_BYTES - pos;
+	memcpy(crumbRing + pos, rec, first);
+	memcpy(crumbRing, rec + first, n - first);
+	crumbHeader.head += n;
+	crumbHeader.crc = crumbHeaderCrc();
+	portEXIT_CRITICAL(&crumbMux);
+}
+
+// Schreibt eine Textzeile als Record (LOG_MSG_TEXT) nach f; Level 0 = Notiz ohne Zeit/Level.
+static size_t writeTextRecord(File &f, int16_t level, const char *text, size_t n)
+{
+	uint8_t rec[LOG_LINE_MAX_BYTES];
+	return f.write(rec, logRecordEncodeRaw(rec, sizeof(rec), level, millis(), LOG_MSG_TEXT, (const uint8_t *)text, n));
+}
+
+static size_t writeSyncRecord(File &f, uint32_t epoch)
+{
+	uint8_t rec[16];
+	return f.write(rec, logRecordEncodeSync(rec, sizeof(rec), millis(), epoch));
+}
+
+// Nach einem Crash-Boot: gueltigen Breadcrumb-Ring als juengstes Segment ins Crash-Set schreiben
+// (aeltestes Byte zuerst). Nach einem Umlauf ist der erste Record angeschnitten: uebersprungen wird
+// bis zur ersten Stelle, ab der sich die Records lueckenlos bis zum Schreibkopf parsen lassen.
+static void dumpCrumbsToCrashSet()
+{
+	if (crumbHeader.magic != LOG_CRUMB_MAGIC || crumbHeader.crc != crumbHeaderCrc() || crumbHeader.head == 0)
+	{
+		return; // Power-on-Muell bzw. leer
+	}
+	uint32_t head = crumbHeader.head;
+	uint32_t avail = head < LOG_CRUMB_BYTES ? head : LOG_CRUMB_BYTES;
+	uint8_t *linear = (uint8_t *)malloc(avail); // einmalig beim Boot
+	if (linear == nullptr)
+	{
+		return;
+	}
+	for (uint32_t i = 0; i < avail; ++i)
+	{
+		linear[i] = crumbRing[(head - avail + i) % LOG_CRUMB_BYTES];
+	}
+	size_t start = 0;
+	for (; start < avail && start < LOG_LINE_MAX_BYTES; ++start)
+	{
+		size_t pos = start;
+		log_record_t rec;
+		int r;
+		while (pos < avail && (r = logRecordParse(linear + pos, avail - pos, rec)) > 0)
+		{
+			pos += r;
+		}
+		if (pos == avail)
+		{
+			break;
+		}
+	}
+	uint32_t first = 0, last = 0;
+	bool any = segmentRange(FILE_LOG_SET_CRASH, &first, &last);
+	LittleFS.mkdir(FILE_LOG_SET_CRASH);
+	char path[32];
+	segmentPath(path, sizeof(path), FILE_LOG_SET_CRASH, any ? last + 1 : 0);
+	File f = LittleFS.open(path, "w");
+	if (f)
+	{
+		// Uptimes der Breadcrumbs stammen aus der abgestuerzten Session: Sync ohne Wanduhr -> "+<ms>ms".
+		writeSyncRecord(f, 0);
+		char line[96];
+		int n = snprintf(line, sizeof(line), "===== RTC-Breadcrumbs vor dem Reset (bis Level %d) =====", LOG_CRUMB_LEVEL);
+		writeTextRecord(f, 0, line, n);
+		if (start < avail && start < LOG_LINE_MAX_BYTES)
+		{
+			f.write(linear + start, avail - start);
+		}
+		f.close();
+	}
+	free(linear);
+}
+
+// Uebernimmt eine Logdatei aus dem frueheren Ein-Datei-Format als Segment 0 eines (leeren) Sets.
+static void migrateLegacyLog(const char *legacyPath, const char *set)
+{
+	if (!LittleFS.exists(legacyPath))
 	{
-		in.close();
 		return;
 	}
-	uint8_t buf[512];
-	size_t n;
-	while ((n = in.read(buf, sizeof(buf))) > 0)
+	uint32_t first, last;
+	if (segmentRange(set, &first, &last))
 	{
-		out.write(buf, n);
+		LittleFS.remove(legacyPath); // Set schon belegt -> Altdatei ist aelter, verwerfen
+		return;
+	}
+	char path[32];
+	LittleFS.mkdir(set);
+	segmentPath(path, sizeof(path), set, 0);
+	LittleFS.rename(legacyPath, path);
+}
+
+// Segmente aus der Zeit der Text-Logs (erstes Byte keine Record-Marke) einmalig zeilenweise in
+// Text-Records mit Level 0 umschreiben (Ausgabe unveraendert), damit /log/* sie weiter anzeigt.
+static void convertLegacyTextSet(const char *set)
+{
+	uint32_t first, last;
+	if (!segmentRange(set, &first, &last))
+	{
+		return;
+	}
+	char path[32], tmpPath[32];
+	for (uint32_t seq = first; seq <= last; ++seq)
+	{
+		segmentPath(path, sizeof(path), set, seq);
+		File in = LittleFS.open(path, "r");
+		if (!in)
+		{
+			continue;
+		}
+		int b = in.peek();
+		if (b < 0 || (b & 0xF0) == LOG_RECORD_MARK)
+		{
+			in.close();
+			continue;
+		}
+		snprintf(tmpPath, sizeof(tmpPath), "%s/%lu.tmp", set, (unsigned long)seq);
+		File out = LittleFS.open(tmpPath, "w");
+		while (out && in.available())
+		{
+			String line = in.readStringUntil('\n');
+			if (line.endsWith("\r"))
+			{
+				line.remove(line.length() - 1);
+			}
+			writeTextRecord(out, 0, line.c_str(), line.length());
+		}
+		in.close();
+		if (out)
+		{
+			out.close();
+			LittleFS.remove(path);
+			LittleFS.rename(tmpPath, path);
+		}
 	}
-	in.close();
-	out.close();
 }
 
 void initFileLog(const char *firmwareVersion)
@@ -139,65 +1120,162 @@ void initFileLog(const char *firmwareVersion)
 		return;
 	}
 
+	LittleFS.mkdir(FILE_LOG_DIR);
+	// Einmalig: Dateien aus dem alten Ein-Datei-Format (/log.txt, /log_prev.txt, /log_crash.txt)
+	// als Segment 0 in die Sets umhaengen, Rest einer abgebrochenen Trim-Operation verwerfen.
+	migrateLegacyLog("/log_crash.txt", FILE_LOG_SET_CRASH);
+	migrateLegacyLog("/log_prev.txt", FILE_LOG_SET_PREVIOUS);
+	migrateLegacyLog("/log.txt", FILE_LOG_SET_CURRENT);
+	LittleFS.remove("/log.tmp");
+	convertLegacyTextSet(FILE_LOG_SET_CRASH);
+	convertLegacyTextSet(FILE_LOG_SET_PREVIOUS);
+	convertLegacyTextSet(FILE_LOG_SET_CURRENT);
+
 	// Crash-Log sichern, BEVOR rotiert wird: war der letzte Reset ein Absturz (Panic/Watchdog/
-	// Brownout), die Breadcrumbs der abgestuerzten Session (= aktuelles /log.txt) in die nicht
-	// rotierte /log_crash.txt kopieren. Sonst schiebt schon der naechste (Auto-)Reboot oder ein
-	// Power-Cycle den Crash-Kontext aus current/previous heraus (Befund 2026-06-21). /log/crash
-	// haelt damit IMMER die letzte abgestuerzte Session, ueberlebt beliebig viele Reboots.
+	// Brownout), das Set der abgestuerzten Session in das nicht rotierte Crash-Set umbenennen. Sonst
+	// schiebt schon der naechste (Auto-)Reboot oder ein Power-Cycle den Crash-Kontext aus current/
+	// previous heraus (Befund 2026-06-21). /log/crash haelt damit IMMER die letzte abgestuerzte
+	// Session, ueberlebt beliebig viele Reboots. /log/previous zeigt fuer diesen Boot dasselbe Set.
 	esp_reset_reason_t rr = esp_reset_reason();
 	bool wasCrash = (rr == ESP_RST_PANIC || rr == ESP_RST_TASK_WDT || rr == ESP_RST_INT_WDT ||
 					 rr == ESP_RST_WDT || rr == ESP_RST_BROWNOUT);
-	if (wasCrash && LittleFS.exists(FILE_LOG_PATH_CURRENT))
+	uint32_t first, last;
+	if (segmentRange(FILE_LOG_SET_CURRENT, &first, &last))
 	{
-		copyFile(FILE_LOG_PATH_CURRENT, FILE_LOG_PATH_CRASH);
-	}
-
-	// Rotation: Log des vorherigen Boots als "pre-restart" sichern, dann frisch beginnen.
-	if (LittleFS.exists(FILE_LOG_PATH_CURRENT))
-	{
-		if (LittleFS.exists(FILE_LOG_PATH_PREVIOUS))
+		// Rotation: Set des vorherigen Boots als "pre-restart" (bzw. Crash) sichern, dann frisch beginnen.
+		removeSet(FILE_LOG_SET_PREVIOUS);
+		if (wasCrash)
 		{
-			LittleFS.remove(FILE_LOG_PATH_PREVIOUS);
+			removeSet(FILE_LOG_SET_CRASH);
+			LittleFS.rename(FILE_LOG_SET_CURRENT, FILE_LOG_SET_CRASH);
+			previousIsCrash = true;
+		}
+		else
+		{
+			LittleFS.rename(FILE_LOG_SET_CURRENT, FILE_LOG_SET_PREVIOUS);
 		}
-		LittleFS.rename(FILE_LOG_PATH_CURRENT, FILE_LOG_PATH_PREVIOUS);
 	}
-	// evtl. Reste einer abgebrochenen Trim-Operation
-	if (LittleFS.exists(FILE_LOG_PATH_TMP))
+	if (wasCrash)
 	{
-		LittleFS.remove(FILE_LOG_PATH_TMP);
+		dumpCrumbsToCrashSet();
 	}
+	// Archivierte Sets: zuletzt offenes Segment bzw. Breadcrumbs komprimieren (der Rest ist schon .lz).
+	compressSet(FILE_LOG_SET_PREVIOUS);
+	compressSet(FILE_LOG_SET_CRASH);
+	crumbsReset();
+	crumbsReady = true;
+	removeSet(FILE_LOG_SET_CURRENT); // Reste, falls ein Rename scheiterte
+	LittleFS.mkdir(FILE_LOG_SET_CURRENT);
 
-	File f = LittleFS.open(FILE_LOG_PATH_CURRENT, "w");
+	char path[32];
+	segmentPath(path, sizeof(path), FILE_LOG_SET_CURRENT, 0);
+	File f = LittleFS.open(path, "w");
 	if (f)
 	{
-		f.println("===== BOOT " + logTimestamp() + " =====");
-		f.println("Firmware " + String(firmwareVersion) + " (compiled " + __DATE__ + " " + __TIME__ + ")");
-		f.println("Reset reason: " + String(resetReasonStr()));
+		uint32_t epoch = logEpochNow();
+		writeSyncRecord(f, epoch);
+		curSyncHasEpoch = epoch != 0;
+		char ts[24];
+		char line[128];
+		logTimestamp(ts, sizeof(ts));
+		writeTextRecord(f, 0, line, snprintf(line, sizeof(line), "===== BOOT %s =====", ts));
+		writeTextRecord(f, 0, line, snprintf(line, sizeof(line), "Firmware %s (compiled %s %s)", firmwareVersion, __DATE__, __TIME__));
+		writeTextRecord(f, 0, line, snprintf(line, sizeof(line), "Reset reason: %s", resetReasonStr()));
+		curSegBytes = f.size();
 		f.close();
 	}
 	fileLogReady = true;
+	if (logWriterHandle == nullptr)
+	{
+		// Niedrige Prioritaet auf Core 1 (neben dem Loop): Flash-I/O nie auf dem Bus-Worker (Core 0).
+		xTaskCreatePinnedToCore(logWriterTask, "logWriter", 4096, nullptr, 1, &logWriterHandle, 1);
+	}
 }
 
-void log(int16_t level, const String &message_s)
+// Gibt einen fertig kodierten Record an Breadcrumbs und Log-Ring (Datei-Log + Syslog) weiter (nur
+// memcpy, blockiert nie auf Flash- oder Netz-I/O). Serial formatiert der Aufrufer selbst.
+static void logEmit(int16_t level, const uint8_t *rec, size_t n)
 {
-	if (level <= MAX_LOG_LEVEL)
+	if (n == 0)
 	{
-		Serial.println("[" + String(level) + "]: " + message_s);
+		return;
 	}
 
-	if (fileLogReady && level <= fileLogLevel && logFsLock(100))
+	if (crumbsReady && level <= LOG_CRUMB_LEVEL)
 	{
-		File f = LittleFS.open(FILE_LOG_PATH_CURRENT, "a");
-		if (f)
+		crumbAppend(rec, n);
+	}
+
+	if (fileLogReady && (level <= fileLogLevel || level <= syslogLevel))
+	{
+		bool wake = false;
+		portENTER_CRITICAL(&logRingMux);
+		if (LOG_RING_BYTES - (ringHead - ringTail) >= n)
 		{
-			f.println(logTimestamp() + " [" + String(level) + "] " + message_s);
-			size_t sz = f.size();
-			f.close();
-			if (sz > FILE_LOG_MAX_BYTES)
-			{
-				trimCurrentLog();
-			}
+			size_t pos = ringHead % LOG_RING_BYTES;
+			size_t first = n < LOG_RING_BYTES - pos ? n : LOG_RING_BYTES - pos;
+			memcpy(logRing + pos, rec, first);
+			memcpy(logRing, rec + first, n - first);
+			ringHead += n;
+			wake = ringHead - ringTail >= LOG_FLUSH_THRESHOLD_BYTES;
 		}
-		logFsUnlock();
+		else
+		{
+			droppedLines++;
+		}
+		portEXIT_CRITICAL(&logRingMux);
+		if (wake && logWriterHandle != nullptr)
+		{
+			xTaskNotifyGive(logWriterHandle);
+		}
+	}
+}
+
+void log(int16_t level, const String &message_s)
+{
+	if (!logEnabled(level))
+	{
+		return;
+	}
+	if (level <= MAX_LOG_LEVEL)
+	{
+		Serial.printf("[%d]: %s\n", level, message_s.c_str());
+	}
+	uint8_t rec[LOG_LINE_MAX_BYTES];
+	logEmit(level, rec, logRecordEncodeRaw(rec, sizeof(rec), level, millis(), LOG_MSG_TEXT, (const uint8_t *)message_s.c_str(), message_s.length()));
+}
+
+#ifdef LOG_EAGER_STRING
+String logStringf(const char *format, ...)
+{
+	char line[LOG_LINE_MAX_BYTES];
+	va_list args;
+	va_start(args, format);
+	vsnprintf(line, sizeof(line), format, args);
+	va_end(args);
+	return String(line);
+}
+#endif // LOG_EAGER_STRING
+
+void logPrintf(int16_t level, uint32_t msg_id, const char *format, ...)
+{
+	if (!logEnabled(level))
+	{
+		return;
+	}
+	registerFormat(msg_id, format);
+	uint8_t rec[LOG_LINE_MAX_BYTES];
+	va_list args, serialArgs;
+	va_start(args, format);
+	va_copy(serialArgs, args);
+	logEmit(level, rec, logRecordEncode(rec, sizeof(rec), level, millis(), msg_id, format, args));
+	if (level <= MAX_LOG_LEVEL)
+	{
+		// Text nur noch fuer Serial; der Record ist schon kopiert -> Puffer wiederverwenden.
+		char *line = (char *)rec;
+		vsnprintf(line, sizeof(rec), format, serialArgs);
+		Serial.printf("[%d]: %s\n", level, line);
 	}
+	va_end(serialArgs);
+	va_end(args);
 }
@@ -9,26 +9,105 @@
 #define MAX_LOG_LEVEL 2 // Change this to set the maximum log level (Serial-Ausgabe)
 
 #include "Arduino.h"
+#include <type_traits>
+#include "log_record.h"
+#include "log_lz.h"
 
-// Persistentes Logging ins LittleFS (zusaetzlich zum Serial). Zwei Dateien: das aktuelle Log
-// des laufenden Boots und das des vorherigen Boots ("pre-restart"), das beim Boot durch
-// Umbenennen erhalten wird. Beide ueber die Weboberflaeche anzeigbar.
-#define FILE_LOG_PATH_CURRENT  "/log.txt"
-#define FILE_LOG_PATH_PREVIOUS "/log_prev.txt"
-#define FILE_LOG_PATH_TMP      "/log.tmp"
-// Crash-Log: NICHT rotiert. Beim Boot nach einem Absturz (Panic/Watchdog/Brownout) wird die
-// abgestuerzte Session hierher kopiert, damit der Crash-Kontext NICHT vom naechsten Reboot oder
-// Power-Cycle aus current/previous geschoben wird (Befund 2026-06-21: doppelter Boot loeschte ihn).
-#define FILE_LOG_PATH_CRASH    "/log_crash.txt"
-#define FILE_LOG_MAX_BYTES     32768  // Kappung je Datei; bei Ueberlauf werden die aeltesten Zeilen verworfen
+// Persistentes Logging ins LittleFS (zusaetzlich zum Serial). Drei Log-"Sets": das des laufenden
+// Boots, das des vorherigen Boots ("pre-restart") und das der letzten abgestuerzten Session.
+// Jedes Set ist ein Verzeichnis aus Segmentdateien (seq aufsteigend) aus binaeren Log-Records
+// (log_record.h); jedes Segment beginnt mit einem Zeit-Sync. Rotation = aeltestes Segment loeschen
+// (O(1)); frueher kopierte trimCurrentLog bei jedem Ueberlauf die halbe Datei (16 KB) unter dem
+// Log-Mutex um. Boot-Rotation und Crash-Sicherung sind Verzeichnis-Renames statt Dateikopien.
+// Lesen: logSetRead() streamt ein Set in Reihenfolge.
+// Nur das juengste Segment von current ist ein offenes "<seq>.log"; abgeschlossene Segmente (beim
+// Segmentwechsel bzw. beim Boot die von previous/crash) werden zu "<seq>.lz" komprimiert (log_lz.h)
+// und beim Lesen on the fly entpackt -- Offsets, Groessen und ?raw=1 beziehen sich immer auf die
+// Rohbytes. Das Budget zaehlt belegte Bytes -> bei Faktor ~3 etwa 2-3x so viel Historie je Set.
+#define FILE_LOG_DIR          "/log"
+#define FILE_LOG_SET_CURRENT  "/log/cur"
+#define FILE_LOG_SET_PREVIOUS "/log/prev"
+// Crash-Log: NICHT rotiert. Beim Boot nach einem Absturz (Panic/Watchdog/Brownout) wird das Set
+// der abgestuerzten Session hierher umbenannt, damit der Crash-Kontext NICHT vom naechsten Reboot
+// oder Power-Cycle aus current/previous geschoben wird (Befund 2026-06-21: doppelter Boot loeschte ihn).
+#define FILE_LOG_SET_CRASH    "/log/crash"
+#define FILE_LOG_MAX_BYTES     32768  // Flash-Budget je Set; bei Ueberlauf faellt das aelteste Segment weg
+#define LOG_SEGMENT_BYTES      8192   // gewechselt wird nach dem Flush, der die Grenze reisst
+#define LOG_SEGMENT_MAX_COUNT  32     // Obergrenze fuer die Verzeichnis-Scans, auch bei sehr guter Kompression
+
+// Asynchroner Datei-Log-Writer: log() legt die fertige Zeile nur in einen RAM-Ring (kurzer
+// Spinlock, keine Flash-I/O); ein Writer-Task niedriger Prioritaet schreibt gesammelt ins LittleFS,
+// alle LOG_FLUSH_INTERVAL_MS oder sobald LOG_FLUSH_THRESHOLD_BYTES anstehen. Bisher oeffnete
+// jede Zeile die Datei, schrieb, fragte size() ab und schloss sie wieder — unter dem Log-Mutex,
+// auf dem dann Modbus-Worker, AsyncTCP und Loop standen (beim Trim 16 KB Kopie lang).
+// Ist der Ring voll, wird die Zeile verworfen und gezaehlt (Hinweiszeile im Log + /status).
+#define LOG_RING_BYTES            8192
+#define LOG_FLUSH_INTERVAL_MS     2000
+#define LOG_FLUSH_THRESHOLD_BYTES 2048
+#define LOG_LINE_MAX_BYTES        256   // laengster Record bzw. Serial-Zeile; laengere werden gekuerzt
+
+// Crash-Breadcrumbs: zusaetzlich landet jede Zeile bis LOG_CRUMB_LEVEL (auch wenn der Datei-Log-
+// Level sie verwirft) in einem Ring im RTC-RAM (RTC_NOINIT_ATTR: ueberlebt Panic/Watchdog-Resets,
+// kein Flash-Schreibzugriff im Betrieb). Nach einem Crash-Boot kommt der Ring als eigenes Segment
+// ins Crash-Set -> volle INFO-Historie vor dem Absturz, auch bei Datei-Log-Level WARNING.
+// Kopf (Magic + Schreibposition) per CRC32 abgesichert; Power-on-Muell wird so verworfen.
+#define LOG_CRUMB_BYTES 4096
+#define LOG_CRUMB_LEVEL LOG_LEVEL_INFO
 
 // Datei-Log-Level, UNABHAENGIG von MAX_LOG_LEVEL (Serial). Zur Laufzeit ueber /logs umschaltbar,
 // damit man fuer eine Diagnose-Session kurz INFO/DEBUG aktivieren kann, ohne den Flash dauerhaft
 // zu belasten. Default = WARNING.
 extern volatile int16_t fileLogLevel;
+// Level-Schwelle der UDP-Syslog-Senke (log_syslog.h), ebenfalls ueber /logs; 0 = aus.
+extern volatile int16_t syslogLevel;
 
 void log(int16_t level, const String &message_s);
 
+// --- Lazy Logging ----------------------------------------------------------------------
+// log(level, "..." + String(x) + ...) baut die Strings auf dem Heap, BEVOR log() den Level prueft —
+// im Poll-/Publish-Pfad Dutzende temporaere Strings je Zyklus, die fast immer verworfen werden.
+// LOGF prueft zuerst den Level und wertet die Argumente nur dann aus; formatiert wird printf-artig
+// in einen Stack-Puffer (LOG_LINE_MAX_BYTES). Aufrufe weniger wichtig als LOG_COMPILE_LEVEL
+// (Build-Flag, z.B. -DLOG_COMPILE_LEVEL=LOG_LEVEL_WARNING) entfallen zur Compilezeit komplett.
+// Default DEBUG: alles bleibt drin, damit der Datei-Log-Level ueber /logs voll umschaltbar ist.
+// Ins Datei-Log und die Breadcrumbs geht ein binaerer Record (Formatstring-ID + rohe Argumente,
+// log_record.h); Text formatiert nur noch die Serial-Ausgabe. Die ID wird hier zur Compilezeit
+// gebildet; den Formatstring merkt sich logPrintf beim ersten Aufruf in einer Registry mit
+// LOG_FMT_REGISTRY_SIZE Plaetzen (fuer die Textausgabe von /log/*). Ist sie voll bzw. lief eine
+// Meldung in diesem Boot noch nicht, zeigt /log/* die Rohwerte; tools/logdecode.py kennt alle.
+#ifndef LOG_COMPILE_LEVEL
+#define LOG_COMPILE_LEVEL LOG_LEVEL_DEBUG
+#endif
+
+// true, wenn eine Meldung dieses Levels irgendwo ausgegeben wird (Serial, Datei-Log, Breadcrumbs, Syslog).
+inline bool logEnabled(int16_t level)
+{
+	return level <= MAX_LOG_LEVEL || level <= fileLogLevel || level <= LOG_CRUMB_LEVEL || level <= syslogLevel;
+}
+
+#define LOG_FMT_REGISTRY_SIZE 128 // Zweierpotenz
+
+void logPrintf(int16_t level, uint32_t msg_id, const char *format, ...) __attribute__((format(printf, 3, 4)));
+
+#ifdef LOG_EAGER_STRING
+// Nur fuer die Allokationsmessung (ESP32_alloc_bench_legacy, alloc_bench.h): LOGF verhaelt sich wie
+// die frueheren log(level, "..." + String(x)) -Aufrufe und baut den Text als String, BEVOR log() den
+// Level prueft. Ein String je Meldung ist die Untergrenze der alten Kosten (die Verkettungen
+// allokierten je Teilstueck erneut).
+String logStringf(const char *format, ...) __attribute__((format(printf, 1, 2)));
+#define LOGF(level, format, ...) log((level), logStringf(format, ##__VA_ARGS__))
+#else
+#define LOGF(level, format, ...)                                                      \
+	do                                                                                \
+	{                                                                                 \
+		if ((level) <= LOG_COMPILE_LEVEL && logEnabled(level))                        \
+		{                                                                             \
+			logPrintf((level), std::integral_constant<uint32_t, logFmtId(format)>::value,\
+					  format, ##__VA_ARGS__);                                         \
+		}                                                                             \
+	} while (0)
+#endif // LOG_EAGER_STRING
+
 // FS mounten, rotieren (current -> previous) und neues current mit Boot-Banner anlegen.
 // Frueh in setup() aufrufen, vor den ersten zu persistierenden Logs. firmwareVersion fliesst
 // ins Banner (FIRMWARE_VERSION ist in main.cpp eine lokale const, kein Makro).
@@ -39,4 +118,76 @@ void initFileLog(const char *firmwareVersion);
 bool logFsLock(uint32_t timeout_ms);
 void logFsUnlock();
 
+// Schreibt den Ring sofort (synchron, im aufrufenden Task) ins Datei-Log. Vor ESP.restart(), damit
+// die letzten Zeilen nicht fehlen. Kann rotieren und komprimieren (~8 KB lesen, ~3 KB schreiben) ->
+// nicht aus dem AsyncTCP-Task.
+void flushFileLog();
+// Weckt nur den Writer-Task (kehrt sofort zurueck); er schreibt den Ring im eigenen Task. Fuer den
+// Webserver vor /log/current: ausgeliefert wird, was schon im Flash steht, der Rest kommt mit dem
+// naechsten ?since.
+void requestFileLogFlush();
+// Set, das /log/previous zeigt: nach einem Crash-Boot ist die vorige Session das Crash-Set selbst
+// (sie wurde dorthin umbenannt statt kopiert), sonst FILE_LOG_SET_PREVIOUS.
+const char *logPreviousSet();
+
+// Lese-Cursor ueber die Segmente eines Sets (Anfangszustand: {}). logSetRead liefert die naechsten
+// Bytes (0 = Ende des Sets). Nimmt logFsLock selbst; wurde das Segment unter dem Cursor inzwischen
+// wegrotiert, geht es beim aeltesten noch vorhandenen weiter. logSetExists: Set hat Segmente.
+// In einem komprimierten Segment haelt der Cursor den Entpack-Zustand (~1 KB Fenster) -> nicht auf
+// kleinen Stacks anlegen; ein Sprung zurueck entpackt das Segment ab Anfang.
+typedef struct
+{
+	uint32_t seq;
+	uint32_t offset; // in Rohbytes, auch in komprimierten Segmenten
+	bool started;
+	bool lzValid; // lz gehoert zu Segment lzSeq
+	uint32_t lzSeq;
+	log_lz_state_t lz;
+} log_cursor_t;
+size_t logSetRead(const char *set, log_cursor_t &cursor, uint8_t *buf, size_t len);
+bool logSetExists(const char *set);
+
+// Rohbytes fuer HTTP-Range (?raw=1): Gesamtgroesse eines Sets bzw. Cursor auf ein Byte, gezaehlt
+// ueber die aneinandergehaengten Segmente.
+uint32_t logSetSize(const char *set);
+void logSetSeekByte(const char *set, log_cursor_t &cursor, uint32_t pos);
+
+// Position im Set fuer ?since bzw. den Antwort-Header X-Log-Next: Segmentnummer << 16 | Offset im
+// Segment (ein Segment waechst hoechstens um einen Ring ueber LOG_SEGMENT_BYTES hinaus). Bleibt ueber
+// die Rotation hinweg gueltig; fuer Clients ein undurchsichtiger Wert.
+typedef uint64_t log_pos_t;
+#define LOG_POS(seq, offset) (((log_pos_t)(seq) << 16) | (offset))
+static_assert(LOG_SEGMENT_BYTES + LOG_RING_BYTES + 2 * LOG_LINE_MAX_BYTES < 65536, "Segment-Offset passt nicht in LOG_POS");
+// Hoechstens so viele Zeilen fuer ?tail (je Zeile 4 Byte Offset beim Suchen, auf dem Heap).
+#define LOG_TAIL_MAX_LINES 200
+
+// Dasselbe als Text: dekodiert die Records zeilenweise ("<Zeit> [<Level>] <Meldung>"), nur ganze
+// Zeilen je Aufruf. Haelt den angelesenen Rest und den letzten Zeit-Sync im Cursor. Filter: nur
+// Records bis maxLevel (0 = alle; Notizen mit Level 0 immer) und nur bis zur Position end (0 = bis
+// zum Ende, sonst z.B. logSetEnd() zum Anfragezeitpunkt -> passt zu X-Log-Next).
+typedef struct
+{
+	log_cursor_t raw;
+	uint8_t pending[4 * LOG_LINE_MAX_BYTES]; // angelesene Rohbytes (auch: Leseblock je Flash-Zugriff)
+	uint16_t pendingLen;
+	uint32_t pendingSeq; // Position von pending[0]
+	uint32_t pendingOffset;
+	uint32_t syncUptime;
+	uint32_t syncEpoch; // 0 = keine Wanduhr bekannt -> "+<ms>ms"
+	int16_t maxLevel;
+	log_pos_t end;
+} log_text_cursor_t;
+size_t logSetReadText(const char *set, log_text_cursor_t &cursor, char *buf, size_t len);
+// Position hinter dem letzten geschriebenen Byte.
+log_pos_t logSetEnd(const char *set);
+// Cursor auf eine Position setzen (?since). Liegt sie nicht mehr im Set (wegrotiert) bzw. dahinter
+// (neuer Boot), geht es am Anfang des Sets los. Der Zeit-Sync davor wird mitgelesen.
+void logTextSeek(const char *set, log_text_cursor_t &cursor, log_pos_t pos);
+// Cursor auf die letzten lines Zeilen setzen, die den Level-Filter des Cursors passieren (?tail).
+void logTextSeekTail(const char *set, log_text_cursor_t &cursor, uint32_t lines);
+
+// Fuer das /status-JSON: verworfene Zeilen (Ring voll) bzw. Schreibvorgaenge ins Flash seit Boot.
+uint32_t logDroppedLines();
+uint32_t logFlashWrites();
+
 #endif // SRC_LOG_H_
@@ -0,0 +1,223 @@
+#include "log_lz.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#define LOG_LZ_HASH_BITS 9
+#define LOG_LZ_NO_POS    0xFFFFFFFFu
+
+static const uint8_t lzMagic[4] = {'L', 'L', 'Z', '1'};
+
+bool logLzRawSize(const uint8_t *header, size_t len, uint32_t *rawSize)
+{
+	if (len < LOG_LZ_HEADER_BYTES || memcmp(header, lzMagic, sizeof(lzMagic)) != 0)
+	{
+		return false;
+	}
+	*rawSize = header[4] | (header[5] << 8) | (header[6] << 16) | ((uint32_t)header[7] << 24);
+	return true;
+}
+
+bool logLzBegin(log_lz_state_t &st, const uint8_t *header, size_t len)
+{
+	if (!logLzRawSize(header, len, &st.rawSize))
+	{
+		return false;
+	}
+	st.inPos = LOG_LZ_HEADER_BYTES;
+	st.outPos = 0;
+	st.matchDist = 0;
+	st.matchLeft = 0;
+	st.flags = 0;
+	st.flagBits = 0;
+	return true;
+}
+
+static void putOut(log_lz_state_t &st, uint8_t b, uint8_t *out, size_t &o)
+{
+	st.window[st.outPos % LOG_LZ_WINDOW] = b;
+	st.outPos++;
+	out[o++] = b;
+}
+
+size_t logLzDecode(log_lz_state_t &st, const uint8_t *in, size_t inLen, size_t *inUsed, uint8_t *out, size_t outLen)
+{
+	size_t i = 0;
+	size_t o = 0;
+	while (o < outLen && st.outPos < st.rawSize)
+	{
+		if (st.matchLeft > 0)
+		{
+			putOut(st, st.window[(st.outPos - st.matchDist) % LOG_LZ_WINDOW], out, o);
+			st.matchLeft--;
+			continue;
+		}
+		if (st.flagBits == 0)
+		{
+			if (i >= inLen)
+			{
+				break;
+			}
+			st.flags = in[i++];
+			st.flagBits = 8;
+		}
+		if (st.flags & 1)
+		{
+			if (inLen - i < 2)
+			{
+				break;
+			}
+			uint16_t v = in[i] | (in[i + 1] << 8);
+			i += 2;
+			st.matchDist = (v & 0x3FF) + 1;
+			st.matchLeft = (v >> 10) + LOG_LZ_MIN_MATCH;
+			if (st.matchDist > st.outPos)
+			{
+				st.outPos = st.rawSize; // kaputt: Verweis vor den Anfang -> Segment hier beenden
+				st.matchLeft = 0;
+				break;
+			}
+		}
+		else
+		{
+			if (i >= inLen)
+			{
+				break;
+			}
+			putOut(st, in[i++], out, o);
+		}
+		st.flags >>= 1;
+		st.flagBits--;
+	}
+	*inUsed = i;
+	st.inPos += i;
+	return o;
+}
+
+typedef struct
+{
+	uint8_t buf[2 * LOG_LZ_WINDOW + LOG_LZ_MAX_MATCH]; // Fenster + Vorschau
+	uint32_t head[1 << LOG_LZ_HASH_BITS];                // juengste absolute Position je Hash
+	uint8_t group[1 + 8 * 2];
+	size_t groupLen;
+	uint8_t groupItems;
+} lz_encoder_t;
+
+static uint32_t hash3(const uint8_t *p)
+{
+	return ((p[0] << 16 | p[1] << 8 | p[2]) * 2654435761u) >> (32 - LOG_LZ_HASH_BITS);
+}
+
+static bool flushGroup(lz_encoder_t &e, log_lz_write_t write, void *ctx, size_t &total)
+{
+	if (e.groupItems == 0)
+	{
+		return true;
+	}
+	bool ok = write(ctx, e.group, e.groupLen) == e.groupLen;
+	total += e.groupLen;
+	e.group[0] = 0;
+	e.groupLen = 1;
+	e.groupItems = 0;
+	return ok;
+}
+
+size_t logLzCompress(uint32_t rawSize, log_lz_read_t read, log_lz_write_t write, void *ctx)
+{
+	lz_encoder_t *e = (lz_encoder_t *)malloc(sizeof(lz_encoder_t));
+	if (e == nullptr)
+	{
+		return 0;
+	}
+	uint8_t header[LOG_LZ_HEADER_BYTES];
+	memcpy(header, lzMagic, sizeof(lzMagic));
+	for (int i = 0; i < 4; ++i)
+	{
+		header[4 + i] = (uint8_t)(rawSize >> (8 * i));
+	}
+	bool ok = write(ctx, header, sizeof(header)) == sizeof(header);
+	size_t total = sizeof(header);
+	memset(e->head, 0xFF, sizeof(e->head));
+	e->group[0] = 0;
+	e->groupLen = 1;
+	e->groupItems = 0;
+	uint32_t base = 0; // absolute Position von buf[0]
+	size_t len = 0;
+	size_t pos = 0;
+	bool eof = false;
+	while (ok)
+	{
+		if (!eof && len - pos < LOG_LZ_MAX_MATCH)
+		{
+			if (pos > LOG_LZ_WINDOW)
+			{
+				size_t drop = pos - LOG_LZ_WINDOW; // nur das Fenster hinter pos behalten
+				memmove(e->buf, e->buf + drop, len - drop);
+				len -= drop;
+				pos -= drop;
+				base += drop;
+			}
+			size_t want = sizeof(e->buf) - len;
+			if (base + len + want > rawSize)
+			{
+				want = rawSize - base - len;
+			}
+			size_t got = want > 0 ? read(ctx, e->buf + len, want) : 0;
+			eof = got == 0;
+			len += got;
+		}
+		if (pos >= len)
+		{
+			break;
+		}
+		size_t bestLen = 0;
+		uint32_t bestDist = 0;
+		if (len - pos >= LOG_LZ_MIN_MATCH)
+		{
+			uint32_t h = hash3(e->buf + pos);
+			uint32_t cand = e->head[h];
+			e->head[h] = base + pos;
+			if (cand != LOG_LZ_NO_POS && cand >= base && base + pos - cand <= LOG_LZ_WINDOW)
+			{
+				size_t c = cand - base;
+				size_t max = len - pos < LOG_LZ_MAX_MATCH ? len - pos : LOG_LZ_MAX_MATCH;
+				size_t l = 0;
+				while (l < max && e->buf[c + l] == e->buf[pos + l])
+				{
+					l++;
+				}
+				if (l >= LOG_LZ_MIN_MATCH)
+				{
+					bestLen = l;
+					bestDist = base + pos - cand;
+				}
+			}
+		}
+		if (bestLen > 0)
+		{
+			uint16_t v = (uint16_t)((bestDist - 1) | ((bestLen - LOG_LZ_MIN_MATCH) << 10));
+			e->group[0] |= 1 << e->groupItems;
+			e->group[e->groupLen++] = (uint8_t)v;
+			e->group[e->groupLen++] = (uint8_t)(v >> 8);
+			for (size_t k = 1; k < bestLen; ++k)
+			{
+				if (pos + k + LOG_LZ_MIN_MATCH <= len)
+				{
+					e->head[hash3(e->buf + pos + k)] = base + pos + k;
+				}
+			}
+			pos += bestLen;
+		}
+		else
+		{
+			e->group[e->groupLen++] = e->buf[pos++];
+		}
+		if (++e->groupItems == 8)
+		{
+			ok = flushGroup(*e, write, ctx, total);
+		}
+	}
+	ok = ok && flushGroup(*e, write, ctx, total) && base + len == rawSize;
+	free(e);
+	return ok ? total : 0;
+}
@@ -0,0 +1,52 @@
+#ifndef SRC_LOG_LZ_H_
+#define SRC_LOG_LZ_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+// =========================================================================================
+// Kleiner LZSS-Kompressor fuer abgeschlossene Log-Segmente (log.h). Heatshrink o.ae. gibt es in
+// diesem Build nicht, und der miniz-Kompressor aus dem ROM braucht >100 KB Arbeitsspeicher; dieses
+// Format kommt beim Dekodieren mit dem 1-KB-Fenster im Lese-Cursor aus, beim Komprimieren mit
+// ~4 KB (einmal je Segmentwechsel, Writer-Task). Die Log-Records (log_record.h) wiederholen sich
+// stark (Marken, Meldungs-IDs, Registernummern) -> typisch Faktor 2-4.
+//
+// Datei: "LLZ1" + u32 LE Rohgroesse, dann Gruppen aus einem Flag-Byte und 8 Elementen (Bit 0 zuerst):
+//   0 = Literal (1 Byte), 1 = Treffer (2 Byte LE: Bits 0-9 Abstand-1, Bits 10-15 Laenge-LOG_LZ_MIN_MATCH).
+// Das Ende ergibt sich aus der Rohgroesse. Rein auf Puffern, ohne Arduino/FreeRTOS (Host-pruefbar).
+// =========================================================================================
+
+#define LOG_LZ_WINDOW       1024
+#define LOG_LZ_MIN_MATCH    3
+#define LOG_LZ_MAX_MATCH    (LOG_LZ_MIN_MATCH + 63)
+#define LOG_LZ_HEADER_BYTES 8
+
+// Dekoder-Zustand; laesst sich zwischen zwei Aufrufen an beliebiger Stelle anhalten (Lese-Cursor).
+typedef struct
+{
+	uint8_t window[LOG_LZ_WINDOW];
+	uint32_t rawSize;
+	uint32_t inPos;  // Dateioffset des naechsten Eingabebytes
+	uint32_t outPos; // bisher erzeugte Rohbytes
+	uint16_t matchDist;
+	uint8_t matchLeft;
+	uint8_t flags;
+	uint8_t flagBits; // noch offene Elemente der aktuellen Gruppe
+} log_lz_state_t;
+
+// Prueft den Kopf (LOG_LZ_HEADER_BYTES) und liefert die Rohgroesse.
+bool logLzRawSize(const uint8_t *header, size_t len, uint32_t *rawSize);
+// Dasselbe und setzt den Zustand auf den Anfang der Daten.
+bool logLzBegin(log_lz_state_t &st, const uint8_t *header, size_t len);
+// Dekodiert aus in (ab Dateioffset st.inPos) nach out. *inUsed = verbrauchte Eingabe; ein nur
+// teilweise vorliegendes Element bleibt liegen. Rueckgabe = erzeugte Bytes (0 am Ende bzw. bei
+// zu wenig Eingabe).
+size_t logLzDecode(log_lz_state_t &st, const uint8_t *in, size_t inLen, size_t *inUsed, uint8_t *out, size_t outLen);
+
+// Komprimiert rawSize Bytes aus read nach write. Rueckgabe = geschriebene Bytes inkl. Kopf, 0 =
+// Fehler (kein Speicher, Schreibfehler, Eingabe kuerzer als rawSize).
+typedef size_t (*log_lz_read_t)(void *ctx, uint8_t *buf, size_t len);
+typedef size_t (*log_lz_write_t)(void *ctx, const uint8_t *buf, size_t len);
+size_t logLzCompress(uint32_t rawSize, log_lz_read_t read, log_lz_write_t write, void *ctx);
+
+#endif // SRC_LOG_LZ_H_
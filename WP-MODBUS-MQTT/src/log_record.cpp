@@ -0,0 +1,548 @@
+#include "log_record.h"
+
+#include <stdio.h>
+#include <string.h>
+
+typedef enum : uint8_t
+{
+	ARG_NONE = 0, // %% bzw. unbekannte Konvertierung
+	ARG_SIGNED,
+	ARG_UNSIGNED,
+	ARG_CHAR,
+	ARG_FLOAT,
+	ARG_STRING,
+	ARG_POINTER
+} log_arg_class_t;
+
+// Eine %-Angabe im Formatstring.
+typedef struct
+{
+	const char *start; // '%'
+	const char *end;   // hinter dem Konvertierungszeichen
+	uint8_t stars;     // '*' fuer Breite/Praezision (je ein int-Argument davor)
+	char lenMod;       // 0, 'H' (hh), 'h', 'l', 'L' (ll bzw. long double), 'j', 'z', 't'
+	char conv;
+} log_spec_t;
+
+typedef struct
+{
+	uint8_t *out;
+	size_t len;
+	size_t pos;
+} byte_writer_t;
+
+typedef struct
+{
+	const uint8_t *in;
+	size_t len;
+	size_t pos;
+} byte_reader_t;
+
+static bool isDigit(char c)
+{
+	return c >= '0' && c <= '9';
+}
+
+// p zeigt auf '%'. false = Formatstring endet mitten in der Angabe.
+static bool parseSpec(const char *p, log_spec_t &s)
+{
+	s.start = p++;
+	s.stars = 0;
+	s.lenMod = 0;
+	while (*p != 0 && strchr("-+ #0", *p) != nullptr)
+	{
+		p++;
+	}
+	if (*p == '*')
+	{
+		s.stars++;
+		p++;
+	}
+	while (isDigit(*p))
+	{
+		p++;
+	}
+	if (*p == '.')
+	{
+		p++;
+		if (*p == '*')
+		{
+			s.stars++;
+			p++;
+		}
+		while (isDigit(*p))
+		{
+			p++;
+		}
+	}
+	if (*p == 'h' || *p == 'l')
+	{
+		s.lenMod = *p++;
+		if (*p == s.lenMod)
+		{
+			s.lenMod = s.lenMod == 'h' ? 'H' : 'L';
+			p++;
+		}
+	}
+	else if (*p == 'L' || *p == 'j' || *p == 'z' || *p == 't')
+	{
+		s.lenMod = *p++;
+	}
+	if (*p == 0)
+	{
+		return false;
+	}
+	s.conv = *p;
+	s.end = p + 1;
+	return true;
+}
+
+static log_arg_class_t argClass(char conv)
+{
+	switch (conv)
+	{
+	case 'd': case 'i':
+		return ARG_SIGNED;
+	case 'u': case 'o': case 'x': case 'X':
+		return ARG_UNSIGNED;
+	case 'c':
+		return ARG_CHAR;
+	case 'f': case 'F': case 'e': case 'E': case 'g': case 'G': case 'a': case 'A':
+		return ARG_FLOAT;
+	case 's':
+		return ARG_STRING;
+	case 'p':
+		return ARG_POINTER;
+	default:
+		return ARG_NONE;
+	}
+}
+
+static uint64_t zigzag(int64_t v)
+{
+	return ((uint64_t)v << 1) ^ (uint64_t)(v >> 63);
+}
+
+static int64_t unzigzag(uint64_t v)
+{
+	return (int64_t)(v >> 1) ^ -(int64_t)(v & 1);
+}
+
+static bool putByte(byte_writer_t &w, uint8_t b)
+{
+	if (w.pos >= w.len)
+	{
+		return false;
+	}
+	w.out[w.pos++] = b;
+	return true;
+}
+
+static bool putVarint(byte_writer_t &w, uint64_t v)
+{
+	while (v >= 0x80)
+	{
+		if (!putByte(w, (uint8_t)v | 0x80))
+		{
+			return false;
+		}
+		v >>= 7;
+	}
+	return putByte(w, (uint8_t)v);
+}
+
+static bool putU32(byte_writer_t &w, uint32_t v)
+{
+	for (int i = 0; i < 4; ++i)
+	{
+		if (!putByte(w, (uint8_t)(v >> (8 * i))))
+		{
+			return false;
+		}
+	}
+	return true;
+}
+
+static bool putBytes(byte_writer_t &w, const void *data, size_t n)
+{
+	if (w.len - w.pos < n)
+	{
+		return false;
+	}
+	memcpy(w.out + w.pos, data, n);
+	w.pos += n;
+	return true;
+}
+
+// false = Daten zu Ende bzw. mehr als 10 Bytes (kein gueltiges varint).
+static bool getVarint(byte_reader_t &r, uint64_t &v)
+{
+	v = 0;
+	for (int shift = 0; shift < 70; shift += 7)
+	{
+		if (r.pos >= r.len)
+		{
+			return false;
+		}
+		uint8_t b = r.in[r.pos++];
+		v |= (uint64_t)(b & 0x7F) << shift;
+		if ((b & 0x80) == 0)
+		{
+			return true;
+		}
+	}
+	return false;
+}
+
+static bool getU32(byte_reader_t &r, uint32_t &v)
+{
+	if (r.len - r.pos < 4)
+	{
+		return false;
+	}
+	v = 0;
+	for (int i = 0; i < 4; ++i)
+	{
+		v |= (uint32_t)r.in[r.pos++] << (8 * i);
+	}
+	return true;
+}
+
+// Kopf ([Marke|Level] [Uptime] [ID]) nach out; Rueckgabe = Laenge (0 = passt nicht).
+static size_t encodeHeader(uint8_t *out, size_t len, int16_t level, uint32_t uptime_ms, uint32_t msg_id)
+{
+	byte_writer_t w = {out, len, 0};
+	if (!putByte(w, LOG_RECORD_MARK | (uint8_t)(level & 0x0F)) || !putVarint(w, uptime_ms) || !putU32(w, msg_id))
+	{
+		return 0;
+	}
+	return w.pos;
+}
+
+// Payload steht ab out + head + 2 (Platz fuer eine zweistellige Laenge); Laenge davorsetzen und bei
+// einstelliger Laenge die Payload ein Byte nachruecken.
+static size_t finishRecord(uint8_t *out, size_t head, size_t payload_len)
+{
+	if (payload_len < 0x80)
+	{
+		out[head] = (uint8_t)payload_len;
+		memmove(out + head + 1, out + head + 2, payload_len);
+		return head + 1 + payload_len;
+	}
+	out[head] = (uint8_t)payload_len | 0x80;
+	out[head + 1] = (uint8_t)(payload_len >> 7);
+	return head + 2 + payload_len;
+}
+
+size_t logRecordEncode(uint8_t *out, size_t len, int16_t level, uint32_t uptime_ms, uint32_t msg_id, const char *format, va_list args)
+{
+	size_t head = encodeHeader(out, len, level, uptime_ms, msg_id);
+	if (head == 0 || len - head < 2)
+	{
+		return 0;
+	}
+	size_t room = len - head - 2;
+	byte_writer_t w = {out + head + 2, room < 0x3FFF ? room : 0x3FFF, 0};
+	for (const char *p = format; *p != 0;)
+	{
+		if (*p != '%')
+		{
+			p++;
+			continue;
+		}
+		log_spec_t s;
+		if (!parseSpec(p, s))
+		{
+			break;
+		}
+		p = s.end;
+		size_t mark = w.pos;
+		bool ok = true;
+		for (uint8_t i = 0; i < s.stars; ++i)
+		{
+			ok &= putVarint(w, zigzag(va_arg(args, int)));
+		}
+		switch (argClass(s.conv))
+		{
+		case ARG_SIGNED:
+		{
+			int64_t v;
+			switch (s.lenMod)
+			{
+			case 'l': v = va_arg(args, long); break;
+			case 'L': v = va_arg(args, long long); break;
+			case 'j': v = va_arg(args, intmax_t); break;
+			case 'z': v = (int64_t)va_arg(args, size_t); break;
+			case 't': v = va_arg(args, ptrdiff_t); break;
+			default:  v = va_arg(args, int); break; // auch h/hh (int-Promotion)
+			}
+			ok &= putVarint(w, zigzag(v));
+			break;
+		}
+		case ARG_UNSIGNED:
+		{
+			uint64_t v;
+			switch (s.lenMod)
+			{
+			case 'l': v = va_arg(args, unsigned long); break;
+			case 'L': v = va_arg(args, unsigned long long); break;
+			case 'j': v = va_arg(args, uintmax_t); break;
+			case 'z': v = va_arg(args, size_t); break;
+			case 't': v = (uint64_t)va_arg(args, ptrdiff_t); break;
+			case 'h': v = (unsigned short)va_arg(args, unsigned int); break;
+			case 'H': v = (unsigned char)va_arg(args, unsigned int); break;
+			default:  v = va_arg(args, unsigned int); break;
+			}
+			ok &= putVarint(w, v);
+			break;
+		}
+		case ARG_CHAR:
+			ok &= putVarint(w, (uint8_t)va_arg(args, int));
+			break;
+		case ARG_FLOAT:
+		{
+			float f = s.lenMod == 'L' ? (float)va_arg(args, long double) : (float)va_arg(args, double);
+			ok &= putBytes(w, &f, sizeof(f)); // Xtensa und x86: little endian
+			break;
+		}
+		case ARG_STRING:
+		{
+			const char *str = va_arg(args, const char *);
+			if (str == nullptr)
+			{
+				str = "(null)";
+			}
+			size_t n = strnlen(str, LOG_RECORD_MAX_STR);
+			ok &= putVarint(w, n) && putBytes(w, str, n);
+			break;
+		}
+		case ARG_POINTER:
+			ok &= putVarint(w, (uintptr_t)va_arg(args, void *));
+			break;
+		case ARG_NONE:
+			break;
+		}
+		if (!ok)
+		{
+			w.pos = mark; // Argument passt nicht mehr -> hier abschneiden
+			break;
+		}
+	}
+	return finishRecord(out, head, w.pos);
+}
+
+size_t logRecordEncodeRaw(uint8_t *out, size_t len, int16_t level, uint32_t uptime_ms, uint32_t msg_id, const uint8_t *payload, size_t payload_len)
+{
+	size_t head = encodeHeader(out, len, level, uptime_ms, msg_id);
+	if (head == 0 || len - head < 2)
+	{
+		return 0;
+	}
+	size_t room = len - head - 2;
+	if (payload_len > room)
+	{
+		payload_len = room;
+	}
+	if (payload_len > 0x3FFF)
+	{
+		payload_len = 0x3FFF;
+	}
+	memcpy(out + head + 2, payload, payload_len);
+	return finishRecord(out, head, payload_len);
+}
+
+size_t logRecordEncodeSync(uint8_t *out, size_t len, uint32_t uptime_ms, uint32_t epoch_s)
+{
+	uint8_t payload[5];
+	byte_writer_t w = {payload, sizeof(payload), 0};
+	putVarint(w, epoch_s);
+	return logRecordEncodeRaw(out, len, 0, uptime_ms, LOG_MSG_TIME_SYNC, payload, w.pos);
+}
+
+int logRecordParse(const uint8_t *buf, size_t len, log_record_t &rec)
+{
+	if (len == 0)
+	{
+		return 0;
+	}
+	if ((buf[0] & 0xF0) != LOG_RECORD_MARK || (buf[0] & 0x0F) > 4) // Level 0..LOG_LEVEL_DEBUG
+	{
+		return -1;
+	}
+	byte_reader_t r = {buf, len, 1};
+	uint64_t uptime, payload_len;
+	if (!getVarint(r, uptime))
+	{
+		return r.pos >= len ? 0 : -1;
+	}
+	if (uptime > 0xFFFFFFFFu || !getU32(r, rec.msg_id))
+	{
+		return uptime > 0xFFFFFFFFu ? -1 : 0;
+	}
+	size_t lenPos = r.pos;
+	if (!getVarint(r, payload_len))
+	{
+		return r.pos >= len ? 0 : -1;
+	}
+	if (payload_len > 0x3FFF || r.pos - lenPos > 2)
+	{
+		return -1;
+	}
+	if (len - r.pos < payload_len)
+	{
+		return 0;
+	}
+	rec.level = buf[0] & 0x0F;
+	rec.uptime_ms = (uint32_t)uptime;
+	rec.payload = buf + r.pos;
+	rec.payload_len = (size_t)payload_len;
+	return (int)(r.pos + payload_len);
+}
+
+uint32_t logRecordSyncEpoch(const log_record_t &rec)
+{
+	byte_reader_t r = {rec.payload, rec.payload_len, 0};
+	uint64_t v;
+	return getVarint(r, v) && v <= 0xFFFFFFFFu ? (uint32_t)v : 0;
+}
+
+// Haengt k Bytes an out an (gekuerzt auf den Platz, immer terminiert).
+static void appendText(char *out, size_t len, size_t &n, const char *s, size_t k)
+{
+	if (k > len - 1 - n)
+	{
+		k = len - 1 - n;
+	}
+	memcpy(out + n, s, k);
+	n += k;
+	out[n] = 0;
+}
+
+static void appendResult(size_t len, size_t &n, int m)
+{
+	if (m > 0)
+	{
+		n += (size_t)m < len - n ? (size_t)m : len - 1 - n;
+	}
+}
+
+size_t logRecordFormat(char *out, size_t len, const char *format, const uint8_t *payload, size_t payload_len)
+{
+	if (len == 0)
+	{
+		return 0;
+	}
+	byte_reader_t r = {payload, payload_len, 0};
+	size_t n = 0;
+	out[0] = 0;
+	for (const char *p = format; *p != 0 && n + 1 < len;)
+	{
+		if (*p != '%')
+		{
+			const char *q = strchr(p, '%');
+			size_t k = q != nullptr ? (size_t)(q - p) : strlen(p);
+			appendText(out, len, n, p, k);
+			p += k;
+			continue;
+		}
+		log_spec_t s;
+		if (!parseSpec(p, s))
+		{
+			appendText(out, len, n, p, strlen(p));
+			break;
+		}
+		p = s.end;
+		if (s.conv == '%')
+		{
+			appendText(out, len, n, "%", 1);
+			continue;
+		}
+		// Angabe ohne Laengenmodifikator nachbauen, '*' durch den gespeicherten Wert ersetzen.
+		char spec[32];
+		size_t k = 0;
+		bool ok = true;
+		for (const char *q = s.start; q < s.end - 1 && k < 16; ++q)
+		{
+			if (*q == '*')
+			{
+				uint64_t v;
+				ok &= getVarint(r, v);
+				k += snprintf(spec + k, 12, "%d", (int)unzigzag(v));
+			}
+			else if (strchr("hlLjzt", *q) == nullptr)
+			{
+				spec[k++] = *q;
+			}
+		}
+		uint64_t v = 0;
+		switch (argClass(s.conv))
+		{
+		case ARG_SIGNED:
+			ok &= getVarint(r, v);
+			snprintf(spec + k, sizeof(spec) - k, "ll%c", s.conv);
+			if (ok)
+			{
+				appendResult(len, n, snprintf(out + n, len - n, spec, (long long)unzigzag(v)));
+			}
+			break;
+		case ARG_UNSIGNED:
+			ok &= getVarint(r, v);
+			snprintf(spec + k, sizeof(spec) - k, "ll%c", s.conv);
+			if (ok)
+			{
+				appendResult(len, n, snprintf(out + n, len - n, spec, (unsigned long long)v));
+			}
+			break;
+		case ARG_CHAR:
+			ok &= getVarint(r, v);
+			snprintf(spec + k, sizeof(spec) - k, "c");
+			if (ok)
+			{
+				appendResult(len, n, snprintf(out + n, len - n, spec, (int)v));
+			}
+			break;
+		case ARG_FLOAT:
+		{
+			float f = 0;
+			ok &= r.len - r.pos >= sizeof(f);
+			if (ok)
+			{
+				memcpy(&f, r.in + r.pos, sizeof(f));
+				r.pos += sizeof(f);
+				snprintf(spec + k, sizeof(spec) - k, "%c", s.conv);
+				appendResult(len, n, snprintf(out + n, len - n, spec, (double)f));
+			}
+			break;
+		}
+		case ARG_STRING:
+		{
+			char str[LOG_RECORD_MAX_STR + 1];
+			ok &= getVarint(r, v) && v <= LOG_RECORD_MAX_STR && r.len - r.pos >= v;
+			if (ok)
+			{
+				memcpy(str, r.in + r.pos, (size_t)v);
+				str[v] = 0;
+				r.pos += (size_t)v;
+				snprintf(spec + k, sizeof(spec) - k, "s");
+				appendResult(len, n, snprintf(out + n, len - n, spec, str));
+			}
+			break;
+		}
+		case ARG_POINTER:
+			ok &= getVarint(r, v);
+			if (ok)
+			{
+				appendResult(len, n, snprintf(out + n, len - n, "0x%llx", (unsigned long long)v));
+			}
+			break;
+		case ARG_NONE:
+			appendText(out, len, n, s.start, (size_t)(s.end - s.start));
+			break;
+		}
+		if (!ok)
+		{
+			appendText(out, len, n, "?", 1); // Argument fehlt (beim Kodieren abgeschnitten)
+		}
+	}
+	return n;
+}
@@ -0,0 +1,71 @@
+#ifndef SRC_LOG_RECORD_H_
+#define SRC_LOG_RECORD_H_
+
+#include <stdarg.h>
+#include <stddef.h>
+#include <stdint.h>
+
+// =========================================================================================
+// Binaeres Log-Record-Format (Segmentdateien und Breadcrumb-Ring, siehe log.h). Bisher stand jede
+// Zeile als Text im Log: Zeitstempel + Level + fertig formatierte Meldung, 60-120 Byte, und jeder
+// Aufruf zahlte vsnprintf + strftime. Ein Record traegt nur die ID des Formatstrings und die rohen
+// Argumente (typisch 12-20 Byte):
+//
+//   [LOG_RECORD_MARK | level] [varint Uptime ms] [u32 LE Meldungs-ID] [varint Payload-Laenge] [Payload]
+//
+// Meldungs-ID = logFmtId(Formatstring), zur Compilezeit in LOGF berechnet. Payload = Argumente in der
+// Reihenfolge der %-Angaben: d/i und '*' zigzag-varint, u/o/x/X/c/p varint, f/e/g/a float32 LE,
+// s varint-Laenge + Bytes (hoechstens LOG_RECORD_MAX_STR). Reicht der Platz nicht, fehlen die
+// hinteren Argumente (Dekoder setzt "?").
+// Reservierte IDs: LOG_MSG_TEXT (Payload = fertiger Text, fuer log(String) und Banner) und
+// LOG_MSG_TIME_SYNC (Payload = varint Unix-Sekunden zur Uptime des Records, 0 = NTP nicht synchron).
+// Level 0 = Notiz ohne Zeitstempel/Level in der Textausgabe (Boot-Banner, Trennzeilen).
+//
+// Zurueck zu Text: auf dem Geraet logRecordFormat mit den Formatstrings der Laufzeit-Registry
+// (log.cpp, /log/*), auf dem Host tools/logdecode.py (sammelt die LOGF-Formatstrings aus src/ und
+// bildet dieselben IDs). Reine Byte-Arithmetik ohne Arduino/FreeRTOS, damit sie auf dem Host laeuft.
+// =========================================================================================
+
+#define LOG_RECORD_MARK     0xB0
+#define LOG_RECORD_MAX_STR  64   // %s-Argumente werden darauf gekuerzt
+#define LOG_MSG_TEXT        0u
+#define LOG_MSG_TIME_SYNC   1u
+
+// FNV-1a (32 Bit) ueber den Formatstring; 0 und 1 sind reserviert.
+constexpr uint32_t logFmtId(const char *s)
+{
+	uint32_t h = 2166136261u;
+	while (*s)
+	{
+		h = (h ^ (uint8_t)*s++) * 16777619u;
+	}
+	return h <= LOG_MSG_TIME_SYNC ? h + 2 : h;
+}
+
+typedef struct
+{
+	int16_t level;
+	uint32_t uptime_ms;
+	uint32_t msg_id;
+	const uint8_t *payload; // zeigt in den geparsten Puffer
+	size_t payload_len;
+} log_record_t;
+
+// Kodiert einen Record nach out (len: Platz, <= 16383). Rueckgabe = Laenge (0 = passt nicht).
+size_t logRecordEncode(uint8_t *out, size_t len, int16_t level, uint32_t uptime_ms, uint32_t msg_id, const char *format, va_list args);
+// Record mit fertiger Payload (LOG_MSG_TEXT: Text ohne Zeilenende; wird gekuerzt, falls noetig).
+size_t logRecordEncodeRaw(uint8_t *out, size_t len, int16_t level, uint32_t uptime_ms, uint32_t msg_id, const uint8_t *payload, size_t payload_len);
+size_t logRecordEncodeSync(uint8_t *out, size_t len, uint32_t uptime_ms, uint32_t epoch_s);
+
+// Parst den Record am Anfang von buf. > 0: Laenge des Records, 0: unvollstaendig (mehr Bytes
+// noetig), < 0: kein Record an dieser Stelle (ein Byte verwerfen und weitersuchen).
+int logRecordParse(const uint8_t *buf, size_t len, log_record_t &rec);
+
+// Setzt die Meldung aus Formatstring und Payload wieder zusammen (ohne Zeilenende, immer terminiert).
+// Rueckgabe = Laenge.
+size_t logRecordFormat(char *out, size_t len, const char *format, const uint8_t *payload, size_t payload_len);
+
+// Payload eines LOG_MSG_TIME_SYNC-Records (0 = NTP nicht synchron).
+uint32_t logRecordSyncEpoch(const log_record_t &rec);
+
+#endif // SRC_LOG_RECORD_H_
@@ -0,0 +1,229 @@
+#include "log_syslog.h"
+#include "log.h"
+
+#include <WiFi.h>
+#include <WiFiUdp.h>
+#include <sys/time.h>
+#include <time.h>
+
+volatile int16_t syslogLevel = LOG_LEVEL_WARNING;
+
+static WiFiUDP syslogUdp;
+static char syslogHost[40];
+static char syslogHostname[16];
+static uint16_t syslogPort = 514;
+static bool syslogRaw = false;
+static volatile bool syslogEnabled = false;
+// Aufgeloeste Zieladresse (0 = noch nicht). Schreibt nur der Writer-Task (syslogMaintain, ohne
+// Log-Mutex, weil DNS blockieren kann); ein Wort -> atomar fuer die Leser.
+static volatile uint32_t syslogAddr = 0;
+static uint32_t lastResolveMs = 0;
+// Ab hier nur der Konsument des Log-Rings (unter logMutex).
+static uint32_t tokens = SYSLOG_BURST;
+static uint32_t lastRefillMs = 0;
+static uint32_t throttled = 0; // seit der letzten Hinweis-Meldung gedrosselt
+static uint8_t datagram[SYSLOG_RAW_DATAGRAM_BYTES];
+static size_t datagramLen = 0;
+static volatile uint32_t sentDatagrams = 0;
+static volatile uint32_t droppedMessages = 0;
+
+void initSyslog(const char *host, uint16_t port, bool raw, const char *hostname)
+{
+	strlcpy(syslogHost, host, sizeof(syslogHost));
+	strlcpy(syslogHostname, hostname, sizeof(syslogHostname));
+	syslogPort = port != 0 ? port : 514;
+	syslogRaw = raw;
+	lastRefillMs = millis();
+	syslogEnabled = syslogHost[0] != 0;
+	if (!syslogEnabled)
+	{
+		syslogLevel = 0;
+		return;
+	}
+	LOGF(LOG_LEVEL_INFO, "Syslog an %s:%u (%s)", syslogHost, syslogPort, raw ? "kompakt" : "RFC 5424");
+}
+
+bool syslogActive()
+{
+	return syslogEnabled;
+}
+
+void syslogMaintain()
+{
+	if (!syslogEnabled || !WiFi.isConnected())
+	{
+		return;
+	}
+	uint32_t now = millis();
+	// Aufgeloest: alle SYSLOG_RESOLVE_MS erneuern; sonst hoechstens alle 30 s probieren (DNS-Timeout).
+	if (lastResolveMs != 0 && now - lastResolveMs < (syslogAddr != 0 ? SYSLOG_RESOLVE_MS : 30000))
+	{
+		return;
+	}
+	lastResolveMs = now != 0 ? now : 1;
+	IPAddress ip;
+	if (ip.fromString(syslogHost) || WiFi.hostByName(syslogHost, ip) == 1)
+	{
+		syslogAddr = (uint32_t)ip;
+	}
+}
+
+// Token-Bucket: SYSLOG_RATE_PER_S Dauerrate, bis zu SYSLOG_BURST am Stueck.
+static bool takeToken()
+{
+	uint32_t elapsed = millis() - lastRefillMs;
+	if (elapsed >= 1000u * SYSLOG_BURST / SYSLOG_RATE_PER_S)
+	{
+		tokens = SYSLOG_BURST;
+		lastRefillMs += elapsed;
+	}
+	else if (uint32_t refill = elapsed * SYSLOG_RATE_PER_S / 1000)
+	{
+		tokens = tokens + refill < SYSLOG_BURST ? tokens + refill : SYSLOG_BURST;
+		lastRefillMs += refill * 1000 / SYSLOG_RATE_PER_S;
+	}
+	if (tokens == 0)
+	{
+		return false;
+	}
+	tokens--;
+	return true;
+}
+
+static void sendDatagram(const uint8_t *data, size_t len)
+{
+	if (syslogAddr == 0 || !WiFi.isConnected() || !syslogUdp.beginPacket(IPAddress(syslogAddr), syslogPort))
+	{
+		droppedMessages++;
+		return;
+	}
+	syslogUdp.write(data, len);
+	if (syslogUdp.endPacket())
+	{
+		sentDatagrams++;
+	}
+	else
+	{
+		droppedMessages++;
+	}
+}
+
+// Level -> Syslog-Severity (err, warning, info, debug; Notizen mit Level 0 = notice).
+static int severity(int16_t level)
+{
+	switch (level)
+	{
+	case LOG_LEVEL_ERROR:   return 3;
+	case LOG_LEVEL_WARNING: return 4;
+	case LOG_LEVEL_INFO:    return 6;
+	case LOG_LEVEL_DEBUG:   return 7;
+	default:                return 5;
+	}
+}
+
+static void sendRfc5424(const log_record_t &rec, const char *message)
+{
+	char ts[32] = "-";
+	struct timeval tv;
+	gettimeofday(&tv, nullptr);
+	if (tv.tv_sec > 1600000000) // vor dem NTP-Sync steht die Uhr bei 1970 -> NILVALUE
+	{
+		int64_t ms = (int64_t)tv.tv_sec * 1000 + tv.tv_usec / 1000 - (int32_t)(millis() - rec.uptime_ms);
+		time_t t = (time_t)(ms / 1000);
+		struct tm tm;
+		gmtime_r(&t, &tm);
+		size_t k = strftime(ts, sizeof(ts), "%Y-%m-%dT%H:%M:%S", &tm);
+		snprintf(ts + k, sizeof(ts) - k, ".%03uZ", (unsigned)(ms % 1000));
+	}
+	char msgid[12] = "-";
+	if (rec.msg_id > LOG_MSG_TIME_SYNC)
+	{
+		snprintf(msgid, sizeof(msgid), "%08lx", (unsigned long)rec.msg_id);
+	}
+	char packet[LOG_LINE_MAX_BYTES + 96];
+	int n = snprintf(packet, sizeof(packet), "<%d>1 %s %s " SYSLOG_APP_NAME " - %s - %s",
+					 SYSLOG_FACILITY * 8 + severity(rec.level), ts, syslogHostname, msgid, message);
+	if (n > 0)
+	{
+		sendDatagram((const uint8_t *)packet, (size_t)n < sizeof(packet) ? n : sizeof(packet) - 1);
+	}
+}
+
+// Kompaktes Format: Record ans Sammel-Datagramm haengen; ein volles vorher abschicken.
+static void appendRaw(const uint8_t *raw, size_t raw_len)
+{
+	if (datagramLen + raw_len > sizeof(datagram))
+	{
+		syslogFlush();
+	}
+	if (datagramLen == 0)
+	{
+		// Jedes Datagramm fuer sich dekodierbar: Uptime -> Wanduhr vorweg.
+		time_t now = time(nullptr);
+		datagramLen = logRecordEncodeSync(datagram, sizeof(datagram), millis(), now > 1600000000 ? (uint32_t)now : 0);
+	}
+	if (datagramLen + raw_len <= sizeof(datagram))
+	{
+		memcpy(datagram + datagramLen, raw, raw_len);
+		datagramLen += raw_len;
+	}
+}
+
+static void emit(const log_record_t &rec, const uint8_t *raw, size_t raw_len, const char *message)
+{
+	if (syslogRaw)
+	{
+		appendRaw(raw, raw_len);
+	}
+	else
+	{
+		sendRfc5424(rec, message);
+	}
+}
+
+void syslogRecord(const log_record_t &rec, const uint8_t *raw, size_t raw_len, const char *message)
+{
+	if (!syslogEnabled || syslogLevel == 0 || rec.level > syslogLevel)
+	{
+		return;
+	}
+	if (!takeToken())
+	{
+		droppedMessages++;
+		throttled++;
+		return;
+	}
+	if (throttled > 0)
+	{
+		char note[64];
+		int n = snprintf(note, sizeof(note), "Syslog gedrosselt: %lu Meldung(en) verworfen", (unsigned long)throttled);
+		uint8_t buf[96];
+		log_record_t noteRec;
+		size_t len = logRecordEncodeRaw(buf, sizeof(buf), LOG_LEVEL_WARNING, millis(), LOG_MSG_TEXT, (const uint8_t *)note, n);
+		if (logRecordParse(buf, len, noteRec) > 0)
+		{
+			emit(noteRec, buf, len, note);
+		}
+		throttled = 0;
+	}
+	emit(rec, raw, raw_len, message);
+}
+
+void syslogFlush()
+{
+	if (datagramLen > 0)
+	{
+		sendDatagram(datagram, datagramLen);
+		datagramLen = 0;
+	}
+}
+
+uint32_t syslogSent()
+{
+	return sentDatagrams;
+}
+
+uint32_t syslogDropped()
+{
+	return droppedMessages;
+}
@@ -0,0 +1,41 @@
+#ifndef SRC_LOG_SYSLOG_H_
+#define SRC_LOG_SYSLOG_H_
+
+#include "Arduino.h"
+#include "log_record.h"
+
+// Netzwerk-Log-Senke (UDP). Bisher gab es nur Serial (74880 Baud, blockiert den Aufrufer) und das
+// Datei-Log (Flash-Verschleiss bei INFO/DEBUG). Der Syslog-Sink haengt am selben RAM-Ring wie das
+// Datei-Log: log()/LOGF kopieren nur den Record, der Writer-Task (log.cpp) verteilt ihn beim Flush
+// an Datei und Netz. Level-Schwelle syslogLevel (log.h) unabhaengig vom Datei-Log-Level, zur
+// Laufzeit ueber /logs umschaltbar -> INFO/DEBUG remote mitlesen, ohne den Flash zu belasten.
+//
+// Formate (WiFiManager-Parameter "syslog_raw"):
+//   RFC 5424: je Meldung ein Datagramm "<PRI>1 <Zeit> <Host> SYSLOG_APP_NAME - <MSGID> - <Text>",
+//             Facility local0, MSGID = Meldungs-ID (LOGF) bzw. "-". Fuer rsyslog/syslog-ng/Graylog.
+//   kompakt:  die binaeren Records unveraendert, gesammelt bis SYSLOG_RAW_DATAGRAM_BYTES je Datagramm,
+//             jedes beginnt mit einem Zeit-Sync. Dekodieren: tools/logdecode.py --udp <port>.
+// Drosselung per Token-Bucket (SYSLOG_RATE_PER_S, Burst SYSLOG_BURST); verworfene Meldungen werden
+// gezaehlt (/status) und als eigene Meldung nachgereicht. Ohne WLAN bzw. aufgeloesten Host wird nichts
+// gesendet. Testen: nc -ul 5514 bzw. python3 tools/logdecode.py --udp 5514.
+#define SYSLOG_APP_NAME           "wp-modbus"
+#define SYSLOG_FACILITY           16     // local0
+#define SYSLOG_RATE_PER_S         20
+#define SYSLOG_BURST              50
+#define SYSLOG_RESOLVE_MS         600000 // Hostname so oft neu aufloesen (DHCP/DNS-Aenderungen)
+#define SYSLOG_RAW_DATAGRAM_BYTES 1024
+
+// host leer = Sink aus (syslogLevel wird dann 0). Aus setup(), sobald der Hostname feststeht.
+void initSyslog(const char *host, uint16_t port, bool raw, const char *hostname);
+bool syslogActive();
+// Nur aus dem Writer-Task (darf blockieren): DNS-Aufloesung des Ziels.
+void syslogMaintain();
+// Vom Konsumenten des Log-Rings (unter dem Log-Mutex): ein Record samt dekodiertem Text.
+void syslogRecord(const log_record_t &rec, const uint8_t *raw, size_t raw_len, const char *message);
+// Am Ende eines Flushs: gesammeltes Datagramm (kompaktes Format) abschicken.
+void syslogFlush();
+// Fuer das /status-JSON: gesendete Datagramme bzw. verworfene Meldungen seit Boot.
+uint32_t syslogSent();
+uint32_t syslogDropped();
+
+#endif // SRC_LOG_SYSLOG_H_
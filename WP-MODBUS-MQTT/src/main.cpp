@@ -1,7 +1,7 @@
 #include "main.h"
 
-// Modbus-Bus-Timing (MODBUS_POLL_INTERVAL_MS / MODBUS_SCANRATE_MS) liegt jetzt in modbus_base.h:
-// der Worker-Task taktet sich selbst, kein Poll-Timer mehr im Loop.
+// Modbus-Bus-Timing (MODBUS_POLL_PERIOD_*_MS, adaptiver Bus-Gap) liegt jetzt in modbus_base.h/
+// modbus_gap.h: der Worker-Task taktet sich selbst (Deadline-Scheduler), kein Poll-Timer mehr im Loop.
 
 static char HOSTNAME[12] = "ESP-MM-FFFF";
 static const char __attribute__((__unused__)) *TAG = "Main";
@@ -32,6 +32,28 @@ int freeHeap;
 volatile uint32_t mqttDisconnectCount = 0;
 volatile uint32_t wifiDisconnectCount = 0;
 extern volatile uint32_t webserverRestartCount;
+// Nach Boot/Reconnect alles neu senden (Vollbild + im Per-Register-Modus alle reg/-Topics).
+// Zaehler statt Flag: onMqttConnect (AsyncTCP-Task) erhoeht ihn, publishModbusData (Loop-Task) merkt
+// sich den beim Start gelesenen Stand als erledigt. Ein Reconnect waehrend des Publishs erhoeht ihn
+// erneut und geht so nicht verloren (ein Flag haette der Loop danach einfach geloescht).
+static volatile uint32_t mqttResyncRequested = 1;
+static uint32_t mqttResyncDone = 0; // nur Loop-Task
+#ifndef MODBUS_DISABLED
+// Publish-Pfad ohne Heap: die JsonDocuments fuer /data und reg/ holen ihren Speicher aus dem
+// statischen Pool, serialisiert wird in einen zur Compilezeit bemessenen Puffer (kModbusDataJsonMax).
+// Beides nur aus dem Loop-Task benutzt, immer nur ein Dokument zur Zeit.
+static JsonPoolAllocator<MQTT_JSON_POOL_BYTES> mqttJsonPool;
+#ifndef DATA_JSON_LEGACY
+static char dataJsonBuffer[kModbusDataJsonMax];
+#endif
+// Messwerte des letzten /data-Publishs fuer das /status-JSON (Groesse, CPU-Zyklen und Heap-Verbrauch
+// fuer Aufbau + Serialisierung). Mit -DDATA_JSON_LEGACY (env:ESP32_json_legacy) laeuft stattdessen
+// der fruehere measureJson/malloc-Pfad und fuellt dieselben Werte -> Vergleich auf demselben Geraet.
+// Heap = Differenz des freien Heaps, andere Tasks koennen dazwischenfunken (Mittel ueber mehrere Publishs).
+static volatile uint32_t dataJsonBytes = 0;
+static volatile uint32_t dataJsonCycles = 0;
+static volatile int32_t dataJsonHeapBytes = 0;
+#endif // MODBUS_DISABLED
 
 // Schaltet zwischen App- und MQTT-Steuerung um und setzt entsprechend WBR3_EN_PIN.
 // Sorgt dafuer, dass nie zwei Modbus-Master gleichzeitig aktiv sind (kein Buskonflikt):
@@ -93,11 +115,11 @@ void stopMqttConnectTimer()
 bool reportMemoryStatus(void *pvParameters)
 {
 	int freeHeap = ESP.getFreeHeap();
-	log(LOG_LEVEL_INFO, "Free heap: " + String(freeHeap) + " bytes");
+	LOGF(LOG_LEVEL_INFO, "Free heap: %d bytes", freeHeap);
 	struct tm now;
 	if (getLocalTime(&now))
 	{
-		log(LOG_LEVEL_INFO, "Time: " + String(now.tm_year + 1900) + "-" + String(now.tm_mon + 1) + "-" + String(now.tm_mday) + " " + String(now.tm_hour) + ":" + String(now.tm_min) + ":" + String(now.tm_sec));
+		LOGF(LOG_LEVEL_INFO, "Time: %d-%d-%d %d:%d:%d", now.tm_year + 1900, now.tm_mon + 1, now.tm_mday, now.tm_hour, now.tm_min, now.tm_sec);
 	}
 	else
 	{
@@ -117,6 +139,49 @@ bool reportMemoryStatus(void *pvParameters)
 	json += "\"mqttDisconnects\":" + String(mqttDisconnectCount) + ",";
 	json += "\"wifiDisconnects\":" + String(wifiDisconnectCount) + ",";
 	json += "\"webserverRestarts\":" + String(webserverRestartCount) + ",";
+	// Asynchrones Datei-Log: verworfene Zeilen (Ring voll) und Flash-Schreibvorgaenge seit Boot.
+	json += "\"logDropped\":" + String(logDroppedLines()) + ",";
+	json += "\"logFlashWrites\":" + String(logFlashWrites()) + ",";
+	// UDP-Syslog: gesendete Datagramme und verworfene Meldungen (Drosselung, kein WLAN/Ziel) seit Boot.
+	json += "\"syslogSent\":" + String(syslogSent()) + ",";
+	json += "\"syslogDropped\":" + String(syslogDropped()) + ",";
+#ifndef MODBUS_DISABLED
+	// Groesste Startverspaetung eines Poll-Range-Reads seit dem letzten Report (Deadline-Scheduler).
+	json += "\"pollJitterMaxMs\":" + String(modbusPollJitterMaxMs()) + ",";
+	// Gelernter Inter-Transaktions-Abstand und Erstversuch-Erfolgsquote (adaptiver Bus-Gap).
+	json += "\"busGapMs\":" + String(busGapMs()) + ",";
+	json += "\"busFirstTryPct\":" + String(busGapFirstTryPct()) + ",";
+	// Listen-before-talk: gelernte Poll-Periode des Displays (0 = nicht eingerastet) und Zahl der
+	// seit dem letzten Report zurueckgestellten Transaktionen.
+	json += "\"busForeignPeriodMs\":" + String(busArbiterPeriodMs()) + ",";
+	json += "\"busDeferrals\":" + String(busArbiterDeferrals()) + ",";
+	// Buszeit seit Boot je Klasse (Fair-Share im Worker): steigt busPollMs waehrend eines grossen
+	// /modbusdump weiter, bekommt der Poll seinen Anteil; busWriteMs zeigt die Last durch MQTT-Writes.
+	json += "\"busWriteMs\":" + String(modbusBusTimeMs(MODBUS_CLASS_WRITE)) + ",";
+	json += "\"busPollMs\":" + String(modbusBusTimeMs(MODBUS_CLASS_POLL)) + ",";
+	json += "\"busDumpMs\":" + String(modbusBusTimeMs(MODBUS_CLASS_DUMP)) + ",";
+	json += "\"busDiscoveryMs\":" + String(modbusBusTimeMs(MODBUS_CLASS_DISCOVERY)) + ",";
+	json += "\"busScopeMs\":" + String(modbusBusTimeMs(MODBUS_CLASS_SCOPE)) + ",";
+	// Gelernte Adresskarte (Dump-Bisektion): bekannt unlesbare Register und Zahl der Intervalle.
+	json += "\"busHoles\":" + String(modbusHolesUnreadable()) + ",";
+	json += "\"busHoleSpans\":" + String(modbusHolesSpans()) + ",";
+	// Passiver Sniffer: gepaarte Fremd-Transaktionen bzw. verworfene Frames seit Boot.
+	json += "\"sniffPairs\":" + String(snifferPairs()) + ",";
+	json += "\"sniffDropped\":" + String(snifferDropped()) + ",";
+	// Letzter /data-Publish: Laenge, CPU-Zyklen und Heap fuer Aufbau + Serialisierung, Spitzenbelegung
+	// und Ueberlaeufe des JSON-Pools (statt Heap).
+	json += "\"dataJsonBytes\":" + String(dataJsonBytes) + ",";
+	json += "\"dataJsonCycles\":" + String(dataJsonCycles) + ",";
+	json += "\"dataJsonHeapBytes\":" + String(dataJsonHeapBytes) + ",";
+	json += "\"jsonPoolHighWater\":" + String(mqttJsonPool.highWater()) + ",";
+	json += "\"jsonPoolOverflows\":" + String(mqttJsonPool.failures()) + ",";
+#ifdef ALLOC_BENCH
+	// Bench-Builds (alloc_bench.h): malloc/calloc/realloc des letzten Poll-Zyklus (Worker) bzw. des
+	// letzten publishModbusUpdate() (Loop).
+	json += "\"allocPollCycle\":" + String(allocPollCycle) + ",";
+	json += "\"allocPublish\":" + String(allocPublish) + ",";
+#endif
+#endif // MODBUS_DISABLED
 	json += "\"uptime\":" + String(millis() / 1000) + ",";
 	json += "\"time\":\"" + String(now.tm_year + 1900) + "-" + String(now.tm_mon + 1) + "-" + String(now.tm_mday) + " " + String(now.tm_hour) + ":" + String(now.tm_min) + ":" + String(now.tm_sec) + "\"";
 	json += "}";
@@ -124,7 +189,7 @@ bool reportMemoryStatus(void *pvParameters)
 	{
 		String mqtt_complete_topic = param_mqtt_topic;
 		mqtt_complete_topic += "/" + String(HOSTNAME) + "/status";
-		log(LOG_LEVEL_INFO, "MQTT Publishing data to topic " + mqtt_complete_topic + ": " + json);
+		LOGF(LOG_LEVEL_INFO, "MQTT Publishing data to topic %s: %s", mqtt_complete_topic.c_str(), json.c_str());
 		mqtt_client.publish(mqtt_complete_topic.c_str(), 0, true, json.c_str(), json.length());
 	}
 	return true;
@@ -163,6 +228,7 @@ void onMqttConnect(bool sessionPresent)
 	log(LOG_LEVEL_INFO, "Connected to MQTT");
 	log(LOG_LEVEL_INFO, "Session present: " + sessionPresent ? "true" : "false");
 	stopMqttConnectTimer();
+	mqttResyncRequested = mqttResyncRequested + 1; // nur hier geschrieben
 
 	String mqtt_complete_topic = param_mqtt_topic;
 	mqtt_complete_topic += "/" + String(HOSTNAME);
@@ -205,48 +271,192 @@ void wiFiEvent(WiFiEvent_t event)
 
 void onMqttSubscribe(uint16_t packetId, uint8_t qos)
 {
-	log(LOG_LEVEL_INFO, "Subscribe acknowledged for packetId: " + String(packetId) + " qos: " + String(qos));
+	LOGF(LOG_LEVEL_INFO, "Subscribe acknowledged for packetId: %u qos: %u", packetId, qos);
 }
 
 void onMqttUnsubscribe(uint16_t packetId)
 {
-	log(LOG_LEVEL_INFO, "Unsubscribe acknowledged for packetId: " + String(packetId));
+	LOGF(LOG_LEVEL_INFO, "Unsubscribe acknowledged for packetId: %u", packetId);
 }
 
-// Baut das komplette Datenmodell (Register + Fehlerstatus) aus dem aktuellen Cache
-// (register_values[]/Fault-Cache) und publisht es retained auf .../data. Liest NICHT den Bus —
-// arbeitet rein aus dem Cache. Wird vom Poller nach einem vollen Zyklus aufgerufen UND direkt nach
-// einem erfolgreichen MQTT-Write, damit der gesetzte Wert sofort (ohne Poll-Latenz) zurueckgemeldet
+// <topic>/<host>/<suffix> einmalig zusammensetzen (Topic und Hostname stehen nach setup() fest).
+static const char *mqttTopic(char *buf, size_t len, const char *suffix)
+{
+	if (buf[0] == 0)
+	{
+		snprintf(buf, len, "%s/%s/%s", param_mqtt_topic, HOSTNAME, suffix);
+	}
+	return buf;
+}
+
+// Publiziert die im Totband-Sinn geaenderten Register einzeln (retained) auf .../reg/<name>, Payload
+// = der Wert wie in /data (Bitfelder je Bit unter ihrem Bitnamen). Nur im Per-Register-Modus.
+static void publishChangedRegisters(const register_snapshot_t &snap, const bool *changed)
+{
+	static char base_topic[80];
+	mqttTopic(base_topic, sizeof(base_topic), "reg/");
+	mqttJsonPool.reset();
+	JsonDocument json_doc(&mqttJsonPool);
+	writeRegisterValuesToJson(snap, json_doc, changed);
+	// Ungueltige Werte (0xFFFF bzw. nicht dekodierbar) laesst writeRegisterValuesToJson weg; als null
+	// melden (wie web_live.cpp), sonst behielte das retained reg/-Topic den letzten gueltigen Wert.
+	for (size_t i = 0; i < MODBUS_NUM_REGISTERS; ++i)
+	{
+		if (!changed[i])
+		{
+			continue;
+		}
+		const modbus_register_t &reg = registers[i];
+		if (reg.type == REGISTER_TYPE_BITFIELD && snap.values[i] == 0xFFFF)
+		{
+			for (const char *bit : reg.optional_param.bitfield)
+			{
+				if (bit == nullptr)
+				{
+					break;
+				}
+				json_doc[bit] = nullptr;
+			}
+		}
+		else if ((reg.type == REGISTER_TYPE_U16 || reg.type == REGISTER_TYPE_DIEMATIC_ONE_DECIMAL) &&
+				 json_doc[reg.name].isNull())
+		{
+			json_doc[reg.name] = nullptr;
+		}
+	}
+	for (JsonPair kv : json_doc.as<JsonObject>())
+	{
+		char payload[16];
+		char topic[128];
+		size_t n = serializeJson(kv.value(), payload, sizeof(payload));
+		snprintf(topic, sizeof(topic), "%s%s", base_topic, kv.key().c_str());
+		mqtt_client.publish(topic, 0, true, payload, n);
+	}
+}
+
+// Baut das komplette Datenmodell (Register + Fehlerstatus) aus dem aktuellen Register-Snapshot
+// (readRegisterSnapshot) und publisht es retained auf .../data. Liest NICHT den Bus —
+// arbeitet rein aus dem Cache. Wird vom Poller bei geaenderten Werten (spaetestens alle
+// MODBUS_PUBLISH_MAX_AGE_MS) aufgerufen UND direkt nach einem erfolgreichen MQTT-Write, damit der gesetzte Wert sofort (ohne Poll-Latenz) zurueckgemeldet
 // wird und kein Feedback-Loop/Flackern beim Umschalten in Home Assistant entsteht.
+// Delta-Publish: verglichen wird mit dem zuletzt GESENDETEN Stand (Totband je Register, Hysterese).
+// Ohne Aenderung geht /data nur alle MQTT_FULL_SNAPSHOT_MS als Vollbild raus (statt alle 10 s). Im
+// Per-Register-Modus (param_mqtt_per_register) gehen Aenderungen nur auf .../reg/<name>, /data
+// dann nur bei Fehler-Aenderungen und als periodisches Vollbild fuer spaete Abonnenten.
 void publishModbusData()
 {
-	JsonDocument json_doc;
-	// Cache konsistent lesen: der Worker (Core 0) schreibt register_values[]/Fault-Cache, hier
-	// (Loop-Task) wird daraus das JSON gebaut. Kurzer Lock verhindert torn/inkonsistente Reads.
-	if (lockRegisterCache(200))
+	// Konsistenten Snapshot lesen (Seqlock, blockiert weder Loop noch Worker): alle Werte stammen
+	// aus demselben Commit des Workers, kein Mischen von Ranges verschiedener Zyklen mehr.
+	static register_snapshot_t snap; // static: nicht auf dem Loop-Stack, nur aus dem Loop-Task benutzt
+	readRegisterSnapshot(snap);
+	if (!mqtt_client.connected())
 	{
-		writeRegisterValuesToJson(json_doc);
-		writeFaultStatusToJson(json_doc); // Geraetefehler als faults[]/fault_active in dieselbe Struktur
-		unlockRegisterCache();
+		return; // Referenz bleibt stehen -> nach dem Reconnect geht ohnehin alles neu raus
 	}
-	else
+	// Zuletzt gesendeter Stand (nur Loop-Task).
+	static uint16_t sentValues[MODBUS_NUM_REGISTERS];
+	static uint16_t sentFaultValue[MODBUS_NUM_FAULT_REGS];
+	static bool sentFaultValid[MODBUS_NUM_FAULT_REGS];
+	static uint32_t lastFullSnapshotMs = 0;
+	static bool changed[MODBUS_NUM_REGISTERS];
+	uint32_t resyncGen = mqttResyncRequested;
+	bool resync = resyncGen != mqttResyncDone;
+	bool anyChanged = false;
+	for (size_t i = 0; i < MODBUS_NUM_REGISTERS; ++i)
+	{
+		changed[i] = resync || registerChanged(i, sentValues[i], snap.values[i]);
+		anyChanged |= changed[i];
+	}
+	bool faultsChanged = memcmp(sentFaultValue, snap.faultValue, sizeof(sentFaultValue)) != 0 ||
+						 memcmp(sentFaultValid, snap.faultValid, sizeof(sentFaultValid)) != 0;
+	bool perRegister = param_mqtt_per_register[0] == '1';
+	uint32_t nowMs = millis();
+
+	if (perRegister && anyChanged)
+	{
+		publishChangedRegisters(snap, changed);
+		for (size_t i = 0; i < MODBUS_NUM_REGISTERS; ++i)
+		{
+			if (changed[i])
+			{
+				sentValues[i] = snap.values[i]; // nur gesendete Werte: Drift der anderen summiert sich weiter
+			}
+		}
+	}
+	bool fullDue = resync || (uint32_t)(nowMs - lastFullSnapshotMs) >= MQTT_FULL_SNAPSHOT_MS;
+	if (!fullDue && !faultsChanged && (perRegister || !anyChanged))
 	{
-		log(LOG_LEVEL_WARNING, "publishModbusData: Cache-Lock-Timeout, Publish uebersprungen");
+		LOGF(LOG_LEVEL_DEBUG, "MQTT /data unveraendert (Totband) - kein Publish");
 		return;
 	}
-	size_t json_size = measureJson(json_doc) + 1;
-	log(LOG_LEVEL_INFO, "JSON size: " + String(json_size) + " bytes");
-	char *buffer = (char *)malloc(json_size * sizeof(char));
-	size_t n = serializeJson(json_doc, buffer, json_size);
-	log(LOG_LEVEL_INFO, "JSON serialized: " + String(buffer));
-	if (mqtt_client.connected())
+
+#ifdef DATA_JSON_LEGACY
+	// Frueherer Pfad (nur Vergleichsmessung, env:ESP32_json_legacy): Heap-JsonDocument, measureJson,
+	// malloc, Payload-Log als String. Gemessen wird dieselbe Spanne wie unten (Aufbau + Serialisierung).
 	{
+		uint32_t heapBefore = ESP.getFreeHeap();
+		uint32_t startCycles = ESP.getCycleCount();
+		JsonDocument json_doc;
+		writeRegisterValuesToJson(snap, json_doc);
+		writeFaultStatusToJson(snap, json_doc);
+		writeSniffFreshnessToJson(snap, json_doc);
+		size_t json_size = measureJson(json_doc) + 1;
+		char *buffer = (char *)malloc(json_size * sizeof(char));
+		if (buffer == nullptr)
+		{
+			log(LOG_LEVEL_ERROR, "MQTT /data: kein RAM fuer " + String(json_size) + " Bytes - kein Publish");
+			return;
+		}
+		size_t n = serializeJson(json_doc, buffer, json_size);
+		dataJsonCycles = ESP.getCycleCount() - startCycles;
+		dataJsonHeapBytes = (int32_t)(heapBefore - ESP.getFreeHeap());
+		dataJsonBytes = n;
+		log(LOG_LEVEL_INFO, "JSON size: " + String(json_size) + " bytes");
+		log(LOG_LEVEL_INFO, "JSON serialized: " + String(buffer));
 		String mqtt_complete_topic = param_mqtt_topic;
 		mqtt_complete_topic += "/" + String(HOSTNAME) + "/data";
 		log(LOG_LEVEL_INFO, "MQTT Publishing data to topic: " + String(mqtt_complete_topic.c_str()));
 		mqtt_client.publish(mqtt_complete_topic.c_str(), 0, true, buffer, n);
+		free(buffer);
+	}
+#else
+	size_t n;
+	{
+		uint32_t heapBefore = ESP.getFreeHeap();
+		uint32_t startCycles = ESP.getCycleCount();
+		mqttJsonPool.reset();
+		JsonDocument json_doc(&mqttJsonPool);
+		writeRegisterValuesToJson(snap, json_doc);
+		writeFaultStatusToJson(snap, json_doc);	   // Geraetefehler als faults[]/fault_active in dieselbe Struktur
+		writeSniffFreshnessToJson(snap, json_doc); // Alter mitgehoerter Werte (App-Modus)
+		if (json_doc.overflowed())
+		{
+			log(LOG_LEVEL_ERROR, "MQTT /data: JSON-Pool zu klein (MQTT_JSON_POOL_BYTES) - kein Publish");
+			return;
+		}
+		n = serializeJson(json_doc, dataJsonBuffer, sizeof(dataJsonBuffer));
+		dataJsonCycles = ESP.getCycleCount() - startCycles;
+		dataJsonHeapBytes = (int32_t)(heapBefore - ESP.getFreeHeap());
+	}
+	if (n == 0 || n >= sizeof(dataJsonBuffer) - 1)
+	{
+		// Kann nur passieren, wenn kModbusDataJsonMax die Registertabellen falsch abschaetzt.
+		LOGF(LOG_LEVEL_ERROR, "MQTT /data: JSON abgeschnitten (%u von %u Bytes) - kein Publish", (unsigned)n, (unsigned)sizeof(dataJsonBuffer));
+		return;
 	}
-	free(buffer);
+	dataJsonBytes = n;
+	static char data_topic[80];
+	mqtt_client.publish(mqttTopic(data_topic, sizeof(data_topic), "data"), 0, true, dataJsonBuffer, n);
+#endif // DATA_JSON_LEGACY
+
+	if (!perRegister)
+	{
+		memcpy(sentValues, snap.values, sizeof(sentValues));
+	}
+	memcpy(sentFaultValue, snap.faultValue, sizeof(sentFaultValue));
+	memcpy(sentFaultValid, snap.faultValid, sizeof(sentFaultValid));
+	lastFullSnapshotMs = nowMs;
+	mqttResyncDone = resyncGen;
 }
 
 void onMqttMessage(char *topic, char *payload, AsyncMqttClientMessageProperties properties, size_t len, size_t index, size_t total)
@@ -265,11 +475,11 @@ void onMqttMessage(char *topic, char *payload, AsyncMqttClientMessageProperties
 			payload_s += payload[i];
 		}
 	}
-	log(LOG_LEVEL_INFO, "Message received (topic=" + String(topic) + ", qos=" + String(properties.qos) + ", dup=" + String(properties.dup) + ", retain=" + String(properties.retain) + ", len=" + String(len) + ", index=" + String(index) + ", total=" + String(total) + "): " + payload_s);
+	LOGF(LOG_LEVEL_INFO, "Message received (topic=%s, qos=%u, dup=%d, retain=%d, len=%u, index=%u, total=%u): %s", topic, properties.qos, properties.dup, properties.retain, (unsigned)len, (unsigned)index, (unsigned)total, payload_s.c_str());
 
 	String suffix = String(topic).substring(strlen(param_mqtt_topic) + strlen(HOSTNAME) + 9);
 	// substring(1 + strlen(MQTT_TOPIC) + strlen("/") + strlen(HOSTNAME) + strlen("/") + strlen("action"))
-	log(LOG_LEVEL_INFO, "MQTT topic suffix=" + String(suffix.c_str()));
+	LOGF(LOG_LEVEL_INFO, "MQTT topic suffix=%s", suffix.c_str());
 
 	if (suffix == "write_register")
 	{
@@ -286,12 +496,14 @@ void onMqttMessage(char *topic, char *payload, AsyncMqttClientMessageProperties
 		}
 		String register_name = payload_s.substring(0, eq);
 		String register_value = payload_s.substring(eq + 1);
-		log(LOG_LEVEL_INFO, "Writing register name=" + String(register_name) + " with value=" + String(register_value));
+		LOGF(LOG_LEVEL_INFO, "Writing register name=%s with value=%s", register_name.c_str(), register_value.c_str());
 
 		// NUR einreihen, NICHT hier ausfuehren: writeModbusRegister blockiert per Busy-Wait und liefe
 		// sonst im AsyncTCP-Callback -> TCP/MQTT haengt, Task-Watchdog (Crash 2026-06-16). Der
 		// Worker-Task fuehrt den Write aus, aktualisiert den Cache und stoesst den /data-Publish an
-		// (Sofort-Feedback ohne Bus-Read) — siehe serviceRequest()/consumeModbusPublishRequest().
+		// (Sofort-Feedback ohne Bus-Read) — siehe serviceWrites()/consumeModbusPublishRequest().
+		// Ein noch nicht gesendeter Wert desselben Registers wird ersetzt (Write-Coalescing), das
+		// Ergebnis inkl. ueberholter Werte kommt auf .../write_result (publishWriteResults).
 		if (!enqueueModbusWrite(register_name.c_str(), (uint16_t)register_value.toInt()))
 		{
 			log(LOG_LEVEL_ERROR, "Failed to enqueue write " + String(register_name) + "=" + String(register_value));
@@ -306,7 +518,38 @@ void onMqttMessage(char *topic, char *payload, AsyncMqttClientMessageProperties
 
 void onMqttPublish(uint16_t packetId)
 {
-	log(LOG_LEVEL_INFO, "Publish acknowledged for packetId: " + String(packetId));
+	LOGF(LOG_LEVEL_INFO, "Publish acknowledged for packetId: %u", packetId);
+}
+
+// Meldet die Ergebnisse ausgefuehrter Writes (nicht retained) auf .../write_result, je Register eins:
+//   {"name":"soll_temp","value":450,"ok":true,"batch":2,"superseded":[440,445],"superseded_count":2}
+// superseded = Werte, die durch einen juengeren Write desselben Registers nie gesendet wurden.
+void publishWriteResults()
+{
+	modbus_write_result_t res;
+	while (consumeModbusWriteResult(res))
+	{
+		if (!mqtt_client.connected())
+		{
+			continue; // verwerfen: Ergebnisse sind nur als Sofort-Rueckmeldung sinnvoll
+		}
+		JsonDocument json;
+		json["name"] = res.name;
+		json["value"] = res.value;
+		json["ok"] = res.ok;
+		json["batch"] = res.batch;
+		JsonArray superseded = json["superseded"].to<JsonArray>();
+		for (uint8_t k = 0; k < res.superseded && k < MODBUS_WRITE_SUPERSEDED_KEEP; ++k)
+		{
+			superseded.add(res.supersededValues[k]);
+		}
+		json["superseded_count"] = res.superseded;
+		char buffer[192];
+		size_t n = serializeJson(json, buffer, sizeof(buffer));
+		String mqtt_complete_topic = param_mqtt_topic;
+		mqtt_complete_topic += "/" + String(HOSTNAME) + "/write_result";
+		mqtt_client.publish(mqtt_complete_topic.c_str(), 0, false, buffer, n);
+	}
 }
 
 // Wird im Loop-Task aufgerufen, sobald der Worker neue Daten gemeldet hat (consumeModbusPublishRequest).
@@ -332,6 +575,9 @@ void setup()
 	// Modbus-Master ist (kein Buskonflikt mit dem Tuya-Modul). HIGH = WBR3D AUS.
 	pinMode(WBR3_EN_PIN, OUTPUT);
 	digitalWrite(WBR3_EN_PIN, HIGH);
+#ifdef ALLOC_BENCH
+	allocBenchRegister(ALLOC_SLOT_LOOP); // setup() laeuft bereits im Loop-Task
+#endif
 
 	// debug comm
 	Serial.begin(74880);
@@ -355,6 +601,7 @@ void setup()
 	log(LOG_LEVEL_INFO, "*********************************************************************");
 	log(LOG_LEVEL_INFO, "Firmware version " + String(FIRMWARE_VERSION) + " (compiled at " + __DATE__ + " " + __TIME__ + ")");
 	log(LOG_LEVEL_INFO, "Hostname: " + String(HOSTNAME));
+	initSyslog(param_syslog_host, (uint16_t)atoi(param_syslog_port), param_syslog_raw[0] == '1', HOSTNAME);
 
 	WiFi.onEvent(wiFiEvent);
 
@@ -397,7 +644,16 @@ void loop()
 	// Der Worker-Task signalisiert hierueber neue Daten; der Publish laeuft bewusst im Loop-Task.
 	if (consumeModbusPublishRequest())
 	{
+#ifdef ALLOC_BENCH
+		uint32_t allocsBefore = allocBenchCount(ALLOC_SLOT_LOOP);
+		publishModbusUpdate();
+		allocPublish = allocBenchCount(ALLOC_SLOT_LOOP) - allocsBefore;
+#else
 		publishModbusUpdate();
+#endif
 	}
+	publishWriteResults();
+	modbusHolesSaveIfDirty(); // gelernte Adresskarte sichern (Flash-I/O hier statt im Bus-Worker)
+	busGapSaveIfDirty();      // ebenso den gelernten Bus-Gap
 #endif // MODBUS_DISABLED
 }
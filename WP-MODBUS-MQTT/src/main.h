@@ -9,12 +9,22 @@
 // Kein Strapping-/Input-Only-Pin (siehe CLAUDE.md).
 #define WBR3_EN_PIN 21
 
+// /data geht nur noch bei einer Aenderung (ueber dem Totband der Register, siehe modbus_registers.h)
+// bzw. geaenderten Fehlern raus — ohne Aenderung spaetestens nach dieser Zeit als Vollbild.
+#define MQTT_FULL_SNAPSHOT_MS 300000
+// Statischer Speicher fuer die JsonDocuments des Publish-Pfads (json_pool.h). Reicht mit Reserve fuer
+// /data inkl. aller Fehler-Labels; Spitzenbelegung steht als jsonPoolHighWater im /status-JSON.
+#define MQTT_JSON_POOL_BYTES 4096
+
 #include <WiFi.h>
 
 #include <ArduinoJson.h>
 #include <AsyncMqttClient.h>
 #include <arduino-timer.h>
 #include "log.h"
+#include "log_syslog.h"
+#include "json_pool.h"
+#include "alloc_bench.h"
 #include "setupWebserver.h"
 #include "setupWifiManager.h"
 
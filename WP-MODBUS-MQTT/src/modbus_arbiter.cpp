@@ -0,0 +1,77 @@
+#include "modbus_arbiter.h"
+#include "modbus_base.h"
+#include <esp_timer.h>
+
+// Leitung belegt (Fremd-Frame laeuft): in diesen Schritten neu pruefen. rtuListen() sammelt dabei
+// die Zeichen ein, das Frame-Ende meldet der RX-Timeout ohnehin nach ~4 Zeichenzeiten.
+#define ARBITER_BUSY_POLL_US 5000
+
+// Nur vom Worker-Task benutzt (Frame-Handler laeuft in dessen rtuListen()); die Statuswerte liest der Loop-Task.
+static BusArbiter arbiter;
+static volatile uint32_t deferrals = 0;
+static volatile uint32_t lockedPeriodMs = 0;
+static bool wasLocked = false;
+
+void busArbiterOnFrame(int64_t start_us, int64_t end_us)
+{
+	arbiter.onForeignFrame(start_us, end_us);
+	bool isLocked = arbiter.locked(end_us);
+	lockedPeriodMs = isLocked ? (uint32_t)(arbiter.periodUs() / 1000) : 0;
+	if (isLocked != wasLocked)
+	{
+		wasLocked = isLocked;
+		if (isLocked)
+		{
+			LOGF(LOG_LEVEL_INFO, "Bus-Arbiter: Fremd-Master eingerastet, Periode %lu ms, Burst %lu ms", (unsigned long)lockedPeriodMs, (unsigned long)(arbiter.burstLenUs() / 1000));
+		}
+		else
+		{
+			LOGF(LOG_LEVEL_INFO, "Bus-Arbiter: Fremd-Master nicht mehr eingerastet");
+		}
+	}
+}
+
+void busArbiterWait(int64_t tx_us)
+{
+	int64_t begin = esp_timer_get_time();
+	bool deferred = false;
+	for (;;)
+	{
+		rtuListen(0); // Aufgelaufenes einarbeiten, bevor entschieden wird
+		int64_t now = esp_timer_get_time();
+		int64_t wait = rtuLineBusy() ? ARBITER_BUSY_POLL_US : arbiter.deferUs(now, tx_us);
+		if (wait <= 0)
+		{
+			break;
+		}
+		if (now - begin >= (int64_t)ARBITER_MAX_DEFER_MS * 1000)
+		{
+			LOGF(LOG_LEVEL_WARNING, "Bus-Arbiter: kein freies Fenster nach %d ms, sende trotzdem", ARBITER_MAX_DEFER_MS);
+			break;
+		}
+		deferred = true;
+		// Auf der UART-Event-Queue warten statt zu schlafen -> Fremd-Frames werden dabei mitgelernt.
+		rtuListen((uint32_t)(wait / 1000) + 1);
+	}
+	if (deferred)
+	{
+		deferrals++;
+	}
+	if (!arbiter.locked(esp_timer_get_time()))
+	{
+		lockedPeriodMs = 0;
+		wasLocked = false;
+	}
+}
+
+uint32_t busArbiterPeriodMs()
+{
+	return lockedPeriodMs;
+}
+
+uint32_t busArbiterDeferrals()
+{
+	uint32_t n = deferrals;
+	deferrals = 0;
+	return n;
+}
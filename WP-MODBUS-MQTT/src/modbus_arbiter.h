@@ -0,0 +1,242 @@
+#ifndef SRC_MODBUS_ARBITER_H_
+#define SRC_MODBUS_ARBITER_H_
+
+#include <stdint.h>
+
+// =========================================================================================
+// Listen-before-talk-Arbiter. Das Display pollt auch bei stillgelegtem WBR3 weiter ueber A/B (siehe
+// MODBUS_RETRIES_BUS_COLLISION); bisher fing nur das blinde Retry-Budget die Kollisionen ab, jede
+// kostete im Zweifel einen vollen MODBUS_TIMEOUT. Der Arbiter hoert den Fremdverkehr mit (rtuListen),
+// fasst Anfrage + Antwort des fremden Masters zu einem "Burst" zusammen und lernt aus den Burst-
+// Anfaengen dessen Periode und Phase (Phasenregelung wie eine PLL: Abweichung der Ist- von der
+// vorhergesagten Burst-Zeit korrigiert die Periode gedaempft). Eine eigene Transaktion startet nur,
+// wenn die Leitung still ist und sie vor dem naechsten vorhergesagten Burst fertig wird.
+//
+// Die Logik (BusArbiter) ist bewusst frei von Arduino/FreeRTOS: reine Zeitarithmetik auf us-
+// Zeitstempeln, damit sie sich auf dem Host gegen einen simulierten Fremd-Master pruefen laesst.
+// Die Anbindung an UART und Worker (busArbiterWait etc.) steckt in modbus_arbiter.cpp.
+// =========================================================================================
+
+// Frames mit weniger Abstand gehoeren zum selben Burst (Anfrage -> Slave-Antwort). Muss ueber der
+// Antwortlatenz des Slaves liegen, aber deutlich unter der Poll-Periode des Displays.
+#define ARBITER_BURST_GAP_US 150000
+// Toleranz fuer "passt zur gelernten Periode" (Prozent der Periode).
+#define ARBITER_PERIOD_TOL_PCT 10
+// So viele passende Intervalle in Folge, bevor die Vorhersage genutzt wird ("eingerastet").
+#define ARBITER_LOCK_CONFIDENCE 3
+// Nach so vielen unpassenden Intervallen in Folge wird die Periode neu geseedet (kuerzestes der Serie).
+#define ARBITER_RELOCK_MISSES 3
+// Sicherheitsabstand um das vorhergesagte Burst-Fenster (Zeitstempel-Unschaerfe). Dazu kommt der
+// gelernte Jitter: die groesste Abweichung der Bursts von der Vorhersage, langsam abklingend.
+#define ARBITER_GUARD_US 30000
+// Ohne Burst seit so vielen Perioden gilt der fremde Master als verstummt -> Vorhersage aus.
+#define ARBITER_STALE_PERIODS 4
+// Hoechstens so lange wird eine eigene Transaktion zurueckgestellt; danach wird trotzdem gesendet
+// (z.B. wenn die Periode des Displays kein ausreichend grosses Fenster laesst). Retry-Logik greift dann wie bisher.
+#define ARBITER_MAX_DEFER_MS 3000
+
+class BusArbiter
+{
+public:
+	// Ein vollstaendiges Fremd-Frame wurde gehoert (Beginn/Ende in us, monoton).
+	//
+	// Gelernt wird aus dem Burst-Anfang, sobald das zweite Frame (Slave-Antwort) da ist. Ein Burst mit
+	// nur einem Frame ist verdaechtig: meist ging die Anfrage in einer eigenen Transaktion unter und
+	// gehoert wurde nur die Antwort, der Anfang liegt dann um Anfrage + Slave-Latenz zu spaet. Solche
+	// Bursts werden uebergangen (k in learnInterval faengt die Luecke ab). Nur wenn der fremde Master
+	// gar keine Antworten bekommt (kein Burst mit zwei Frames seit ARBITER_STALE_PERIODS Bursts), wird
+	// aus Ein-Frame-Bursts gelernt, dann beim Beginn des naechsten Bursts.
+	void onForeignFrame(int64_t start_us, int64_t end_us)
+	{
+		if (burstEndUs_ >= 0 && start_us - burstEndUs_ < ARBITER_BURST_GAP_US)
+		{
+			burstEndUs_ = end_us; // Antwort zur Anfrage bzw. Folge-Frame desselben Bursts
+			int64_t len = end_us - burstStartUs_;
+			if (len > burstLenUs_)
+			{
+				burstLenUs_ = len;
+			}
+			if (burstFrames_ < 2 && ++burstFrames_ == 2)
+			{
+				singleBursts_ = 0;
+				learnBurst(burstStartUs_);
+			}
+			return;
+		}
+		if (burstStartUs_ >= 0)
+		{
+			if (burstFrames_ == 1)
+			{
+				if (singleBursts_ < ARBITER_STALE_PERIODS)
+				{
+					singleBursts_++;
+				}
+				else
+				{
+					learnBurst(burstStartUs_);
+				}
+			}
+			// Burst-Laenge: Maximum, langsam abklingend (eine einmalig lange Antwort soll nicht ewig gelten).
+			burstLenUs_ -= burstLenUs_ / 16;
+		}
+		burstStartUs_ = start_us;
+		burstEndUs_ = end_us;
+		burstFrames_ = 1;
+		if (end_us - start_us > burstLenUs_)
+		{
+			burstLenUs_ = end_us - start_us;
+		}
+	}
+
+	// Eingerastet nur, solange der letzte Burst zur Vorhersage passte: ein Ausreisser (z.B. Display
+	// hat den Takt gewechselt) schaltet die Vorhersage sofort ab, nicht erst nach mehreren Halbierungen.
+	bool locked(int64_t now_us) const
+	{
+		return confidence_ >= ARBITER_LOCK_CONFIDENCE && misses_ == 0 && periodUs_ > 0 &&
+			   now_us - phaseUs_ < ARBITER_STALE_PERIODS * periodUs_;
+	}
+
+	// Wie lange (us) eine Transaktion der Dauer tx_us noch warten muss; 0 = jetzt senden.
+	int64_t deferUs(int64_t now_us, int64_t tx_us) const
+	{
+		// Laufender Burst: nach einem Fremd-Frame erst die Slave-Antwort bzw. das Burst-Ende abwarten.
+		if (burstEndUs_ >= 0 && now_us - burstEndUs_ < ARBITER_BURST_GAP_US)
+		{
+			return burstEndUs_ + ARBITER_BURST_GAP_US - now_us;
+		}
+		if (!locked(now_us))
+		{
+			return 0; // keine Vorhersage -> nur die Leitung muss frei sein (prueft der Aufrufer)
+		}
+		// Naechster vorhergesagter Burst, dessen Fenster (inkl. Guard) noch nicht vorbei ist.
+		int64_t guard = ARBITER_GUARD_US + jitterUs_;
+		int64_t windowLen = burstLenUs_ + ARBITER_BURST_GAP_US + guard;
+		int64_t k = (now_us - phaseUs_ + guard) / periodUs_;
+		int64_t next = phaseUs_ + k * periodUs_;
+		if (next + windowLen <= now_us)
+		{
+			next += periodUs_;
+		}
+		int64_t windowStart = next - guard;
+		int64_t windowEnd = next + windowLen;
+		if (now_us + tx_us <= windowStart || now_us >= windowEnd)
+		{
+			return 0; // passt noch vor den naechsten Burst bzw. liegt schon dahinter
+		}
+		return windowEnd - now_us;
+	}
+
+	int64_t periodUs() const { return periodUs_; }
+	int64_t burstLenUs() const { return burstLenUs_; }
+	int64_t jitterUs() const { return jitterUs_; }
+
+private:
+	// Periode aus den Intervallen zwischen gelernten Bursts. k = Zahl der Perioden im Intervall: nur
+	// k = 1 zaehlt als Treffer, verpasste Bursts (z.B. waehrend einer eigenen Transaktion) zaehlen so
+	// aber auch nicht als Fehler.
+	void learnInterval(int64_t iv)
+	{
+		if (iv <= 0)
+		{
+			return;
+		}
+		if (periodUs_ == 0)
+		{
+			periodUs_ = iv;
+			return;
+		}
+		int64_t k = (iv + periodUs_ / 2) / periodUs_;
+		int64_t err = k > 0 ? iv - k * periodUs_ : iv;
+		int64_t tol = periodUs_ * ARBITER_PERIOD_TOL_PCT / 100;
+		int64_t guard = ARBITER_GUARD_US + jitterUs_;
+		if (k > 1 && err <= guard && err >= -guard)
+		{
+			// Ueber mehrere Perioden ist das Intervall mehrdeutig (z.B. 3 x 700 ms ~ 2 x 1 s nach einem
+			// Taktwechsel) -> kein Treffer; passt es nicht einmal ins Vorhersagefenster, ein Fehler.
+			return;
+		}
+		if (k == 1 && err <= tol && err >= -tol)
+		{
+			periodUs_ += err / 4; // gedaempft (1/4), damit Jitter die Periode nicht verreisst
+			// Jitter wie die Burst-Laenge: Maximum, langsam abklingend; weitet den Guard.
+			int64_t absErr = err < 0 ? -err : err;
+			jitterUs_ -= jitterUs_ / 16;
+			if (absErr > jitterUs_)
+			{
+				jitterUs_ = absErr;
+			}
+			if (confidence_ < 255)
+			{
+				confidence_++;
+			}
+			misses_ = 0;
+			return;
+		}
+		confidence_ /= 2;
+		// Kuerzestes Intervall der Fehlerserie: die anderen koennen verpasste Bursts enthalten, ein
+		// Seed darauf rastete auf ein Vielfaches der Periode ein.
+		if (misses_ == 0 || iv < missMinIv_)
+		{
+			missMinIv_ = iv;
+		}
+		if (++misses_ >= ARBITER_RELOCK_MISSES)
+		{
+			periodUs_ = missMinIv_; // Display hat seinen Takt geaendert -> neu einrasten
+			jitterUs_ = 0;
+			confidence_ = 0;
+			misses_ = 0;
+		}
+	}
+
+	void learnBurst(int64_t start_us)
+	{
+		if (anchorUs_ >= 0)
+		{
+			learnInterval(start_us - anchorUs_);
+		}
+		anchorUs_ = start_us;
+		trackPhase(start_us);
+	}
+
+	// Phase der Vorhersage: folgt dem Burst-Anfang nur zur Haelfte, solange die Periode passt. So
+	// verschiebt ein einzelner Ausreisser die Vorhersage nicht voll, z.B. wenn die Anfrage des Displays
+	// in einer Kollision unterging und der Burst erst mit der Slave-Antwort beginnt.
+	void trackPhase(int64_t start_us)
+	{
+		if (periodUs_ == 0 || confidence_ == 0 || misses_ != 0)
+		{
+			phaseUs_ = start_us;
+			return;
+		}
+		int64_t k = (start_us - phaseUs_ + periodUs_ / 2) / periodUs_;
+		int64_t err = start_us - (phaseUs_ + k * periodUs_);
+		phaseUs_ += k * periodUs_ + err / 2;
+	}
+
+	int64_t burstStartUs_ = -1;
+	int64_t burstEndUs_ = -1;
+	int64_t burstLenUs_ = 0;
+	uint8_t burstFrames_ = 0;
+	uint8_t singleBursts_ = 0; // Ein-Frame-Bursts in Folge, bis ARBITER_STALE_PERIODS
+	int64_t anchorUs_ = -1;	   // Anfang des zuletzt gelernten Bursts (Bezug der Intervalle)
+	int64_t phaseUs_ = 0;	   // gefilterter Anfang des letzten Bursts (Bezug der Vorhersage)
+	int64_t periodUs_ = 0;
+	int64_t jitterUs_ = 0;
+	uint8_t confidence_ = 0;
+	uint8_t misses_ = 0;
+	int64_t missMinIv_ = 0; // kuerzestes Intervall der laufenden Fehlerserie
+};
+
+// --- Anbindung (modbus_arbiter.cpp) -----------------------------------------------------
+// Ein mitgehoertes Fremd-Frame (aus dem Frame-Handler in modbus_base.cpp, siehe rtuSetForeignFrameHandler).
+void busArbiterOnFrame(int64_t start_us, int64_t end_us);
+// Vor jeder eigenen Transaktion (nach busGapWait): hoert mit, bis die Leitung frei ist und die
+// Transaktion (Dauer tx_us, siehe rtuTransactionUs) vor dem naechsten vorhergesagten Burst fertig wird.
+// Hoechstens ARBITER_MAX_DEFER_MS.
+void busArbiterWait(int64_t tx_us);
+// Fuer das /status-JSON: gelernte Periode des fremden Masters in ms (0 = nicht eingerastet) und
+// Zahl der zurueckgestellten Transaktionen seit dem letzten Aufruf (setzt zurueck).
+uint32_t busArbiterPeriodMs();
+uint32_t busArbiterDeferrals();
+
+#endif // SRC_MODBUS_ARBITER_H_
@@ -1,73 +1,119 @@
 #include "modbus_base.h"
 #include "modbus_faults.h"
+#include "modbus_poll_plan.h"
+#include "modbus_discovery.h"
+#include "modbus_scope.h"
+#include "alloc_bench.h"
 #include <esp_task_wdt.h>
+#include <atomic>
 
 // In main.cpp definiert: true, solange die Hersteller-App den Bus besitzt (WBR3D an). Der Worker
 // fasst dann den Bus NICHT an. Hier extern deklariert statt main.h einzubinden (vermeidet Zyklus).
 bool isAppControlMode();
 
-// instantiate ModbusMaster object
-ModbusMaster modbus_client;
+// Arbeitsstand des Workers: nur der Worker-Task liest/schreibt ihn (distributeBlock/-FaultBlock,
+// Write-Cacheupdate, Sniffer) -> kein Lock noetig. Leser sehen ihn ausschliesslich ueber den
+// Snapshot (commitRegisterSnapshot/readRegisterSnapshot), nie direkt.
+static uint16_t register_values[MODBUS_NUM_REGISTERS];
+// Stand beim letzten Publish-Anstoss (requestPublish): Referenz fuer das Totband, damit langsames
+// Driften sich aufsummiert und irgendwann publiziert wird, Flattern um einen Wert aber nicht.
+static uint16_t publishedValues[MODBUS_NUM_REGISTERS];
+int num_registers = MODBUS_NUM_REGISTERS;
 
-uint16_t *register_values; // array to hold the register values
-int num_registers = sizeof(registers) / sizeof(modbus_register_t);
-int currentRangeIndex = 0;
-int currentTryIndex = 0;
-
-void checkPollRangeCoverage(); // Definition weiter unten (bei den Poll-Ranges)
+static void logPollPlan();		// Definition weiter unten (bei den Poll-Ranges)
+static void replanPoll();		// ebenda
+static void initPollSchedule(); // Definition weiter unten (Deadline-Scheduler)
+static void onForeignFrame(const uint8_t *frame, size_t len, int64_t start_us, int64_t end_us); // Sniffer-Abschnitt
+static void onSniffedBlock(uint16_t start, uint16_t count, const uint16_t *values);
+static void requestPublish(); // Worker-Abschnitt
 
 String modbusResultMsg;
-uint8_t lastModbusResult = ModbusMaster::ku8MBSuccess;
+uint8_t lastModbusResult = MB_RESULT_SUCCESS;
 
 // Cache der Fehlerregister-Rohwerte, vom Poller mitgefuellt (siehe distributeFaultBlock).
 // Index parallel zu faultRegisters[]. valid=false, bis der zugehoerige Block einmal ok gelesen wurde
 // bzw. nach einem fehlgeschlagenen Read -> writeFaultStatusToJson() ueberspringt solche Eintraege.
-static const int num_fault_regs = sizeof(faultRegisters) / sizeof(fault_register_t);
+static const int num_fault_regs = MODBUS_NUM_FAULT_REGS;
 static uint16_t faultRegValue[num_fault_regs];
 static bool faultRegValid[num_fault_regs];
+// Alter der zuletzt mitgehoerten Werte: millis() des letzten Sniffs je Register, 0 = nie gesnifft.
+static uint32_t registerSniffedMs[MODBUS_NUM_REGISTERS];
 
 bool modbus_poller_task_running = false;
 
-// Schuetzt register_values[] + Fault-Cache. Geschrieben wird ausschliesslich vom Worker-Task
-// (distributeBlock/distributeFaultBlock/writeModbusRegister-Cacheupdate); gelesen wird beim
-// JSON-Bauen aus dem Loop-Task (publishModbusData). Nur kurze Halte -> nie waehrend der Bus-I/O.
-static SemaphoreHandle_t registerCacheMutex = nullptr;
+// --- Register-Snapshot (Seqlock, doppelt gepuffert) --------------------------------------
+// Frueher schuetzte ein Mutex register_values[] + Fault-Cache: publishModbusData wartete bis 200 ms
+// darauf und liess den Publish bei Timeout ausfallen, der Worker wartete je Range bis 100 ms. Zudem
+// mischte das JSON Ranges verschiedener Zyklen, weil jeder Range einzeln in den Cache ging.
+// Jetzt: der Worker arbeitet auf seinem privaten Stand und committet ihn an definierten Punkten
+// (Zyklus-Ende, bestaetigter Write, Sniff) in den HINTEREN von zwei Puffern, dann wird umgeschaltet.
+// Je Puffer ein Sequenzzaehler (ungerade = im Bau). Leser kopieren den vorderen Puffer und pruefen
+// danach den Zaehler; hat er sich geaendert, wird neu gelesen. Kein Teilnehmer wartet je auf den
+// anderen: der Worker schreibt nie in den vorderen Puffer, ein Leser muss hoechstens wiederholen,
+// wenn waehrend seiner Kopie ZWEI Commits liefen (dann zeigt front beim Neuversuch auf einen stabilen
+// Puffer — auch auf demselben Core kein Livelock).
+static register_snapshot_t snapshotBuf[2];
+static std::atomic<uint32_t> snapshotSeq[2];
+static std::atomic<uint8_t> snapshotFront{0};
+static uint32_t snapshotGeneration = 0; // nur Worker
 
-bool lockRegisterCache(uint32_t timeout_ms)
+static void commitRegisterSnapshot()
 {
-	return registerCacheMutex != nullptr &&
-		   xSemaphoreTake(registerCacheMutex, pdMS_TO_TICKS(timeout_ms)) == pdTRUE;
+	uint8_t back = snapshotFront.load(std::memory_order_relaxed) ^ 1;
+	register_snapshot_t &b = snapshotBuf[back];
+	uint32_t seq = snapshotSeq[back].load(std::memory_order_relaxed);
+	snapshotSeq[back].store(seq + 1, std::memory_order_relaxed);
+	std::atomic_thread_fence(std::memory_order_release);
+	b.generation = ++snapshotGeneration;
+	memcpy(b.values, register_values, sizeof(b.values));
+	memcpy(b.faultValue, faultRegValue, sizeof(b.faultValue));
+	memcpy(b.faultValid, faultRegValid, sizeof(b.faultValid));
+	memcpy(b.sniffedMs, registerSniffedMs, sizeof(b.sniffedMs));
+	snapshotSeq[back].store(seq + 2, std::memory_order_release);
+	snapshotFront.store(back, std::memory_order_release);
 }
 
-void unlockRegisterCache()
+bool readRegisterSnapshot(register_snapshot_t &out)
 {
-	if (registerCacheMutex != nullptr)
+	for (;;)
 	{
-		xSemaphoreGive(registerCacheMutex);
+		uint8_t front = snapshotFront.load(std::memory_order_acquire);
+		uint32_t seq = snapshotSeq[front].load(std::memory_order_acquire);
+		if (seq & 1)
+		{
+			continue; // veralteter front-Index, Puffer gerade im Bau -> neu lesen
+		}
+		memcpy(&out, &snapshotBuf[front], sizeof(out));
+		std::atomic_thread_fence(std::memory_order_acquire);
+		if (snapshotSeq[front].load(std::memory_order_relaxed) == seq)
+		{
+			return out.generation != 0;
+		}
 	}
 }
 
 // True für Fehler, die durch Buskollisionen mit dem Tuya-Master entstehen (verstümmelte/fremde Frames).
 // Diese werden weggeworfen und sofort erneut versucht — der Slave selbst hat das Frame nie gesehen.
+// Ebenso Acknowledge/Busy (Exception 05/06): der Slave ist gerade beschaeftigt, spaeter klappt es.
 bool isTransientModbusError(uint8_t result)
 {
-	return result == ModbusMaster::ku8MBInvalidSlaveID
-		|| result == ModbusMaster::ku8MBInvalidCRC
-		|| result == ModbusMaster::ku8MBResponseTimedOut
-		|| result == ModbusMaster::ku8MBInvalidFunction;
+	return result == MB_RESULT_INVALID_SLAVE_ID
+		|| result == MB_RESULT_INVALID_CRC
+		|| result == MB_RESULT_RESPONSE_TIMED_OUT
+		|| result == MB_RESULT_INVALID_FUNCTION
+		|| result == MB_RESULT_ACKNOWLEDGE
+		|| result == MB_RESULT_SLAVE_DEVICE_BUSY;
 }
 
-// Der ESP32 hat 3 Hardware-UARTs; UART2 dient der Modbus-Kommunikation (UART0 = Debug/Serial).
-HardwareSerial modbusSerial(2); // Use UART2
-
-#if MODBUS_BAUDRATE > 19200
-    uint32_t t3_5 = 1750;
-#else
-    uint32_t t3_5 = (1000000 * 39) / MODBUS_BAUDRATE + 500; // +500us : to be safe
-#endif
-
-
+// Vor jeder eigenen Transaktion: Restluecke seit der letzten Transaktion (Slave-Erholzeit, Bus-Gap),
+// dann Listen-before-talk (Leitung frei und Transaktion passt vor den naechsten Display-Burst).
+static void awaitBusSlot(size_t req_len, size_t resp_len)
+{
+	busGapWait();
+	busArbiterWait(rtuTransactionUs(req_len, resp_len));
+}
 
+// Richtungssteuerung, vom RTU-Transport (modbus_rtu.cpp) um jedes gesendete Frame gerufen.
 void preTransmission()
 {
 	if (RTS != NOT_A_PIN)
@@ -84,70 +130,69 @@ void postTransmission()
 	}
 }
 
-// Idle-Callback der Modbus-Lib: wird waehrend des Wartens auf eine Antwort aufgerufen,
-// solange keine Bytes anliegen. Ohne diesen Callback busy-wartet readHoldingRegisters()
-// bis zu ku16MBResponseTimeout (2 s) OHNE yield -> bei mehreren Retams am Stueck (Block-Read
-// unter Tuya-Buskollision) summieren sich die Wartezeiten > 5 s -> Task-Watchdog-Reset.
-// delay(1) == vTaskDelay(1 Tick): laesst die niederpriore IDLE-Task laufen, die den
-// Task-Watchdog zuruecksetzt. Greift waehrend echter Datenstroeme nicht (dann ist
-// _serial->available() true), bremst die normale Kommunikation also nicht.
-static void modbusIdle()
-{
-	delay(1);
-}
-
 void initModbus()
 {
 
-	register_values = new uint16_t[num_registers];
-	modbusSerial.begin(MODBUS_BAUDRATE); // Using ESP32 UART2 for Modbus
-	modbusSerial.setPins(RXD, TXD);
-	modbus_client.begin(MODBUS_UNIT, modbusSerial);
-	// do we have a flow control pin?
-	if (RTS != NOT_A_PIN)
+	// 0xFFFF = "noch nicht gelesen" -> writeRegisterValuesToJson() laesst den Eintrag weg. Noetig, seit
+	// der Scheduler schon nach dem ersten Range publiziert, bevor alle Ranges einmal gelesen sind.
+	for (int i = 0; i < num_registers; ++i)
 	{
-		// Init in receive mode
-		pinMode(RTS, OUTPUT);
-		digitalWrite(RTS, 0);
+		register_values[i] = 0xFFFF;
+		publishedValues[i] = 0xFFFF;
 	}
-	modbus_client.preTransmission(preTransmission);
-	modbus_client.postTransmission(postTransmission);
-	modbus_client.idle(modbusIdle); // waehrend des Wartens an Scheduler abgeben (WDT-Schutz)
-	checkPollRangeCoverage();		// warnt, falls ein Register von keinem pollRange abgedeckt ist
+	commitRegisterSnapshot(); // Generation 1: alles ungueltig, bis der erste Zyklus committet
+	// UART-Treiber + Event-Queue (RX-Timeout = Frame-Ende) statt HardwareSerial/ModbusMaster. Der
+	// Worker blockiert waehrend des Wartens auf die Antwort in xQueueReceive -> kein idle-Callback
+	// mehr noetig, die IDLE-Task (Watchdog) laeuft von selbst.
+	rtuInit();
+	// Fremd-Frames (Display/Tuya) mithoeren: Periode/Phase fuer den Arbiter, Werte fuer den Sniffer.
+	rtuSetForeignFrameHandler(onForeignFrame);
+	snifferSetHandler(onSniffedBlock);
+	busGapInit(); // gelernten Inter-Transaktions-Abstand laden (LittleFS ist seit initFileLog gemountet)
+	modbusHolesInit(); // gelernte Adresskarte (Dump) laden ...
+	replanPoll();	   // ... und die Poll-Ranges um deren Loecher herum planen
+	logPollPlan(); // Abdeckung ist per static_assert garantiert, hier nur zur Diagnose
+	initPollSchedule();
 }
 
-bool getModbusResultMsg(ModbusMaster *node, uint8_t result)
+bool getModbusResultMsg(uint8_t result)
 {
 	lastModbusResult = result;
 	String tmpstr2 = "";
 	switch (result)
 	{
-	case node->ku8MBSuccess:
+	case MB_RESULT_SUCCESS:
 		modbusResultMsg = tmpstr2;
 		return true;
 		break;
-	case node->ku8MBIllegalFunction:
+	case MB_RESULT_ILLEGAL_FUNCTION:
 		tmpstr2 += "Illegal Function";
 		break;
-	case node->ku8MBIllegalDataAddress:
+	case MB_RESULT_ILLEGAL_DATA_ADDRESS:
 		tmpstr2 += "Illegal Data Address";
 		break;
-	case node->ku8MBIllegalDataValue:
+	case MB_RESULT_ILLEGAL_DATA_VALUE:
 		tmpstr2 += "Illegal Data Value";
 		break;
-	case node->ku8MBSlaveDeviceFailure:
+	case MB_RESULT_SLAVE_DEVICE_FAILURE:
 		tmpstr2 += "Slave Device Failure";
 		break;
-	case node->ku8MBInvalidSlaveID:
+	case MB_RESULT_ACKNOWLEDGE:
+		tmpstr2 += "Acknowledge";
+		break;
+	case MB_RESULT_SLAVE_DEVICE_BUSY:
+		tmpstr2 += "Slave Device Busy";
+		break;
+	case MB_RESULT_INVALID_SLAVE_ID:
 		tmpstr2 += "Invalid Slave ID";
 		break;
-	case node->ku8MBInvalidFunction:
+	case MB_RESULT_INVALID_FUNCTION:
 		tmpstr2 += "Invalid Function";
 		break;
-	case node->ku8MBResponseTimedOut:
+	case MB_RESULT_RESPONSE_TIMED_OUT:
 		tmpstr2 += "Response Timed Out";
 		break;
-	case node->ku8MBInvalidCRC:
+	case MB_RESULT_INVALID_CRC:
 		tmpstr2 += "Invalid CRC";
 		break;
 	default:
@@ -164,90 +209,120 @@ String getModbusState()
 	return modbusResultMsg;
 }
 
-bool writeModbusRegister(const char *register_name, uint16_t value)
+static int findRegisterIndex(const char *register_name)
 {
-	log(LOG_LEVEL_WARNING, "Writing data");
-	delayMicroseconds(t3_5); // inter-frame delay for Modbus RTU
-	uint16_t register_id = -1;
-	int register_index = -1;
-	for (uint8_t i = 0; i < sizeof(registers) / sizeof(modbus_register_t); ++i)
+	for (int i = 0; i < num_registers; ++i)
 	{
 		if (strcmp(registers[i].name, register_name) == 0)
 		{
-			register_id = registers[i].id;
-			register_index = i;
+			return i;
 		}
 	}
-	if (register_id == -1)
+	return -1;
+}
+
+// FC16 wird beim ersten ILLEGAL_FUNCTION abgeschaltet (Slave kann es nicht) -> ab dann Einzel-Writes.
+static bool fc16Unsupported = false;
+
+// Schreibt die zusammenhaengenden Register [start .. start+count-1] in EINER Transaktion (count == 1:
+// FC06, sonst FC16) und uebernimmt die bestaetigten Rohwerte in den Worker-Stand.
+static bool writeRegisterRun(uint16_t start, uint16_t count, const uint16_t *values)
+{
+	if (count > 1 && fc16Unsupported)
 	{
-		log(LOG_LEVEL_ERROR, "Register name '" + String(register_name) + "' not found");
-		return true;
+		bool all_ok = true;
+		for (uint16_t i = 0; i < count; ++i)
+		{
+			all_ok &= writeRegisterRun(start + i, 1, values + i);
+		}
+		return all_ok;
 	}
-	// Inter-Transaktions-Abstand erzwingen (siehe Poll-Tick 500 ms): ein per MQTT injizierter Write
-	// kann direkt nach einer Poll-Transaktion kommen -> dieser Slave verschluckt die zu dicht folgende
-	// Transaktion und der 1. Versuch lief sonst in den ~2 s-Timeout. delay() yieldet (vTaskDelay),
-	// blockiert die CPU nicht.
-	delay(MODBUS_TX_SPACING_MS);
+	log(LOG_LEVEL_WARNING, "Writing data");
 	// Write tolerieren Buskollisionen: bei transienten Fehlern bis MODBUS_WRITE_RETRIES_BUS_COLLISION+1
 	// Versuche. Echte Slave-Fehler werden weiterhin nach MODBUS_RETRIES+1 Versuchen aufgegeben.
 	// WICHTIG: niedriges Budget (nicht das hohe Read-Budget), weil diese Schleife in EINEM Aufruf
-	// laeuft und jeder writeSingleRegister ~1 Timeout per Busy-Wait blockiert -> sonst summiert sich
-	// das zu einer langen CPU-Blockade und der Task-Watchdog resettet den ESP (Crash 2026-06-16).
+	// laeuft und jeder Versuch bis ~1 Timeout dauert (frueher per Busy-Wait der ModbusMaster-Lib,
+	// Crash 2026-06-16 durch Task-Watchdog-Reset). Der RTU-Transport blockiert inzwischen auf der
+	// UART-Event-Queue, die Gesamtdauer bleibt aber auch so begrenzt.
 	uint16_t max_attempts = MODBUS_WRITE_RETRIES_BUS_COLLISION + 1;
 	for (uint16_t i = 1; i <= max_attempts; ++i)
 	{
-		log(LOG_LEVEL_INFO, "Trial " + String(i) + "/" + String(max_attempts));
-		uint8_t result = modbus_client.writeSingleRegister(register_id, value);
-		if (getModbusResultMsg(&modbus_client, result))
+		LOGF(LOG_LEVEL_INFO, "Trial %d/%d", i, max_attempts);
+		// Inter-Transaktions-Abstand: ein per MQTT injizierter Write kann direkt nach einer Poll-
+		// Transaktion kommen -> nur die noch fehlende Luecke abwarten (blockiert die CPU nicht), dann
+		// ein Ruhefenster des Displays.
+		uint8_t result;
+		if (count == 1)
+		{
+			awaitBusSlot(6, 6);
+			result = rtuWriteSingleRegister(start, values[0]);
+		}
+		else
 		{
-			log(LOG_LEVEL_WARNING, "Data written: " + String(value) + ", Register ID: " + String(register_id));
-			// Cache mit dem (vom Slave bestaetigten) Rohwert aktualisieren, damit ein sofortiger
+			awaitBusSlot(7 + 2 * count, 6);
+			result = rtuWriteMultipleRegisters(start, count, values);
+			if (result == MB_RESULT_ILLEGAL_FUNCTION)
+			{
+				busGapReport(result, i == 1);
+				log(LOG_LEVEL_WARNING, "Slave unterstuetzt FC16 nicht -> Writes ab jetzt einzeln");
+				fc16Unsupported = true;
+				return writeRegisterRun(start, count, values);
+			}
+		}
+		busGapReport(result, i == 1);
+		if (getModbusResultMsg(result))
+		{
+			LOGF(LOG_LEVEL_WARNING, "Data written: %u register(s) from ID %u, first value %u", count, start, values[0]);
+			// Cache mit den (vom Slave bestaetigten) Rohwerten aktualisieren, damit ein sofortiger
 			// /data-Publish den neuen Wert zeigt, OHNE den Bus erneut lesen zu muessen. Skalierung/
 			// Dekodierung passiert erst beim JSON-Bauen (writeRegisterValuesToJson), daher Rohwert.
-			if (register_index >= 0)
+			for (int r = 0; r < num_registers; ++r)
 			{
-				if (lockRegisterCache(100))
+				if (registers[r].id >= start && registers[r].id < start + count)
 				{
-					register_values[register_index] = value;
-					unlockRegisterCache();
+					register_values[r] = values[registers[r].id - start]; // Commit via requestPublish()
 				}
 			}
 			return true;
 		}
 		if (!isTransientModbusError(result) && i > MODBUS_RETRIES)
 		{
-			log(LOG_LEVEL_ERROR, "Permanent Modbus error (0x" + String(result, HEX) + "), giving up.");
+			LOGF(LOG_LEVEL_ERROR, "Permanent Modbus error (0x%x), giving up.", result);
 			return false;
 		}
-		// Vor dem naechsten Versuch yielden: writeSingleRegister blockiert per Busy-Wait ohne zu
-		// yielden, viele Versuche am Stueck liessen die IDLE-Task verhungern -> Watchdog-Reset.
-		// delay() ist vTaskDelay -> die IDLE-Task kommt dran und fuettert den Watchdog; der
-		// Abstand gibt dem Slave zugleich Zeit (wie der Inter-Transaktions-Abstand oben).
-		// esp_task_wdt_reset() fuettert den WDT zusaetzlich direkt, falls die aktuelle Task
-		// registriert ist (no-op sonst, z.B. im AsyncTCP-/MQTT-Callback-Kontext).
-		if (i < max_attempts)
-		{
-			esp_task_wdt_reset();
-			delay(MODBUS_TX_SPACING_MS);
-		}
+		// Den Abstand vor dem naechsten Versuch haelt awaitBusSlot() (blockiert -> die IDLE-Task kommt
+		// dran und fuettert den Watchdog). esp_task_wdt_reset() fuettert den WDT zusaetzlich direkt,
+		// falls die aktuelle Task registriert ist (no-op sonst, z.B. im AsyncTCP-/MQTT-Callback-Kontext).
+		esp_task_wdt_reset();
 	}
-	log(LOG_LEVEL_ERROR, "Time out after " + String(max_attempts) + " attempts");
+	LOGF(LOG_LEVEL_ERROR, "Time out after %d attempts", max_attempts);
 	return false;
 }
 
+bool writeModbusRegister(const char *register_name, uint16_t value)
+{
+	int register_index = findRegisterIndex(register_name);
+	if (register_index < 0)
+	{
+		log(LOG_LEVEL_ERROR, "Register name '" + String(register_name) + "' not found");
+		return true;
+	}
+	return writeRegisterRun(registers[register_index].id, 1, &value);
+}
+
 bool getModbusValue(uint16_t register_id, modbus_entity_t modbus_entity, uint16_t *value_ptr)
 {
-	log(LOG_LEVEL_INFO, "Requesting data");
-	delayMicroseconds(t3_5); // inter-frame delay for Modbus RTU
+	LOGF(LOG_LEVEL_INFO, "Requesting data");
 	switch (modbus_entity)
 	{
 	case MODBUS_TYPE_HOLDING:
 		uint8_t result;
-		result = modbus_client.readHoldingRegisters(register_id, 1);
-		if (getModbusResultMsg(&modbus_client, result))
+		awaitBusSlot(6, 3 + 2);
+		result = rtuReadHoldingRegisters(register_id, 1, value_ptr);
+		busGapReport(result, true);
+		if (getModbusResultMsg(result))
 		{
-			*value_ptr = modbus_client.getResponseBuffer(0);
-			log(LOG_LEVEL_INFO, "Data read: " + String(*value_ptr));
+			LOGF(LOG_LEVEL_INFO, "Data read: %u", *value_ptr);
 			return true;
 		}
 		break;
@@ -263,72 +338,13 @@ bool getModbusValue(uint16_t register_id, modbus_entity_t modbus_entity, uint16_
 // EINER Transaktion nach values[]. Genau eine Transaktion pro Aufruf — der Retry erfolgt
 // aufrufseitig ueber mehrere Poller-Ticks (wie beim Einzel-Read), damit der Loop pro Tick
 // hoechstens ~ein Modbus-Timeout blockiert und Webserver/MQTT responsiv bleiben.
-// count muss <= ku8MaxBufferSize (64) sein.
-bool getModbusBlock(uint16_t start_id, uint16_t count, uint16_t *values)
+// count muss <= RTU_MAX_READ_REGS (64) sein. first_try speist das Lernen des Bus-Gaps.
+bool getModbusBlock(uint16_t start_id, uint16_t count, uint16_t *values, bool first_try)
 {
-	delayMicroseconds(t3_5); // inter-frame delay for Modbus RTU
-	uint8_t result = modbus_client.readHoldingRegisters(start_id, count);
-	if (getModbusResultMsg(&modbus_client, result))
-	{
-		for (uint16_t i = 0; i < count; ++i)
-		{
-			values[i] = modbus_client.getResponseBuffer(i);
-		}
-		return true;
-	}
-	return false;
-}
-
-// Liest die Holding-Register [start_id .. start_id+count-1] block-weise in values[] und
-// vermerkt pro Register in valid[], ob der Wert gueltig ist. Gedacht fuer den Webserver-Dump.
-// Block-Reads (bis MODBUS_DUMP_CHUNK Register je Transaktion) statt Einzel-Reads → weniger
-// Kollisionsfenster mit dem Tuya-Master und beschraenkte Worst-Case-Dauer.
-// Rueckgabe: true, wenn alle Chunks erfolgreich gelesen wurden.
-bool readHoldingRange(uint16_t start_id, uint16_t count, uint16_t *values, bool *valid)
-{
-	bool all_ok = true;
-	uint16_t done = 0;
-	while (done < count)
-	{
-		uint16_t chunk = count - done;
-		if (chunk > MODBUS_DUMP_CHUNK)
-		{
-			chunk = MODBUS_DUMP_CHUNK;
-		}
-		bool chunk_ok = false;
-		for (uint8_t attempt = 0; attempt <= MODBUS_DUMP_RETRIES && !chunk_ok; ++attempt)
-		{
-			delayMicroseconds(t3_5); // inter-frame delay for Modbus RTU
-			uint8_t result = modbus_client.readHoldingRegisters(start_id + done, chunk);
-			if (getModbusResultMsg(&modbus_client, result))
-			{
-				for (uint16_t i = 0; i < chunk; ++i)
-				{
-					values[done + i] = modbus_client.getResponseBuffer(i);
-					valid[done + i] = true;
-				}
-				chunk_ok = true;
-			}
-			else if (!isTransientModbusError(result))
-			{
-				// Permanenter Fehler (z.B. Illegal Data Address im Block) → Retries sinnlos.
-				break;
-			}
-			yield(); // zwischen den Versuchen abgeben, damit kein langer Span ohne yield entsteht
-		}
-		if (!chunk_ok)
-		{
-			log(LOG_LEVEL_WARNING, "Dump chunk starting at " + String(start_id + done) + " failed (result=0x" + String(lastModbusResult, HEX) + ")");
-			for (uint16_t i = 0; i < chunk; ++i)
-			{
-				valid[done + i] = false;
-			}
-			all_ok = false;
-		}
-		done += chunk;
-		yield(); // TCP/MQTT-Stacks bedienen und Watchdog fuettern
-	}
-	return all_ok;
+	awaitBusSlot(6, 3 + 2 * count);
+	uint8_t result = rtuReadHoldingRegisters(start_id, count, values);
+	busGapReport(result, first_try);
+	return getModbusResultMsg(result);
 }
 
 // Liest die bekannten Fault-Register und haengt die AKTIVEN Geraetefehler an das
@@ -338,7 +354,7 @@ bool readHoldingRange(uint16_t start_id, uint16_t count, uint16_t *values, bool
 // in modbus_faults.h auf FAULT_ADDR_TODO stehen, bleibt "faults" leer und es findet kein
 // Bus-Zugriff statt. Sobald echte Adressen eingetragen sind, erscheinen gesetzte Bits
 // automatisch als Code-Liste (semantisch z.B. "flow_fault", numerisch z.B. "E03").
-void writeFaultStatusToJson(ArduinoJson::JsonVariant variant)
+void writeFaultStatusToJson(const register_snapshot_t &snap, ArduinoJson::JsonVariant variant)
 {
 	JsonArray active = variant["faults"].to<JsonArray>();
 	bool any = false;
@@ -353,11 +369,11 @@ void writeFaultStatusToJson(ArduinoJson::JsonVariant variant)
 
 		// Wert kommt aus dem Cache, den der getaktete Poller fuellt (distributeFaultBlock) — kein
 		// separater, ungetakteter Live-Read mehr (verursachte sonst pro Zyklus einen Timeout).
-		if (!faultRegValid[i])
+		if (!snap.faultValid[i])
 		{
 			continue; // noch nicht gelesen bzw. letzter Block-Read fehlgeschlagen
 		}
-		uint16_t val = faultRegValue[i];
+		uint16_t val = snap.faultValue[i];
 		if (val == 0)
 		{
 			continue; // keine Fehlerbits gesetzt
@@ -389,144 +405,346 @@ void writeFaultStatusToJson(ArduinoJson::JsonVariant variant)
 // --- Poll-Ranges fuer das Daten-JSON ---------------------------------------------------
 // Statt jedes benannte Register einzeln zu lesen, liest der Poller sie block-weise: ein
 // zusammenhaengender Range pro Tick. Das senkt die Zahl der Modbus-Transaktionen je Zyklus
-// (17 -> 3) und damit die Kollisionsfenster mit dem Tuya-Master, ohne den Loop pro Tick
-// laenger als ~ein Timeout zu blockieren (ein Block = eine Transaktion pro Tick).
-// Die Ranges muessen ALLE Adressen aus registers[] abdecken (Pruefung: checkPollRangeCoverage()).
-// Jeder Range <= ku8MaxBufferSize (64). Laut Dump sind 26..199 lueckenlos lesbar (kein Illegal
+// und damit die Kollisionsfenster mit dem Tuya-Master, ohne den Loop pro Tick laenger als
+// ~ein Timeout zu blockieren (ein Block = eine Transaktion pro Tick).
+// Die Ranges kommen aus dem Compilezeit-Planer (modbus_poll_plan.h, pollPlan): er deckt garantiert
+// ALLE Adressen aus registers[] und faultRegisters[] ab (static_assert) — frueher handgepflegt plus
+// Laufzeit-Warnung checkPollRangeCoverage(). Laut Dump sind 26..199 lueckenlos lesbar (kein Illegal
 // Data Address), 32765 ist ein gueltiger "Sensor not connected"-Wert, kein Fehler.
-typedef struct
-{
-	uint16_t start;
-	uint16_t count;
-} poll_range_t;
-
 // Reihenfolge egal fuer die Korrektheit; entscheidend ist der Abstand zwischen den Transaktionen
-// (MODBUS_POLL_INTERVAL_MS in main.cpp). Per Diagnose 2026-06-15 bestaetigt: dieser Slave verschluckt
-// Anfragen, die zu kurz (~100 ms) auf die vorige folgen — die jeweils ERSTE Range im Zyklus klappte
-// immer, die folgenden scheiterten im 1. Versuch (Positions- nicht Adress-abhaengig, per Reorder-Test
-// nachgewiesen). Behoben durch groesseren Poll-Tick statt durch Range-Reihenfolge.
-// Die erste Range startet bei 26 (statt 39), damit die Fehlerregister 26/27 (new_fault_01) im selben
-// getakteten Block mitgelesen werden — frueher wurden sie in writeFaultStatusToJson() live und
-// ungetaktet direkt nach dem Zyklus gelesen und liefen darum jedes Mal in einen Timeout. 26..199 ist
-// laut Dump lueckenlos lesbar; count 50 (<= ku8MaxBufferSize 64).
-static const poll_range_t pollRanges[] = {
-	{26, 50}, // deckt Fehlerreg. 26,27 + 39,41,48,50,51,52,53,54,55,64,75 ab
-	{92, 17}, // deckt 92,93,105,106,108 ab
-	{132, 1}, // deckt 132 ab
-};
-static const int num_poll_ranges = sizeof(pollRanges) / sizeof(poll_range_t);
+// (Bus-Gap, modbus_gap.h). Per Diagnose 2026-06-15 bestaetigt: dieser Slave verschluckt Anfragen,
+// die zu kurz (~100 ms) auf die vorige folgen — der Bus-Gap lernt die noetige Erholzeit.
+// Aktiver Plan: der Compilezeit-Plan oder, nach replanPoll() beim Boot, einer, der zusaetzlich die
+// gelernten Loecher der Adresskarte (modbus_holes.h) meidet. Nur Worker/Init, danach unveraendert.
+static PollPlan runtimePollPlan;
+static const PollPlan *activePlan = &pollPlan;
+static int num_poll_ranges = pollPlan.num_ranges;
 
 // Traegt die Werte eines gelesenen (ok=true) bzw. fehlgeschlagenen (ok=false -> 0xFFFF) Blocks
-// in register_values[] ein: fuer jedes benannte Register, dessen Adresse in den Range faellt.
-static void distributeBlock(const poll_range_t &range, const uint16_t *buf, bool ok)
+// in register_values[] ein: ueber die vorberechnete Slot-Tabelle des Ranges, O(k).
+// buf enthaelt buf_count Register ab Adresse buf_start — beim Poll genau der Range, beim Sniffer
+// (onSniffedBlock) ein beliebiger fremder Block: Slots ausserhalb davon bleiben unberuehrt.
+// Rueckgabe: true, wenn sich dabei mindestens ein Wert ueber sein Totband hinaus geaendert hat
+// (steuert den Sofort-Publish; Bezug ist der zuletzt publizierte Wert, siehe registerChanged).
+static bool distributeBlock(const poll_range_t &range, const uint16_t *buf, uint16_t buf_start, uint16_t buf_count, bool ok)
 {
-	for (int i = 0; i < num_registers; ++i)
+	bool changed = false;
+	for (int s = range.first_slot; s < range.first_slot + range.slot_count; ++s)
 	{
-		uint16_t id = registers[i].id;
-		if (id >= range.start && id < range.start + range.count)
+		const poll_slot_t &slot = activePlan->slots[s];
+		uint16_t pos = range.start + slot.offset - buf_start;
+		if (slot.kind == POLL_SLOT_REGISTER && range.start + slot.offset >= buf_start && pos < buf_count)
 		{
-			register_values[i] = ok ? buf[id - range.start] : 0xFFFF;
+			uint16_t v = ok ? buf[pos] : 0xFFFF;
+			changed |= registerChanged(slot.index, publishedValues[slot.index], v);
+			register_values[slot.index] = v;
 		}
 	}
+	return changed;
 }
 
 // Analog zu distributeBlock, aber fuer die Fehlerregister: traegt fuer jedes faultRegister mit
 // echter Adresse im Range den Rohwert in den Cache ein. So werden 26/27 im selben getakteten Block
 // gelesen wie die Normaldaten — kein separater, ungetakteter Live-Read mehr.
-static void distributeFaultBlock(const poll_range_t &range, const uint16_t *buf, bool ok)
+static bool distributeFaultBlock(const poll_range_t &range, const uint16_t *buf, uint16_t buf_start, uint16_t buf_count, bool ok)
 {
-	for (int i = 0; i < num_fault_regs; ++i)
+	bool changed = false;
+	for (int s = range.first_slot; s < range.first_slot + range.slot_count; ++s)
+	{
+		const poll_slot_t &slot = activePlan->slots[s];
+		uint16_t pos = range.start + slot.offset - buf_start;
+		if (slot.kind == POLL_SLOT_FAULT && range.start + slot.offset >= buf_start && pos < buf_count)
+		{
+			uint16_t v = ok ? buf[pos] : 0;
+			changed |= faultRegValue[slot.index] != v || faultRegValid[slot.index] != ok;
+			faultRegValue[slot.index] = v;
+			faultRegValid[slot.index] = ok;
+		}
+	}
+	return changed;
+}
+
+// Plant die Poll-Ranges beim Boot mit den gelernten Loechern neu (buildPollPlan zur Laufzeit, dieselbe
+// DP wie zur Compilezeit). Frueher kannte der Planer nur pollHoles[]: ein Block ueber ein spaeter per
+// Dump gefundenes Loch scheiterte bei jedem Poll mit Illegal Data Address. Beruecksichtigt werden nur
+// Loecher zwischen kleinster und groesster Poll-Adresse (mehr kann kein Block ueberdecken). Liegt ein
+// Register selbst auf einem gelernten Loch, bleibt es beim Compilezeit-Plan (Warnung) -> der Poll
+// meldet das Register wie bisher als Fehler. Eine neu gelernte Karte wirkt ab dem naechsten Boot.
+static void replanPoll()
+{
+	uint16_t lo = 0xFFFF;
+	uint16_t hi = 0;
+	for (int r = 0; r < pollPlan.num_ranges; ++r)
+	{
+		const poll_range_t &range = pollPlan.ranges[r];
+		lo = range.start < lo ? range.start : lo;
+		hi = range.start + range.count - 1 > hi ? range.start + range.count - 1 : hi;
+	}
+	static uint16_t holes[MODBUS_HOLES_PLAN_MAX + sizeof(pollHoles) / sizeof(pollHoles[0])];
+	int n = modbusHolesCollect(lo, hi, holes, MODBUS_HOLES_PLAN_MAX);
+	if (n < 0)
+	{
+		LOGF(LOG_LEVEL_WARNING, "Poll-Plan: mehr als %u gelernte Loecher in %u..%u, Compilezeit-Plan bleibt", MODBUS_HOLES_PLAN_MAX, lo, hi);
+		return;
+	}
+	if (n == 0)
+	{
+		return; // nichts Neues gelernt -> Compilezeit-Plan ist schon optimal
+	}
+	for (uint16_t h : pollHoles)
+	{
+		holes[n++] = h;
+	}
+	runtimePollPlan = buildPollPlan(holes, n, MODBUS_PLAN_TX_COST_REGS);
+	if (runtimePollPlan.cost == POLL_PLAN_INFEASIBLE)
+	{
+		log(LOG_LEVEL_WARNING, "Poll-Plan: ein Register liegt auf einem gelernten Loch, Compilezeit-Plan bleibt");
+		return;
+	}
+	activePlan = &runtimePollPlan;
+	num_poll_ranges = runtimePollPlan.num_ranges;
+	LOGF(LOG_LEVEL_WARNING, "Poll-Plan mit %d gelernten Loechern: %d Ranges (Compilezeit: %d)", n, num_poll_ranges, pollPlan.num_ranges);
+}
+
+// Protokolliert den geplanten Poll-Zyklus einmalig beim Init (Diagnose: welche Blocks, wie viele).
+static void logPollPlan()
+{
+	for (int r = 0; r < num_poll_ranges; ++r)
+	{
+		const poll_range_t &range = activePlan->ranges[r];
+		LOGF(LOG_LEVEL_INFO, "Poll-Plan: Range %u..%u (%u Werte)", range.start, range.start + range.count - 1, range.slot_count);
+	}
+}
+
+// --- Deadline-Scheduler ----------------------------------------------------------------
+// Statt Round-Robin ueber alle Ranges mit festen Pausen hat jeder Range eine absolute Faelligkeit
+// (Ticks), abgeleitet aus der Refresh-Klasse seiner Eintraege (MODBUS_POLL_PERIOD_*_MS). Pro Tick
+// liest der Worker den am laengsten ueberfaelligen Range; die naechste Faelligkeit wird wie bei
+// vTaskDelayUntil() auf die ALTE Faelligkeit addiert (keine Drift durch Bus-/Retry-Dauer). Liegt ein
+// Range mehr als eine Periode zurueck (App-Modus, lange Dumps), wird neu aufgesetzt statt in einem
+// Burst nachzuholen. Die Verspaetung beim Start (Jitter) wird je Klasse als Maximum mitgeschrieben.
+static const uint32_t pollClassPeriodMs[POLL_CLASS_COUNT] = {
+	MODBUS_POLL_PERIOD_NORMAL_MS, // POLL_CLASS_NORMAL
+	MODBUS_POLL_PERIOD_FAST_MS,	  // POLL_CLASS_FAST
+	MODBUS_POLL_PERIOD_SLOW_MS,	  // POLL_CLASS_SLOW
+};
+static TickType_t rangeDue[kPollMaxEntries];					// absolute Faelligkeit je Range
+static uint8_t rangeTries[kPollMaxEntries];						// Fehlversuche des laufenden Reads
+static volatile uint32_t pollJitterMaxMs[POLL_CLASS_COUNT];	// max. Startverspaetung je Klasse
+static uint32_t lastPollPublishMs = 0;
+static bool cycleChanged = false; // Aenderungen seit dem letzten Commit (fillRegisterValues)
+
+// Sofort bei einem geaenderten Wert, sonst spaetestens alle MODBUS_PUBLISH_MAX_AGE_MS publizieren.
+static bool publishDue(bool changed)
+{
+	uint32_t nowMs = millis();
+	if (changed || (uint32_t)(nowMs - lastPollPublishMs) >= MODBUS_PUBLISH_MAX_AGE_MS)
+	{
+		lastPollPublishMs = nowMs;
+		return true;
+	}
+	return false;
+}
+
+// Beim Init: alles sofort faellig -> der erste Zyklus liest jeden Range einmal (schnelle Klasse zuerst).
+static void initPollSchedule()
+{
+	TickType_t now = xTaskGetTickCount();
+	for (int r = 0; r < num_poll_ranges; ++r)
+	{
+		rangeDue[r] = now;
+		rangeTries[r] = 0;
+	}
+}
+
+static uint32_t rangePeriodMs(int r)
+{
+	return pollClassPeriodMs[activePlan->ranges[r].poll_class];
+}
+
+// Der am laengsten ueberfaellige Range oder -1, falls keiner faellig ist. Bei Gleichstand gewinnt die
+// kuerzere Periode (wichtiger Zustand zuerst).
+static int pickOverdueRange(TickType_t now)
+{
+	int best = -1;
+	int32_t bestLate = -1;
+	for (int r = 0; r < num_poll_ranges; ++r)
 	{
-		uint16_t addr = faultRegisters[i].modbus_addr;
-		if (addr == FAULT_ADDR_TODO)
+		int32_t late = (int32_t)(now - rangeDue[r]);
+		if (late < 0)
 		{
-			continue; // Adresse noch nicht identifiziert -> nicht im Poll-Bereich
+			continue;
 		}
-		if (addr >= range.start && addr < range.start + range.count)
+		if (late > bestLate || (late == bestLate && rangePeriodMs(r) < rangePeriodMs(best)))
 		{
-			faultRegValue[i] = ok ? buf[addr - range.start] : 0;
-			faultRegValid[i] = ok;
+			best = r;
+			bestLate = late;
 		}
 	}
+	return best;
 }
 
-// Entwicklungs-Pruefung: warnt einmalig, falls ein registers[]-Eintrag von keinem pollRange
-// abgedeckt wird (er wuerde sonst nie gelesen). Aendert nichts, dient nur der Wartbarkeit.
-void checkPollRangeCoverage()
+// Naechste Faelligkeit relativ zur alten setzen (vTaskDelayUntil-Semantik), bei Rueckstand neu aufsetzen.
+static void advanceRangeDue(int r, TickType_t now)
 {
-	for (int i = 0; i < num_registers; ++i)
+	TickType_t period = pdMS_TO_TICKS(rangePeriodMs(r));
+	rangeDue[r] += period;
+	if ((int32_t)(now - rangeDue[r]) >= 0)
 	{
-		bool covered = false;
-		for (int r = 0; r < num_poll_ranges; ++r)
+		rangeDue[r] = now + period;
+	}
+}
+
+uint32_t modbusPollIdleMs()
+{
+	TickType_t now = xTaskGetTickCount();
+	int32_t soonest = INT32_MAX;
+	for (int r = 0; r < num_poll_ranges; ++r)
+	{
+		int32_t until = (int32_t)(rangeDue[r] - now);
+		if (until < soonest)
 		{
-			if (registers[i].id >= pollRanges[r].start &&
-				registers[i].id < pollRanges[r].start + pollRanges[r].count)
-			{
-				covered = true;
-				break;
-			}
+			soonest = until;
 		}
-		if (!covered)
+	}
+	return soonest <= 0 ? 0 : soonest * portTICK_PERIOD_MS;
+}
+
+uint32_t modbusPollJitterMaxMs()
+{
+	uint32_t worst = 0;
+	for (int c = 0; c < POLL_CLASS_COUNT; ++c)
+	{
+		if (pollJitterMaxMs[c] > worst)
 		{
-			log(LOG_LEVEL_ERROR, "Register " + String(registers[i].name) + " (id " + String(registers[i].id) + ") liegt in keinem pollRange -> wird NICHT gelesen!");
+			worst = pollJitterMaxMs[c];
 		}
+		pollJitterMaxMs[c] = 0;
 	}
+	return worst;
 }
 
-// Liest pro Aufruf EINEN Poll-Range (eine Modbus-Transaktion) und verteilt die Werte auf die
-// benannten Register. Retry-Logik wie zuvor, aber pro Range statt pro Register: bei transientem
-// Fehler (Tuya-Buskollision) viele Versuche ueber die folgenden Ticks, bei echtem Slave-Fehler
-// schnell aufgeben. Gibt true zurueck, wenn ein voller Zyklus (alle Ranges) abgeschlossen ist.
+// Liest pro Aufruf den am laengsten ueberfaelligen Poll-Range (eine Modbus-Transaktion) und verteilt
+// die Werte auf die benannten Register. Retry-Logik pro Range: bei transientem Fehler (Tuya-Buskollision)
+// viele Versuche ueber die folgenden Ticks (der Range bleibt faellig und damit der ueberfaelligste),
+// bei echtem Slave-Fehler schnell aufgeben. Gibt true zurueck, wenn publiziert werden soll: sofort bei
+// einem geaenderten Wert, sonst spaetestens alle MODBUS_PUBLISH_MAX_AGE_MS (retained /data bleibt frisch).
 bool fillRegisterValues()
 {
-	static uint16_t blockBuf[64]; // >= groesster pollRange.count, <= ku8MaxBufferSize
-	const poll_range_t &range = pollRanges[currentRangeIndex];
-	log(LOG_LEVEL_INFO, "Filling range " + String(range.start) + ".." + String(range.start + range.count - 1) + " (" + String(currentRangeIndex) + "/" + String(num_poll_ranges - 1) + "); try " + String(currentTryIndex + 1));
-	if (getModbusBlock(range.start, range.count, blockBuf))
+	static uint16_t blockBuf[RTU_MAX_READ_REGS]; // >= groesster pollRange.count
+	TickType_t now = xTaskGetTickCount();
+	int r = pickOverdueRange(now);
+	if (r < 0)
+	{
+		return false;
+	}
+	const poll_range_t &range = activePlan->ranges[r];
+	if (rangeTries[r] == 0)
 	{
-		if (lockRegisterCache(100))
+		uint32_t jitter = (uint32_t)(now - rangeDue[r]) * portTICK_PERIOD_MS;
+		if (jitter > pollJitterMaxMs[range.poll_class])
 		{
-			distributeBlock(range, blockBuf, true);
-			distributeFaultBlock(range, blockBuf, true);
-			unlockRegisterCache();
+			pollJitterMaxMs[range.poll_class] = jitter;
 		}
-		log(LOG_LEVEL_INFO, "Filled range " + String(range.start) + ".." + String(range.start + range.count - 1));
-		currentTryIndex = 0;
-		currentRangeIndex++;
+	}
+	LOGF(LOG_LEVEL_INFO, "Filling range %u..%u (%d/%d, class %u); try %u", range.start, range.start + range.count - 1, r, num_poll_ranges - 1, range.poll_class, rangeTries[r] + 1);
+	bool changed = false;
+	if (getModbusBlock(range.start, range.count, blockBuf, rangeTries[r] == 0))
+	{
+		changed |= distributeBlock(range, blockBuf, range.start, range.count, true);
+		changed |= distributeFaultBlock(range, blockBuf, range.start, range.count, true);
+		LOGF(LOG_LEVEL_INFO, "Filled range %u..%u", range.start, range.start + range.count - 1);
+		rangeTries[r] = 0;
+		advanceRangeDue(r, now);
 	}
 	else
 	{
 		// Retry-Budget abhängig vom Fehlertyp: bei Buskollision (Tuya-Master stört) viel mehr Versuche,
 		// bei echten Slave-Fehlern (Illegal Function/Address/Value, Slave Device Failure) schnell aufgeben.
 		int retry_budget = isTransientModbusError(lastModbusResult) ? MODBUS_RETRIES_BUS_COLLISION : MODBUS_RETRIES;
-		log(LOG_LEVEL_WARNING, "Failed to read range " + String(range.start) + ".." + String(range.start + range.count - 1) + " (try " + String(currentTryIndex + 1) + "/" + String(retry_budget + 1) + ", result=0x" + String(lastModbusResult, HEX) + ")");
-		if (currentTryIndex < retry_budget)
+		LOGF(LOG_LEVEL_WARNING, "Failed to read range %u..%u (try %u/%u, result=0x%x)", range.start, range.start + range.count - 1, rangeTries[r] + 1, retry_budget + 1, lastModbusResult);
+		if (rangeTries[r] < retry_budget)
 		{
-			currentTryIndex++;
+			rangeTries[r]++;
 		}
 		else
 		{
-			log(LOG_LEVEL_ERROR, "Max retries reached for range " + String(range.start) + ".." + String(range.start + range.count - 1) + ". Moving to next range.");
-			if (lockRegisterCache(100))
-			{
-				distributeBlock(range, blockBuf, false); // alle Register dieses Ranges als Fehler markieren
-				distributeFaultBlock(range, blockBuf, false); // ebenso die Fehlerregister dieses Ranges
-				unlockRegisterCache();
-			}
-			currentTryIndex = 0;
-			currentRangeIndex++;
+			LOGF(LOG_LEVEL_ERROR, "Max retries reached for range %u..%u. Moving to next range.", range.start, range.start + range.count - 1);
+			changed |= distributeBlock(range, blockBuf, range.start, range.count, false);		// alle Register dieses Ranges als Fehler markieren
+			changed |= distributeFaultBlock(range, blockBuf, range.start, range.count, false); // ebenso die Fehlerregister dieses Ranges
+			rangeTries[r] = 0;
+			advanceRangeDue(r, now);
 		}
 	}
-	if (currentRangeIndex < num_poll_ranges)
+	// Zyklus-konsistent committen: solange noch weitere Ranges ueberfaellig sind (gleicher "Zyklus",
+	// z.B. nach dem Boot oder wenn mehrere Klassen zugleich faellig werden), Aenderungen nur sammeln.
+	// Das Hoechstalter (publishDue) gilt trotzdem, damit ein Range im Retry den Commit nicht aufhaelt.
+	cycleChanged |= changed;
+	if (pickOverdueRange(xTaskGetTickCount()) >= 0 && (uint32_t)(millis() - lastPollPublishMs) < MODBUS_PUBLISH_MAX_AGE_MS)
 	{
 		return false;
 	}
-	else
+	if (publishDue(cycleChanged))
 	{
-		currentRangeIndex = 0;
-		currentTryIndex = 0;
+		cycleChanged = false;
 		return true;
 	}
+	return false;
+}
+
+// --- Passiver Sniffer (modbus_sniffer.h) -----------------------------------------------
+
+// Ein vom Sniffer gepaarter Block: ueber denselben distributeBlock-Pfad wie der eigene Poll, nur mit
+// dem fremden Block als Fenster. Publiziert wie der Poller (bei Aenderung bzw. nach Hoechstalter).
+static void onSniffedBlock(uint16_t start, uint16_t count, const uint16_t *values)
+{
+	bool changed = false;
+	for (int r = 0; r < num_poll_ranges; ++r)
+	{
+		const poll_range_t &range = activePlan->ranges[r];
+		if (range.start < start + count && start < range.start + range.count)
+		{
+			changed |= distributeBlock(range, values, start, count, true);
+			changed |= distributeFaultBlock(range, values, start, count, true);
+		}
+	}
+	uint32_t nowMs = millis();
+	for (int i = 0; i < num_registers; ++i)
+	{
+		if (registers[i].id >= start && registers[i].id < start + count)
+		{
+			registerSniffedMs[i] = nowMs | 1; // nie 0 (= "nie gesnifft"), 1 ms Unschaerfe egal
+		}
+	}
+	if (publishDue(changed))
+	{
+		requestPublish();
+	}
+}
+
+// Jedes mitgehoerte Fremd-Frame (rtuListen im Worker): Timing an den Arbiter, Inhalt an den Sniffer.
+static void onForeignFrame(const uint8_t *frame, size_t len, int64_t start_us, int64_t end_us)
+{
+	busArbiterOnFrame(start_us, end_us);
+	snifferFrame(frame, len, start_us, end_us);
+}
+
+void writeSniffFreshnessToJson(const register_snapshot_t &snap, ArduinoJson::JsonVariant variant)
+{
+	uint32_t nowMs = millis();
+	JsonObject ages;
+	for (int i = 0; i < num_registers; ++i)
+	{
+		if (snap.sniffedMs[i] == 0)
+		{
+			continue;
+		}
+		if (ages.isNull())
+		{
+			ages = variant["sniffed_age_s"].to<JsonObject>();
+		}
+		ages[registers[i].name] = (nowMs - snap.sniffedMs[i]) / 1000;
+	}
 }
 
 String toBinary(uint16_t input)
@@ -542,7 +760,7 @@ String toBinary(uint16_t input)
 
 bool decodeDiematicDecimal(uint16_t int_input, int8_t decimals, float *value_ptr)
 {
-	log(LOG_LEVEL_INFO, "Decoding " + String(int_input) + " with " + String(decimals) + " decimal(s)");
+	LOGF(LOG_LEVEL_INFO, "Decoding %u with %d decimal(s)", int_input, decimals);
 	if (int_input == 65535)
 	{
 		value_ptr = nullptr;
@@ -557,37 +775,63 @@ bool decodeDiematicDecimal(uint16_t int_input, int8_t decimals, float *value_ptr
 			output = -output;
 		}
 		*value_ptr = output / pow(10, decimals);
-		log(LOG_LEVEL_INFO, "Decoded value: " + String(*value_ptr));
+		LOGF(LOG_LEVEL_INFO, "Decoded value: %.2f", *value_ptr);
 		return true;
 	}
 }
 
-void writeRegisterValuesToJson(ArduinoJson::JsonVariant variant)
+// Diematic-Rohwert (Bit 15 = Vorzeichen, Betrag in Bit 0..14) als vorzeichenbehaftete Ganzzahl.
+static int32_t diematicRaw(uint16_t v)
+{
+	return (v & 0x8000) ? -(int32_t)(v & 0x7FFF) : (int32_t)v;
+}
+
+bool registerChanged(uint8_t index, uint16_t ref, uint16_t now)
 {
+	if (ref == now)
+	{
+		return false;
+	}
+	const modbus_register_t &reg = registers[index];
+	if (ref == 0xFFFF || now == 0xFFFF || reg.deadband == 0 || reg.type == REGISTER_TYPE_BITFIELD)
+	{
+		return true;
+	}
+	int32_t delta = reg.type == REGISTER_TYPE_DIEMATIC_ONE_DECIMAL ? diematicRaw(now) - diematicRaw(ref) : (int32_t)now - (int32_t)ref;
+	return delta > reg.deadband || delta < -(int32_t)reg.deadband;
+}
+
+void writeRegisterValuesToJson(const register_snapshot_t &snap, ArduinoJson::JsonVariant variant, const bool *only)
+{
+	const uint16_t *register_values = snap.values; // Snapshot statt Worker-Stand
 	// searchin for register matching register_id
 	for (uint8_t i = 0; i < num_registers; ++i)
 	{
+		if (only != nullptr && !only[i])
+		{
+			continue;
+		}
 		// register found
-		log(LOG_LEVEL_INFO, "Register id=" + String(registers[i].id) + " type=0x" + String(registers[i].type) + " name=" + String(registers[i].name));
+		LOGF(LOG_LEVEL_INFO, "Register id=%u type=0x%x name=%s", registers[i].id, registers[i].type, registers[i].name);
 		if (register_values[i] != 0xFFFF)
 		{
-			log(LOG_LEVEL_INFO, "Raw value: " + String(registers[i].name) + "=" + String(register_values[i]));
+			LOGF(LOG_LEVEL_INFO, "Raw value: %s=%u", registers[i].name, register_values[i]);
 			switch (registers[i].type)
 			{
 			case REGISTER_TYPE_U16:
-				log(LOG_LEVEL_INFO, "Value: " + String(register_values[i]));
+				LOGF(LOG_LEVEL_INFO, "Value: %u", register_values[i]);
 				variant[registers[i].name] = register_values[i];
 				break;
 			case REGISTER_TYPE_DIEMATIC_ONE_DECIMAL:
 				float final_value;
 				if (decodeDiematicDecimal(register_values[i], 1, &final_value))
 				{
-					log(LOG_LEVEL_INFO, "Value: " + String(final_value));
+					LOGF(LOG_LEVEL_INFO, "Value: %.2f", final_value);
 					variant[registers[i].name] = final_value;
 				}
 				else
 				{
-					log(LOG_LEVEL_INFO, "Value: Invalid Diematic value");
+					LOGF(LOG_LEVEL_INFO, "Value: Invalid Diematic value");
 				}
 				break;
 			case REGISTER_TYPE_BITFIELD:
@@ -596,56 +840,37 @@ void writeRegisterValuesToJson(ArduinoJson::JsonVariant variant)
 					const char *bit_varname = registers[i].optional_param.bitfield[j];
 					if (bit_varname == nullptr)
 					{
-						log(LOG_LEVEL_INFO, " [bit" + String(j) + "] end of bitfield reached");
+						LOGF(LOG_LEVEL_INFO, " [bit%u] end of bitfield reached", j);
 						break;
 					}
 					const uint8_t bit_value = register_values[i] >> j & 1;
-					log(LOG_LEVEL_INFO, " [bit" + String(j) + "] " + String(bit_varname) + "=" + String(bit_value));
+					LOGF(LOG_LEVEL_INFO, " [bit%u] %s=%u", j, bit_varname, bit_value);
 					variant[bit_varname] = bit_value;
 				}
 				break;
 			case REGISTER_TYPE_DEBUG:
-				log(LOG_LEVEL_INFO, "Raw DEBUG value: " + String(registers[i].name) + "=" + String(register_values[i]) + " (0b" + toBinary(register_values[i]) + ")");
+				LOGF(LOG_LEVEL_INFO, "Raw DEBUG value: %s=%u (0b%s)", registers[i].name, register_values[i], toBinary(register_values[i]).c_str());
 				break;
 			default:
-				log(LOG_LEVEL_ERROR, "Unsupported register type");
+				LOGF(LOG_LEVEL_ERROR, "Unsupported register type");
 				break;
 			}
 		}
 		else
 		{
-			log(LOG_LEVEL_ERROR, "Request failed!");
+			LOGF(LOG_LEVEL_ERROR, "Request failed!");
 		}
 	}
 }
 
 // =========================================================================================
 // Modbus-Worker-Task: alleiniger Besitzer des RS485-Busses.
-// Poll-Read, MQTT-Write und Web-Dump werden zu Requests in einer FreeRTOS-Queue und HIER
-// serialisiert ausgefuehrt. Dadurch fasst nur dieser Task modbus_client/UART an -> keine
+// Poll-Read, MQTT-Write (pendingWrites) und Web-Dump (Dump-Sitzung) werden HIER serialisiert
+// ausgefuehrt. Dadurch fasst nur dieser Task den RTU-Transport/UART an -> keine
 // Cross-Task-Bus-Races mehr; das blockierende Busy-Wait des Writes liegt nicht mehr im
 // AsyncTCP-Callback (war Ursache des Task-Watchdog-Resets 2026-06-16).
 // =========================================================================================
 
-enum ModbusReqType
-{
-	MB_REQ_WRITE,
-	MB_REQ_DUMP
-};
-
-struct ModbusRequest
-{
-	ModbusReqType type;
-	char name[32];                       // WRITE: Registername
-	uint16_t value;                      // WRITE: Rohwert
-	uint16_t start;                      // DUMP:  Startadresse
-	uint16_t count;                      // DUMP:  Anzahl
-	uint16_t *values;                    // DUMP:  Zielpuffer (interner Dump-Puffer)
-	bool *valid;                         // DUMP:  Gueltigkeitsflags
-	volatile ModbusDumpState *dumpState; // DUMP:  setzt der Worker nach Fertigstellung auf DONE
-};
-
-static QueueHandle_t modbusRequestQueue = nullptr;
 static TaskHandle_t modbusWorkerHandle = nullptr;
 static volatile bool g_modbusPublishRequested = false;
 
@@ -665,6 +890,8 @@ void feedLoopHeartbeat()
 // publishModbusData() im Loop-Task (so wird AsyncMqttClient aus genau einem Task bedient).
 static void requestPublish()
 {
+	commitRegisterSnapshot(); // erst den Stand sichtbar machen, dann den Publish anstossen
+	memcpy(publishedValues, register_values, sizeof(publishedValues));
 	g_modbusPublishRequested = true;
 }
 
@@ -678,96 +905,567 @@ bool consumeModbusPublishRequest()
 	return false;
 }
 
+// --- Write-Coalescing -----------------------------------------------------------------
+// Frueher wurde jeder MQTT-write_register ein eigener Queue-Eintrag (8 Plaetze) und eine eigene
+// Transaktion; ein HA-Slider fuellte die Queue ("Modbus-Write-Queue voll"). Jetzt haelt je Register
+// ein Slot den JUENGSTEN noch nicht gesendeten Wert (last writer wins). Der Worker nimmt alle
+// anstehenden Slots auf einmal, sortiert nach Adresse und schreibt zusammenhaengende Adressen als
+// EINE FC16-Transaktion (einzelne per FC06). Ueberholte Werte und das Ergebnis gehen als
+// Write-Result an den Loop-Task (consumeModbusWriteResult -> MQTT .../write_result).
+typedef struct
+{
+	bool pending;
+	uint16_t value;
+	uint8_t superseded;										  // ueberholte Werte seit dem letzten Bus-Write (saettigt bei 255)
+	uint8_t supersededNext;									  // naechster Platz im Ring (0..KEEP-1, laeuft weiter)
+	uint16_t supersededValues[MODBUS_WRITE_SUPERSEDED_KEEP]; // die juengsten davon
+} pending_write_t;
+
+// enqueueModbusWrite() laeuft im AsyncTCP-/MQTT-Task, der Worker entnimmt -> kurzer Spinlock, kein Mutex.
+static pending_write_t pendingWrites[MODBUS_NUM_REGISTERS];
+static volatile bool pendingWritesAny = false;
+static portMUX_TYPE pendingWritesMux = portMUX_INITIALIZER_UNLOCKED;
+
+static modbus_write_result_t writeResults[MODBUS_WRITE_RESULT_QUEUE];
+static uint8_t writeResultsHead = 0; // naechster Leseplatz
+static uint8_t writeResultsCount = 0;
+static portMUX_TYPE writeResultsMux = portMUX_INITIALIZER_UNLOCKED;
+
 bool enqueueModbusWrite(const char *register_name, uint16_t value)
 {
-	if (modbusRequestQueue == nullptr)
+	if (modbusWorkerHandle == nullptr)
 	{
 		return false;
 	}
-	ModbusRequest req = {};
-	req.type = MB_REQ_WRITE;
-	strncpy(req.name, register_name, sizeof(req.name) - 1);
-	req.value = value;
-	if (xQueueSend(modbusRequestQueue, &req, 0) != pdTRUE)
+	int idx = findRegisterIndex(register_name);
+	if (idx < 0)
 	{
-		log(LOG_LEVEL_ERROR, "Modbus-Write-Queue voll, Write verworfen: " + String(register_name));
+		log(LOG_LEVEL_ERROR, "Register name '" + String(register_name) + "' not found");
 		return false;
 	}
+	bool superseded = false;
+	uint16_t old = 0;
+	portENTER_CRITICAL(&pendingWritesMux);
+	pending_write_t &pw = pendingWrites[idx];
+	if (pw.pending)
+	{
+		superseded = true;
+		old = pw.value;
+		pw.supersededValues[pw.supersededNext] = old;
+		pw.supersededNext = (pw.supersededNext + 1) % MODBUS_WRITE_SUPERSEDED_KEEP;
+		if (pw.superseded < 255)
+		{
+			pw.superseded++;
+		}
+	}
+	pw.value = value;
+	pw.pending = true;
+	pendingWritesAny = true;
+	portEXIT_CRITICAL(&pendingWritesMux);
+	if (superseded)
+	{
+		LOGF(LOG_LEVEL_INFO, "Write %s=%u ersetzt noch nicht gesendeten Wert %u", register_name, value, old);
+	}
 	return true;
 }
 
-// --- Non-blocking Dump-Zustand (vom asynchronen Webserver gepollt) ----------------------
-// Interne Puffer, die der Worker fuellt; der Webserver liest sie bei MB_DUMP_DONE per Accessor.
-// g_dumpState wird vom Worker (Core 0) geschrieben und vom AsyncTCP-Handler (ebenfalls Core 0)
-// gelesen -> volatile genuegt, kein Mutex noetig.
-static volatile ModbusDumpState g_dumpState = MB_DUMP_IDLE;
-static uint16_t g_dumpValues[MODBUS_DUMP_MAX];
-static bool g_dumpValid[MODBUS_DUMP_MAX];
-static uint16_t g_dumpStart = 0;
-static uint16_t g_dumpCount = 0;
+static void pushWriteResult(const modbus_write_result_t &res)
+{
+	portENTER_CRITICAL(&writeResultsMux);
+	if (writeResultsCount == MODBUS_WRITE_RESULT_QUEUE)
+	{
+		// voll (kein MQTT?) -> aeltestes Ergebnis verwerfen
+		writeResultsHead = (writeResultsHead + 1) % MODBUS_WRITE_RESULT_QUEUE;
+		writeResultsCount--;
+	}
+	writeResults[(writeResultsHead + writeResultsCount) % MODBUS_WRITE_RESULT_QUEUE] = res;
+	writeResultsCount++;
+	portEXIT_CRITICAL(&writeResultsMux);
+}
 
-bool requestModbusDump(uint16_t start, uint16_t count)
+bool consumeModbusWriteResult(modbus_write_result_t &out)
 {
-	if (modbusRequestQueue == nullptr || g_dumpState == MB_DUMP_RUNNING)
+	bool got = false;
+	portENTER_CRITICAL(&writeResultsMux);
+	if (writeResultsCount > 0)
 	{
-		return false; // kein Worker bzw. ein Dump laeuft schon
+		out = writeResults[writeResultsHead];
+		writeResultsHead = (writeResultsHead + 1) % MODBUS_WRITE_RESULT_QUEUE;
+		writeResultsCount--;
+		got = true;
 	}
-	if (count > MODBUS_DUMP_MAX)
+	portEXIT_CRITICAL(&writeResultsMux);
+	return got;
+}
+
+static void reportWrite(int idx, const pending_write_t &pw, bool ok, uint8_t batch)
+{
+	modbus_write_result_t res = {};
+	res.name = registers[idx].name;
+	res.value = pw.value;
+	res.ok = ok;
+	res.batch = batch;
+	res.superseded = pw.superseded;
+	// supersededValues ist ein Ring -> in zeitlicher Reihenfolge (aelteste zuerst) kopieren. Der Ring-
+	// index laeuft getrennt vom Zaehler weiter: superseded bleibt bei 255 stehen, der Ring nicht.
+	uint8_t kept = pw.superseded < MODBUS_WRITE_SUPERSEDED_KEEP ? pw.superseded : MODBUS_WRITE_SUPERSEDED_KEEP;
+	uint8_t oldest = (pw.supersededNext + MODBUS_WRITE_SUPERSEDED_KEEP - kept) % MODBUS_WRITE_SUPERSEDED_KEEP;
+	for (uint8_t k = 0; k < kept; ++k)
 	{
-		count = MODBUS_DUMP_MAX;
+		res.supersededValues[k] = pw.supersededValues[(oldest + k) % MODBUS_WRITE_SUPERSEDED_KEEP];
 	}
-	g_dumpStart = start;
-	g_dumpCount = count;
-	memset(g_dumpValid, 0, sizeof(g_dumpValid)); // Default ungueltig, bis der Worker fuellt
-	g_dumpState = MB_DUMP_RUNNING;
-	ModbusRequest req = {};
-	req.type = MB_REQ_DUMP;
-	req.start = start;
-	req.count = count;
-	req.values = g_dumpValues;
-	req.valid = g_dumpValid;
-	req.dumpState = &g_dumpState;
-	if (xQueueSend(modbusRequestQueue, &req, 0) != pdTRUE)
+	pushWriteResult(res);
+}
+
+// Alle anstehenden Writes auf einmal entnehmen (Slots wieder frei fuer neue Werte).
+static int takePendingWrites(pending_write_t *batch)
+{
+	int n = 0;
+	portENTER_CRITICAL(&pendingWritesMux);
+	for (int i = 0; i < num_registers; ++i)
 	{
-		g_dumpState = MB_DUMP_IDLE; // Queue voll -> Zustand zuruecknehmen
-		return false;
+		batch[i] = pendingWrites[i];
+		if (pendingWrites[i].pending)
+		{
+			n++;
+		}
+		pendingWrites[i] = {};
 	}
-	return true;
+	pendingWritesAny = false;
+	portEXIT_CRITICAL(&pendingWritesMux);
+	return n;
+}
+
+// Fuehrt die entnommenen Writes aus: nach Adresse sortiert, zusammenhaengende Adressen als ein Run.
+static void serviceWrites()
+{
+	pending_write_t batch[MODBUS_NUM_REGISTERS];
+	if (takePendingWrites(batch) == 0)
+	{
+		return;
+	}
+	// Indizes der anstehenden Register nach Adresse sortieren (Insertion-Sort, n <= num_registers).
+	int order[MODBUS_NUM_REGISTERS];
+	int n = 0;
+	for (int i = 0; i < num_registers; ++i)
+	{
+		if (!batch[i].pending)
+		{
+			continue;
+		}
+		int pos = n++;
+		while (pos > 0 && registers[order[pos - 1]].id > registers[i].id)
+		{
+			order[pos] = order[pos - 1];
+			--pos;
+		}
+		order[pos] = i;
+	}
+	bool any_ok = false;
+	for (int a = 0; a < n;)
+	{
+		// Run: a..b-1 mit lueckenlos aufsteigenden Adressen
+		uint16_t values[RTU_MAX_WRITE_REGS];
+		values[0] = batch[order[a]].value;
+		int b = a + 1;
+		while (b < n && b - a < RTU_MAX_WRITE_REGS && registers[order[b]].id == registers[order[b - 1]].id + 1)
+		{
+			values[b - a] = batch[order[b]].value;
+			++b;
+		}
+		bool ok = writeRegisterRun(registers[order[a]].id, b - a, values);
+		any_ok |= ok;
+		for (int k = a; k < b; ++k)
+		{
+			reportWrite(order[k], batch[order[k]], ok, b - a);
+		}
+		a = b;
+	}
+	if (any_ok)
+	{
+		requestPublish(); // Sofort-Feedback aus dem Cache (kein Bus-Read noetig)
+	}
+}
+
+// App-Modus: anstehende Writes nicht ausfuehren, sondern als fehlgeschlagen melden.
+static void dropPendingWrites()
+{
+	pending_write_t batch[MODBUS_NUM_REGISTERS];
+	if (takePendingWrites(batch) == 0)
+	{
+		return;
+	}
+	for (int i = 0; i < num_registers; ++i)
+	{
+		if (batch[i].pending)
+		{
+			LOGF(LOG_LEVEL_WARNING, "Write im App-Modus verworfen: %s", registers[i].name);
+			reportWrite(i, batch[i], false, 1);
+		}
+	}
+}
+
+// --- Dump-Sitzung (Worker -> Ring -> HTTP-Antwort) ---------------------------------------
+// Der Worker (Core 0) schreibt, die chunked HTTP-Antwort (AsyncTCP-Task) liest -> portMUX. Gelesen
+// wird vom Bus AUSSERHALB des Locks in einen lokalen Chunk; nur das Einhaengen ist kurz gesperrt.
+// Wechselt die Sitzung waehrend des Lesens (Client weg, neuer Dump), wird der Chunk verworfen.
+static portMUX_TYPE dumpMux = portMUX_INITIALIZER_UNLOCKED;
+static uint32_t g_dumpSession = 0;	  // aktive Sitzung, 0 = keine
+static uint32_t g_dumpLastSession = 0; // zuletzt vergebene ID
+static uint32_t g_dumpNext = 0;		  // naechste vom Worker zu lesende Adresse
+static uint32_t g_dumpEnd = 0;		  // exklusiv
+static bool g_dumpAborted = false;
+static uint32_t g_dumpTakenMs = 0; // millis() des letzten Abholens (Stillstandserkennung)
+static uint32_t g_dumpInvalid = 0; // Register ohne Wert (Loch oder Retries erschoepft)
+static bool g_dumpRelearn = false; // Adresskarte fuer den Bereich verwerfen und neu lernen
+static modbus_dump_chunk_t g_dumpRing[MODBUS_DUMP_RING];
+static uint8_t g_dumpHead = 0;
+static uint8_t g_dumpFill = 0;
+
+uint32_t beginModbusDump(uint16_t start, uint32_t count, bool relearn)
+{
+	if (modbusWorkerHandle == nullptr || count == 0)
+	{
+		return 0;
+	}
+	if (count > MODBUS_DUMP_SPAN - start)
+	{
+		count = MODBUS_DUMP_SPAN - start;
+	}
+	uint32_t session = 0;
+	portENTER_CRITICAL(&dumpMux);
+	if (g_dumpSession == 0)
+	{
+		if (++g_dumpLastSession == 0)
+		{
+			g_dumpLastSession = 1;
+		}
+		session = g_dumpSession = g_dumpLastSession;
+		g_dumpNext = start;
+		g_dumpEnd = start + count;
+		g_dumpAborted = false;
+		g_dumpTakenMs = millis();
+		g_dumpInvalid = 0;
+		g_dumpRelearn = relearn;
+		g_dumpHead = 0;
+		g_dumpFill = 0;
+	}
+	portEXIT_CRITICAL(&dumpMux);
+	if (session != 0)
+	{
+		LOGF(LOG_LEVEL_INFO, "Dump %lu: Register %u..%lu", (unsigned long)session, start, (unsigned long)(start + count - 1));
+	}
+	return session;
+}
+
+ModbusDumpPoll takeModbusDumpChunk(uint32_t session, modbus_dump_chunk_t &out)
+{
+	ModbusDumpPoll res = MB_DUMP_WAIT;
+	portENTER_CRITICAL(&dumpMux);
+	if (session == 0 || session != g_dumpSession)
+	{
+		res = MB_DUMP_ABORTED;
+	}
+	else if (g_dumpFill > 0)
+	{
+		out = g_dumpRing[g_dumpHead];
+		g_dumpHead = (g_dumpHead + 1) % MODBUS_DUMP_RING;
+		g_dumpFill--;
+		g_dumpTakenMs = millis();
+		res = MB_DUMP_CHUNK;
+	}
+	else if (g_dumpAborted)
+	{
+		res = MB_DUMP_ABORTED;
+	}
+	else if (g_dumpNext >= g_dumpEnd)
+	{
+		res = MB_DUMP_END;
+	}
+	portEXIT_CRITICAL(&dumpMux);
+	return res;
+}
+
+void endModbusDump(uint32_t session)
+{
+	bool ended = false;
+	uint32_t next = 0;
+	uint32_t end = 0;
+	uint32_t invalid = 0;
+	portENTER_CRITICAL(&dumpMux);
+	if (session != 0 && session == g_dumpSession)
+	{
+		ended = true;
+		next = g_dumpNext;
+		end = g_dumpEnd;
+		invalid = g_dumpInvalid;
+		g_dumpSession = 0;
+		g_dumpFill = 0;
+	}
+	portEXIT_CRITICAL(&dumpMux);
+	if (ended)
+	{
+		// Eine Zeile je Dump statt je Loch: ein Scan ueber den ganzen Adressraum hat hunderte davon.
+		// Zwei Aufrufe mit festem Level: tools/logdecode.py liest die Formatstrings aus dem Quelltext.
+		if (next < end)
+		{
+			LOGF(LOG_LEVEL_WARNING, "Dump %lu vorzeitig beendet, %lu Register ohne Wert", (unsigned long)session, (unsigned long)invalid);
+		}
+		else
+		{
+			LOGF(LOG_LEVEL_INFO, "Dump %lu beendet, %lu Register ohne Wert", (unsigned long)session, (unsigned long)invalid);
+		}
+	}
+}
+
+// Worker: naechsten Chunk der aktiven Sitzung bestimmen. false = nichts zu tun (kein Dump, fertig
+// oder Ring voll). Ein voller Ring, der laenger als MODBUS_DUMP_STALL_MS nicht abgeholt wird, gilt
+// als verwaister Dump (Antwort haengt) -> Sitzung freigeben, damit der naechste /modbusdump nicht
+// blockiert, bis AsyncTCP die tote Verbindung irgendwann verwirft.
+static bool nextDumpChunk(uint32_t &session, uint16_t &start, uint16_t &count, bool &relearn)
+{
+	bool due = false;
+	bool stalled = false;
+	portENTER_CRITICAL(&dumpMux);
+	if (g_dumpSession != 0 && !g_dumpAborted && g_dumpNext < g_dumpEnd)
+	{
+		if (g_dumpFill < MODBUS_DUMP_RING)
+		{
+			session = g_dumpSession;
+			start = (uint16_t)g_dumpNext;
+			uint32_t left = g_dumpEnd - g_dumpNext;
+			count = left > MODBUS_DUMP_CHUNK ? MODBUS_DUMP_CHUNK : (uint16_t)left;
+			relearn = g_dumpRelearn;
+			due = true;
+		}
+		else if ((uint32_t)(millis() - g_dumpTakenMs) > MODBUS_DUMP_STALL_MS)
+		{
+			g_dumpSession = 0; // sofort frei; die haengende Antwort bekommt beim naechsten Abholen ABORTED
+			g_dumpFill = 0;
+			stalled = true;
+		}
+	}
+	portEXIT_CRITICAL(&dumpMux);
+	if (stalled)
+	{
+		log(LOG_LEVEL_WARNING, "Dump abgebrochen: Ring seit " + String(MODBUS_DUMP_STALL_MS / 1000) + " s nicht abgeholt");
+	}
+	return due;
 }
 
-ModbusDumpState modbusDumpState() { return g_dumpState; }
-uint16_t modbusDumpStart() { return g_dumpStart; }
-uint16_t modbusDumpCount() { return g_dumpCount; }
-const uint16_t *modbusDumpValues() { return g_dumpValues; }
-const bool *modbusDumpValid() { return g_dumpValid; }
-void modbusDumpReset() { g_dumpState = MB_DUMP_IDLE; }
+// --- Chunk-Leser mit Loch-Bisektion (Dump, Discovery) ------------------------------------
 
-static void serviceRequest(const ModbusRequest &req)
+static void pushRangeSpan(modbus_range_work_t &w, uint16_t start, uint16_t count)
 {
-	if (req.type == MB_REQ_WRITE)
+	if (w.depth >= MODBUS_RANGE_STACK)
 	{
-		if (writeModbusRegister(req.name, req.value))
+		// Laut static_assert (modbus_base.h) unerreichbar; falls doch: ehrlich als ungueltig zaehlen.
+		LOGF(LOG_LEVEL_ERROR, "Bereichsstapel voll, %u..%u nicht gelesen", start, start + count - 1);
+		w.invalid += count;
+		return;
+	}
+	w.stack[w.depth++] = {start, count, 0};
+}
+
+// Neuer Chunk: bekannte Loecher sofort ungueltig, die lesbaren/unbekannten Abschnitte dazwischen als
+// maximale Bloecke auf den Stapel (von hinten, damit der niedrigste oben liegt).
+void modbusRangeBegin(modbus_range_work_t &w, uint16_t start, uint16_t count, bool relearn)
+{
+	if (relearn)
+	{
+		modbusHolesMark(start, start + count - 1, MODBUS_ADDR_UNKNOWN);
+	}
+	w.chunk.start = start;
+	w.chunk.count = count;
+	memset(w.chunk.valid, 0, sizeof(w.chunk.valid));
+	w.depth = 0;
+	w.invalid = 0;
+	uint16_t runEnd = count; // exklusiv, Offset im Chunk
+	for (int i = count - 1; i >= -1; --i)
+	{
+		bool hole = i >= 0 && modbusHolesState(start + i) == MODBUS_ADDR_UNREADABLE;
+		if (hole || i < 0)
+		{
+			if (runEnd > i + 1)
+			{
+				pushRangeSpan(w, start + i + 1, runEnd - (i + 1));
+			}
+			runEnd = i;
+		}
+		if (hole)
 		{
-			requestPublish(); // Sofort-Feedback aus dem Cache (kein Bus-Read noetig)
+			w.chunk.values[i] = 0;
+			w.invalid++;
 		}
 	}
-	else // MB_REQ_DUMP
+}
+
+// EINE Transaktion fuer den obersten Teilbereich. Frueher las readHoldingRange einen ganzen Bereich
+// samt Retries am Stueck, und ein permanenter Fehler (z.B. Illegal Data Address) machte alle 50
+// Register eines Chunks ungueltig -> lesbare Nachbarn eines Lochs fehlten. Jetzt:
+//   ok                -> Werte gueltig, Bereich als lesbar lernen
+//   transient         -> Bereich bleibt oben liegen, naechster Versuch im naechsten Work-Item
+//                        (bis MODBUS_DUMP_RETRIES, danach ungueltig, ohne etwas zu lernen)
+//   Illegal Data Address, > 1    -> halbieren, beide Haelften auf den Stapel
+//   Illegal Data Address, 1 Reg. -> Loch gefunden: ungueltig, als unlesbar lernen
+//   andere Exception             -> ungueltig, nichts lernen (Slave Device Failure u.ae. sagen nichts
+//                                   ueber die Adresse; als Loch gelernt, plante der Poll beim naechsten
+//                                   Boot dauerhaft um eine gesunde Adresse herum)
+// Fehlschlaege loggen hier nicht je Transaktion (getModbusResultMsg wuerde jede Halbierung als ERROR
+// ins File-Log schreiben); die Aufrufer melden die Summe (w.invalid).
+bool modbusRangeStep(modbus_range_work_t &w)
+{
+	if (w.depth == 0)
+	{
+		return true;
+	}
+	modbus_range_span_t &span = w.stack[w.depth - 1];
+	uint16_t off = span.start - w.chunk.start;
+	awaitBusSlot(6, 3 + 2 * span.count);
+	uint8_t result = rtuReadHoldingRegisters(span.start, span.count, w.chunk.values + off);
+	busGapReport(result, span.attempt == 0);
+	lastModbusResult = result;
+	uint16_t last = span.start + span.count - 1;
+	if (result == MB_RESULT_SUCCESS)
+	{
+		memset(w.chunk.valid + off, true, span.count);
+		modbusHolesMark(span.start, last, MODBUS_ADDR_READABLE);
+		w.depth--;
+	}
+	else if (isTransientModbusError(result))
 	{
-		readHoldingRange(req.start, req.count, req.values, req.valid); // valid[] traegt das Ergebnis
-		if (req.dumpState != nullptr)
+		if (++span.attempt > MODBUS_DUMP_RETRIES)
 		{
-			*req.dumpState = MB_DUMP_DONE; // Webserver-Poll sieht jetzt DONE und rendert
+			LOGF(LOG_LEVEL_DEBUG, "Block %u..%u: Retries erschoepft (result=0x%x)", span.start, last, result);
+			w.invalid += span.count;
+			w.depth--;
 		}
 	}
+	else if (result != MB_RESULT_ILLEGAL_DATA_ADDRESS)
+	{
+		LOGF(LOG_LEVEL_DEBUG, "Block %u..%u: Exception 0x%x, nicht gelernt", span.start, last, result);
+		w.invalid += span.count;
+		w.depth--;
+	}
+	else if (span.count > 1)
+	{
+		modbus_range_span_t failed = span;
+		w.depth--;
+		uint16_t half = failed.count / 2;
+		pushRangeSpan(w, failed.start + half, failed.count - half);
+		pushRangeSpan(w, failed.start, half);
+	}
+	else
+	{
+		LOGF(LOG_LEVEL_DEBUG, "Register %u unlesbar (result=0x%x)", span.start, result);
+		modbusHolesMark(span.start, span.start, MODBUS_ADDR_UNREADABLE);
+		w.invalid++;
+		w.depth--;
+	}
+	return w.depth == 0;
+}
+
+uint8_t modbusReadBlock(uint16_t start, uint16_t count, uint16_t *values)
+{
+	awaitBusSlot(6, 3 + 2 * count);
+	uint8_t result = rtuReadHoldingRegisters(start, count, values);
+	busGapReport(result, true);
+	lastModbusResult = result;
+	return result;
+}
+
+// Chunk des laufenden Dumps (nur Worker-Task).
+static uint32_t g_workSession = 0; // Sitzung, zu der g_dumpWork gehoert (0 = kein Chunk in Arbeit)
+static modbus_range_work_t g_dumpWork;
+
+// Worker: ein Work-Item des Dumps (Aufrufer hat nextDumpChunk() geprueft). Frueher lief ein ganzer Dump
+// samt Retries am Stueck -> Poll und Writes standen Sekunden. Jetzt eine Transaktion je Item; ist der
+// Chunk fertig, geht er in den Ring.
+static void serviceDumpChunk(uint32_t session, uint16_t start, uint16_t count, bool relearn)
+{
+	if (g_workSession != session || g_dumpWork.chunk.start != start)
+	{
+		g_workSession = session;
+		modbusRangeBegin(g_dumpWork, start, count, relearn);
+	}
+	if (!modbusRangeStep(g_dumpWork))
+	{
+		return;
+	}
+	g_workSession = 0;
+	portENTER_CRITICAL(&dumpMux);
+	if (session == g_dumpSession && !g_dumpAborted && g_dumpNext == start && g_dumpFill < MODBUS_DUMP_RING)
+	{
+		g_dumpRing[(g_dumpHead + g_dumpFill) % MODBUS_DUMP_RING] = g_dumpWork.chunk;
+		g_dumpFill++;
+		g_dumpNext = (uint32_t)start + count;
+		g_dumpInvalid += g_dumpWork.invalid;
+	}
+	portEXIT_CRITICAL(&dumpMux);
+}
+
+// --- Fair-Share zwischen Poll und Dump ----------------------------------------------------
+// Writes gehen immer vor (Schaltbefehle). Sind Poll und Dump beide faellig, entscheidet die Buszeit:
+// g_shareLead = Dump-Zeit / Dump-Anteil - Poll-Zeit / Poll-Anteil. Ist der Dump voraus (> 0), ist der
+// Poll dran, sonst der Dump -> ueber die Zeit bekommt der Poll MODBUS_POLL_SHARE_PCT der Buszeit, der
+// Dump den Rest. Ist nur einer faellig, bekommt er alles (Bus bleibt nicht leer). Die Begrenzung auf
+// +-MODBUS_SHARE_MAX_LEAD_MS verhindert, dass eine Klasse waehrend einer langen Ruhe der anderen
+// Guthaben anspart und sie danach aussperrt. Gezaehlt wird die Dauer des ganzen Work-Items (inkl.
+// Bus-Gap und Ruhefenster vor der Transaktion) -> genau die Zeit, die der Bus fuer andere blockiert war.
+// Nur der Worker schreibt; /status liest die Summen (32-Bit-Lesen ist atomar).
+static volatile uint32_t g_busClassMs[MODBUS_CLASS_COUNT];
+static int32_t g_shareLead = 0;
+
+static void chargeBusTime(modbus_bus_class_t cls, uint32_t startMs)
+{
+	uint32_t ms = millis() - startMs;
+	g_busClassMs[cls] += ms;
+	if (cls == MODBUS_CLASS_POLL)
+	{
+		g_shareLead -= (int32_t)(ms * 100 / MODBUS_POLL_SHARE_PCT);
+	}
+	else if (cls == MODBUS_CLASS_DUMP)
+	{
+		g_shareLead += (int32_t)(ms * 100 / (100 - MODBUS_POLL_SHARE_PCT));
+	}
+	g_shareLead = constrain(g_shareLead, -MODBUS_SHARE_MAX_LEAD_MS, MODBUS_SHARE_MAX_LEAD_MS);
+}
+
+uint32_t modbusBusTimeMs(modbus_bus_class_t cls)
+{
+	return cls < MODBUS_CLASS_COUNT ? g_busClassMs[cls] : 0;
+}
+
+// App-Modus: der Bus gehoert der Hersteller-App -> laufenden Dump abbrechen statt ihn haengen zu lassen.
+static void abortModbusDump()
+{
+	bool aborted = false;
+	portENTER_CRITICAL(&dumpMux);
+	if (g_dumpSession != 0 && !g_dumpAborted)
+	{
+		g_dumpAborted = true;
+		aborted = true;
+	}
+	portEXIT_CRITICAL(&dumpMux);
+	if (aborted)
+	{
+		log(LOG_LEVEL_WARNING, "Dump abgebrochen: App-Modus aktiv");
+	}
 }
 
 static void modbusWorkerTask(void *)
 {
-	// Bewusst NICHT beim Task-Watchdog registriert: ein langer /modbusdump (mehrere Chunks in
-	// einem Durchlauf) liefe sonst Gefahr, >5 s ohne Reset zu brauchen -> falscher TWDT-Reset.
-	// Der Watchdog-Schutz kommt stattdessen vom Yielden: jede Iteration endet mit vTaskDelay und
-	// waehrend der Bus-Wartezeit yieldet modbusIdle() (delay(1)) -> die IDLE-Task laeuft und
-	// fuettert den (IDLE-)Watchdog. Genau das Yielden war der Kern des Fixes von 2026-06-16.
+	// Bewusst NICHT beim Task-Watchdog registriert: ein Write-Batch mit Kollisions-Retries liefe sonst
+	// Gefahr, >5 s ohne Reset zu brauchen -> falscher TWDT-Reset.
+	// Der Watchdog-Schutz kommt stattdessen vom Yielden: jede Iteration blockiert auf der UART-Event-
+	// Queue, entweder beim Warten auf die Antwort (rtuTransaction) oder beim Mithoeren im Leerlauf und
+	// vor dem Senden (rtuListen) -> die IDLE-Task laeuft und fuettert den (IDLE-)Watchdog. Genau das
+	// Yielden war der Kern des Fixes von 2026-06-16.
+	bool scopeRan = false; // Poll nach einer Scope-Aufnahme neu einplanen
+#ifdef ALLOC_BENCH
+	allocBenchRegister(ALLOC_SLOT_WORKER);
+	uint32_t pollAllocs = 0; // Summe ueber die Poll-Transaktionen des laufenden Zyklus
+#endif
 	for (;;)
 	{
 		// Loop-Heartbeat pruefen: bleibt der Loop-Task laenger als LOOP_HEARTBEAT_TIMEOUT_MS stehen
@@ -787,66 +1485,103 @@ static void modbusWorkerTask(void *)
 		int32_t sinceHeartbeat = (int32_t)(now - last);
 		if (sinceHeartbeat > (int32_t)LOOP_HEARTBEAT_TIMEOUT_MS)
 		{
-			log(LOG_LEVEL_ERROR, "Loop-Heartbeat seit " + String(sinceHeartbeat) + " ms aus -> Loop-Task eingefroren, ESP.restart()");
-			delay(100); // Sicherheitsmarge fuers File-Log-Flush vor dem Neustart
+			LOGF(LOG_LEVEL_ERROR, "Loop-Heartbeat seit %ld ms aus -> Loop-Task eingefroren, ESP.restart()", (long)sinceHeartbeat);
+			flushFileLog(); // Ring ins Flash, sonst fehlt genau diese Zeile nach dem Neustart
 			ESP.restart();
 		}
 
 		// App-Modus: der Bus gehoert der Hersteller-App (WBR3D an) -> nicht anfassen. Anstehende
 		// Requests sofort fehlschlagend quittieren, damit Aufrufer nicht in den Timeout laufen.
+		// Statt zu schlafen wird mitgehoert: der Sniffer fuellt den Cache aus dem Tuya-Verkehr.
 		if (isAppControlMode())
 		{
-			ModbusRequest req;
-			while (xQueueReceive(modbusRequestQueue, &req, 0) == pdTRUE)
-			{
-				if (req.type == MB_REQ_DUMP)
-				{
-					// Bus gehoert der App -> nicht lesen; Dump als fertig (alle ungueltig) quittieren,
-					// damit der Webserver-Poll nicht in MB_DUMP_RUNNING haengen bleibt.
-					if (req.dumpState != nullptr) *req.dumpState = MB_DUMP_DONE;
-				}
-				else
-				{
-					log(LOG_LEVEL_WARNING, "Write im App-Modus verworfen: " + String(req.name));
-				}
-			}
-			vTaskDelay(pdMS_TO_TICKS(200));
+			abortModbusDump();
+			scopeStop("app");
+			dropPendingWrites();
+			rtuListen(200);
+			continue;
+		}
+
+		// Writes haben Vorrang vor allem anderen (Schaltbefehle reagieren ohne Poll-/Dump-Latenz): alles,
+		// was bis hierher aufgelaufen ist, geht koalesziert in moeglichst wenige Transaktionen. Poll und
+		// Dump sind je EINE Transaktion pro Iteration -> ein Write wartet hoechstens eine Transaktion.
+		uint32_t itemMs = millis();
+		if (pendingWritesAny)
+		{
+			serviceWrites();
+			chargeBusTime(MODBUS_CLASS_WRITE, itemMs);
+			continue;
+		}
+		// Scope-Aufnahme (modbus_scope.h): der Bus gehoert ihr bis zum Ende des Fensters; Poll, Dump und
+		// Discovery pausieren. Danach alle Poll-Ranges sofort faellig (wie beim Boot), statt die
+		// aufgelaufene Verspaetung als Jitter zu melden.
+		if (scopeActive())
+		{
+			serviceScope();
+			chargeBusTime(MODBUS_CLASS_SCOPE, itemMs);
+			scopeRan = true;
+			continue;
+		}
+		if (scopeRan)
+		{
+			scopeRan = false;
+			initPollSchedule();
+		}
+		uint32_t dumpSession;
+		uint16_t dumpStart;
+		uint16_t dumpCount;
+		bool dumpRelearn;
+		bool dumpDue = nextDumpChunk(dumpSession, dumpStart, dumpCount, dumpRelearn);
+		uint32_t idleMs = modbusPollIdleMs();
+		if (dumpDue && (idleMs > 0 || g_shareLead <= 0))
+		{
+			serviceDumpChunk(dumpSession, dumpStart, dumpCount, dumpRelearn); // Bus-Abstand haelt awaitBusSlot()
+			chargeBusTime(MODBUS_CLASS_DUMP, itemMs);
 			continue;
 		}
 
-		// Requests haben Vorrang vor dem Poll (Schaltbefehle reagieren ohne Poll-Latenz).
-		ModbusRequest req;
-		if (xQueueReceive(modbusRequestQueue, &req, 0) == pdTRUE)
+		// Discovery (modbus_discovery.h) nur mit dem, was uebrig bleibt: kein Write, kein Dump-Chunk,
+		// Poll erst spaeter faellig. Die eigene Drossel (MODBUS_DISCOVERY_ITEM_GAP_MS) haelt den Bus
+		// auch dann ueberwiegend frei fuer Display und App.
+		if (idleMs > 0 && discoveryDue())
 		{
-			serviceRequest(req);
-			vTaskDelay(pdMS_TO_TICKS(MODBUS_TX_SPACING_MS)); // Bus-Abstand nach der Transaktion
+			serviceDiscovery();
+			chargeBusTime(MODBUS_CLASS_DISCOVERY, itemMs);
 			continue;
 		}
 
-		// Sonst: eine Poll-Range lesen (fillRegisterValues = genau eine Transaktion pro Aufruf).
+		// Nichts faellig: bis zur naechsten Faelligkeit den Bus mithoeren (rtuListen blockiert auf der
+		// UART-Event-Queue), damit der Arbiter Periode/Phase des Displays auch in Ruhephasen verfolgt.
+		// In Scheiben von MODBUS_LISTEN_SLICE_MS -> ein neuer Write wartet hoechstens so lange.
+		if (idleMs > 0)
+		{
+			rtuListen(idleMs < MODBUS_LISTEN_SLICE_MS ? idleMs : MODBUS_LISTEN_SLICE_MS);
+			continue;
+		}
+
+		// Sonst: den ueberfaelligsten Poll-Range lesen (fillRegisterValues = genau eine Transaktion,
+		// davor wartet awaitBusSlot() die Restluecke und ein Ruhefenster des Displays ab).
+#ifdef ALLOC_BENCH
+		uint32_t allocsBefore = allocBenchCount(ALLOC_SLOT_WORKER);
+#endif
 		bool cycleDone = fillRegisterValues();
+#ifdef ALLOC_BENCH
+		pollAllocs += allocBenchCount(ALLOC_SLOT_WORKER) - allocsBefore;
+#endif
+		chargeBusTime(MODBUS_CLASS_POLL, itemMs);
 		if (cycleDone)
 		{
+#ifdef ALLOC_BENCH
+			allocPollCycle = pollAllocs;
+			pollAllocs = 0;
+#endif
 			requestPublish();
-			vTaskDelay(pdMS_TO_TICKS(MODBUS_SCANRATE_MS)); // Pause zwischen vollen Poll-Zyklen
-		}
-		else
-		{
-			vTaskDelay(pdMS_TO_TICKS(MODBUS_POLL_INTERVAL_MS)); // Abstand zwischen Transaktionen
 		}
 	}
 }
 
 void startModbusWorker()
 {
-	if (registerCacheMutex == nullptr)
-	{
-		registerCacheMutex = xSemaphoreCreateMutex();
-	}
-	if (modbusRequestQueue == nullptr)
-	{
-		modbusRequestQueue = xQueueCreate(8, sizeof(ModbusRequest));
-	}
 	// Heartbeat-Baseline: gibt dem Waechter eine volle Karenzzeit, bevor der Loop-Task das erste
 	// Mal feedet (kein Fehl-Reboot, falls der Loop im Anlauf kurz spaeter dran ist).
 	g_lastLoopHeartbeatMs = millis();
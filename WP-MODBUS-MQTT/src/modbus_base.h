@@ -3,9 +3,14 @@
 
 
 
-#include <ModbusMaster.h>
 #include <ArduinoJson.h>
 #include "modbus_registers.h"
+#include "modbus_faults.h"
+#include "modbus_rtu.h"
+#include "modbus_gap.h"
+#include "modbus_holes.h"
+#include "modbus_arbiter.h"
+#include "modbus_sniffer.h"
 #include "log.h"
 #include "Arduino.h"
 
@@ -29,34 +34,53 @@
 #define MODBUS_TIMEOUT 1000
 #define MODBUS_UNIT 1
 #define MODBUS_RETRIES 2
-// Inter-Transaktions-Abstand vor einem per MQTT injizierten Write (wie Poll-Tick): ein Write
-// kann direkt nach einer Poll-Transaktion kommen, dieser Slave verschluckt dann die zu dicht
-// folgende Transaktion -> der 1. Versuch lief sonst in den ~2 s-Timeout.
+// Inter-Transaktions-Abstand: dieser Slave verschluckt eine zu dicht folgende Transaktion -> der
+// 1. Versuch lief sonst in den Timeout (Diagnose 2026-06-15). Seit dem adaptiven Bus-Gap
+// (modbus_gap.h) nur noch STARTWERT, bis ein gelernter Wert aus LittleFS vorliegt.
 #define MODBUS_TX_SPACING_MS 500
 // Bei Buskollisionen mit dem Tuya-Master (Invalid Slave ID / Invalid CRC / Timeout)
 // deutlich mehr Versuche, bis ein Fenster ohne Fremdverkehr erwischt wird.
 // Hoch lassen, auch bei stillgelegtem WBR3: das Display selbst pollt weiter gelegentlich
 // über A/B und verursacht seltene Restkollisionen. Praxis zeigt: damit laeuft es stabil.
+// Seit dem Listen-before-talk-Arbiter (modbus_arbiter.h) nur noch Rueckfallebene: eigene Anfragen
+// starten erst in vorhergesagten Ruhefenstern des Displays, Retries sollten die Ausnahme sein.
 // Gilt NUR fuer den Read-Poller (fillRegisterValues): dort ist jeder Versuch ein eigener
-// Poll-Tick (1 Transaktion/Aufruf, currentTryIndex ueber Ticks) -> nie eine lange
+// Poll-Tick (1 Transaktion/Aufruf, Fehlversuche je Range ueber Ticks) -> nie eine lange
 // CPU-Blockade, fuer den Watchdog harmlos.
 #define MODBUS_RETRIES_BUS_COLLISION 30
 // Eigenes, KLEINES Budget fuer den per MQTT injizierten Write (writeModbusRegister): dort
 // laufen die Versuche als enge for-Schleife in EINEM Aufruf, jeder writeSingleRegister
-// blockiert ~1 Timeout per Busy-Wait. Mit 30 Versuchen ergab das ~30-60 s CPU-Blockade ohne
-// yield -> IDLE-Task verhungert -> Task-Watchdog-Reset (Crash 2026-06-16). 6 Versuche bremst
-// das hart; zusaetzlich yieldet writeModbusRegister zwischen den Versuchen (siehe dort).
+// blockierte (ModbusMaster-Lib) ~1 Timeout per Busy-Wait. Mit 30 Versuchen ergab das ~30-60 s
+// CPU-Blockade ohne yield -> IDLE-Task verhungert -> Task-Watchdog-Reset (Crash 2026-06-16).
+// 6 Versuche bremst das hart; zusaetzlich yieldet writeModbusRegister zwischen den Versuchen.
 #define MODBUS_WRITE_RETRIES_BUS_COLLISION 6
 
 // Block-Read fuer den Webserver-Registerdump.
-#define MODBUS_DUMP_CHUNK 50   // Register pro Block-Transaktion (<= ku8MaxBufferSize = 64)
+#define MODBUS_DUMP_CHUNK 50   // Register pro Block-Transaktion (<= RTU_MAX_READ_REGS = 64)
 #define MODBUS_DUMP_RETRIES 2  // Wiederholungen pro Chunk nur bei transientem (Kollisions-)Fehler
+// Fair-Share im Worker: Writes gehen immer vor. Sind Poll und Dump beide faellig, bekommt der Poll
+// mindestens MODBUS_POLL_SHARE_PCT der Buszeit, der Dump den Rest; ist nur einer faellig, bekommt er
+// alles. Mehr als MODBUS_SHARE_MAX_LEAD_MS Guthaben spart keine Klasse an (siehe chargeBusTime).
+#define MODBUS_POLL_SHARE_PCT 50
+#define MODBUS_SHARE_MAX_LEAD_MS 2000
 
-// Bus-Timing des Worker-Tasks (frueher in main.cpp). Der Worker liest eine Range pro Iteration
-// und legt zwischen den Transaktionen MODBUS_POLL_INTERVAL_MS Pause ein (Slave-Erholzeit, per
-// Diagnose 2026-06-15 bestaetigt), zwischen vollen Poll-Zyklen MODBUS_SCANRATE_MS.
-#define MODBUS_POLL_INTERVAL_MS 500
-#define MODBUS_SCANRATE_MS 1000
+// Laengster Schlaf des Workers am Stueck, wenn nichts faellig ist. Er hoert dabei den Bus mit
+// (rtuListen) statt auf der Request-Queue zu blockieren -> ein neuer Write wartet hoechstens so lange.
+#define MODBUS_LISTEN_SLICE_MS 50
+
+// Bus-Timing des Worker-Tasks (frueher in main.cpp). Der Worker liest eine Range pro Iteration;
+// den Abstand zwischen den Transaktionen (Slave-Erholzeit) haelt busGapWait() vor jeder Transaktion.
+// Refresh-Perioden der Poll-Klassen (poll_class_t in modbus_registers.h) fuer den Deadline-Scheduler.
+// Ersetzt den festen Zyklus (alle Ranges + MODBUS_SCANRATE_MS Pause): ein_aus/modus/Fehler kommen so
+// alle 2 s statt nur so schnell wie der langsamste Kandidat, die _v-Register belasten den Bus kaum noch.
+// Buslast (Plan siehe modbus_poll_plan.h): schnell 26..39 + 92..132 alle 2 s, normal 41..75 alle 10 s
+// (Sollwerte und _v-Register fahren mit) = ~1,1 Transaktionen/s wie der feste Zyklus (26..75 + 92..132
+// je ~1,8 s), aber ~75 statt ~115 Byte/s auf dem Bus.
+#define MODBUS_POLL_PERIOD_FAST_MS 2000
+#define MODBUS_POLL_PERIOD_NORMAL_MS 10000
+#define MODBUS_POLL_PERIOD_SLOW_MS 60000
+// /data wird sofort bei einer Wertaenderung publiziert, ohne Aenderung spaetestens nach dieser Zeit.
+#define MODBUS_PUBLISH_MAX_AGE_MS 10000
 
 // Loop-Heartbeat-Waechter: der Loop-Task ruft feedLoopHeartbeat() jede Iteration. Der Worker-Task
 // (laeuft unabhaengig auf Core 0 weiter, auch wenn der Loop haengt) rebootet den ESP, falls der
@@ -65,8 +89,9 @@
 // synchroner WebServer-Klasse und AsyncTCP), das KEIN Watchdog erkennt: der Loop-Task ist nicht
 // beim TWDT registriert und die IDLE-Task laeuft bei einem blockierenden Hang weiter -> stiller
 // Freeze, bisher nur per Stromstecken behebbar (Befund 2026-06-21: Heap/WiFi gesund, Status-Publish
-// aus dem Loop-Task hoerte auf -> Loop eingefroren). Schwelle deutlich > laengster legitimer
-// Loop-Block: /modbusdump blockiert den Loop bis ~20 s (Semaphore-Wait im HTTP-Handler).
+// aus dem Loop-Task hoerte auf -> Loop eingefroren). Schwelle grosszuegig > laengster legitimer
+// Loop-Block (Publish, Sichern der Adresskarte: deutlich unter 1 s); /modbusdump blockiert den Loop
+// nicht mehr, seit der Dump ueber den Chunk-Ring gestreamt wird.
 #define LOOP_HEARTBEAT_TIMEOUT_MS 60000
 
 
@@ -75,10 +100,121 @@ void postTransmission();
 void initModbus();
 bool writeModbusRegister(const char *register_name, uint16_t value);
 bool fillRegisterValues();
-void writeRegisterValuesToJson(ArduinoJson::JsonVariant variant);
+// Deadline-Scheduler: ms bis der naechste Poll-Range faellig ist (0 = jetzt) bzw. groesste Start-
+// Verspaetung eines Range-Reads seit dem letzten Aufruf (setzt zurueck; fuer das /status-JSON).
+uint32_t modbusPollIdleMs();
+uint32_t modbusPollJitterMaxMs();
+// Buszeit je Klasse seit Boot in ms (Dauer der Work-Items inkl. Bus-Gap/Ruhefenster; /status-JSON).
+enum modbus_bus_class_t
+{
+	MODBUS_CLASS_WRITE,
+	MODBUS_CLASS_POLL,
+	MODBUS_CLASS_DUMP,
+	MODBUS_CLASS_DISCOVERY,
+	MODBUS_CLASS_SCOPE,
+	MODBUS_CLASS_COUNT
+};
+uint32_t modbusBusTimeMs(modbus_bus_class_t cls);
+
+// --- Register-Snapshot -----------------------------------------------------------------
+// Konsistenter Stand aller Registerwerte + Fault-Cache, wie ihn der Worker zuletzt committet hat
+// (Zyklus-Ende, bestaetigter Write, Sniff). Lesen blockiert nie und haelt den Worker nie auf
+// (Seqlock ueber zwei Puffer, siehe modbus_base.cpp) -> ersetzt lockRegisterCache()/unlock.
+#define MODBUS_NUM_REGISTERS (sizeof(registers) / sizeof(modbus_register_t))
+#define MODBUS_NUM_FAULT_REGS (sizeof(faultRegisters) / sizeof(fault_register_t))
+typedef struct
+{
+	uint32_t generation;						// zaehlt je Commit hoch (0 = noch nie committet)
+	uint16_t values[MODBUS_NUM_REGISTERS];		// Rohwerte parallel zu registers[], 0xFFFF = ungueltig
+	uint16_t faultValue[MODBUS_NUM_FAULT_REGS]; // parallel zu faultRegisters[]
+	bool faultValid[MODBUS_NUM_FAULT_REGS];
+	uint32_t sniffedMs[MODBUS_NUM_REGISTERS];	// millis() des letzten Sniffs, 0 = nie
+} register_snapshot_t;
+// Kopiert den aktuellen Snapshot nach out (aus jedem Task). false, solange nie committet wurde.
+bool readRegisterSnapshot(register_snapshot_t &out);
+// only (optional, parallel zu registers[]): nur die markierten Register schreiben (Delta-Publish).
+void writeRegisterValuesToJson(const register_snapshot_t &snap, ArduinoJson::JsonVariant variant, const bool *only = nullptr);
+// Totband-Vergleich fuer registers[index] (modbus_register_t::deadband): true, wenn now gegenueber
+// dem zuletzt publizierten Rohwert ref als Aenderung zaehlt. Wechsel von/nach 0xFFFF (ungueltig)
+// und Bitfeld-Aenderungen zaehlen immer; Diematic-Werte werden vorzeichenrichtig verglichen.
+bool registerChanged(uint8_t index, uint16_t ref, uint16_t now);
 String getModbusState();
-bool readHoldingRange(uint16_t start_id, uint16_t count, uint16_t *values, bool *valid);
-void writeFaultStatusToJson(ArduinoJson::JsonVariant variant);
+void writeFaultStatusToJson(const register_snapshot_t &snap, ArduinoJson::JsonVariant variant);
+// "sniffed_age_s": {name: Sekunden} fuer alle Register, die der passive Sniffer schon einmal aus
+// fremdem Busverkehr uebernommen hat (Alter des letzten Sniffs).
+void writeSniffFreshnessToJson(const register_snapshot_t &snap, ArduinoJson::JsonVariant variant);
+
+// --- /data-JSON: Obergrenze zur Compilezeit --------------------------------------------
+// Laengstes moegliches /data-Dokument (writeRegisterValuesToJson + writeFaultStatusToJson +
+// writeSniffFreshnessToJson), aus registers[]/faultRegisters[] berechnet. Damit serialisiert
+// publishModbusData in einen statischen Puffer statt measureJson + malloc je Publish.
+constexpr size_t jsonStrLen(const char *s)
+{
+	size_t n = 0;
+	while (s[n] != 0)
+	{
+		++n;
+	}
+	return n;
+}
+// "name":wert, — Wert hoechstens 5 Stellen (U16) bzw. 12 Zeichen (Diematic als float), Bits 1 Zeichen.
+constexpr size_t jsonRegistersMaxLen()
+{
+	size_t n = 0;
+	for (const modbus_register_t &reg : registers)
+	{
+		switch (reg.type)
+		{
+		case REGISTER_TYPE_U16:
+			n += jsonStrLen(reg.name) + 3 + 5 + 1;
+			break;
+		case REGISTER_TYPE_DIEMATIC_ONE_DECIMAL:
+			n += jsonStrLen(reg.name) + 3 + 12 + 1;
+			break;
+		case REGISTER_TYPE_BITFIELD:
+			for (const char *bit : reg.optional_param.bitfield)
+			{
+				if (bit == nullptr)
+				{
+					break;
+				}
+				n += jsonStrLen(bit) + 3 + 1 + 1;
+			}
+			break;
+		default:
+			break; // DEBUG: nur geloggt, nicht im JSON
+		}
+	}
+	return n;
+}
+// "faults":[...],"fault_active":false, — je Bit ein Label bzw. ein generierter Code ("E17").
+constexpr size_t jsonFaultsMaxLen()
+{
+	size_t n = 11 + 1 + 20 + 1;
+	for (const fault_register_t &fr : faultRegisters)
+	{
+		if (fr.modbus_addr == FAULT_ADDR_TODO)
+		{
+			continue;
+		}
+		for (uint8_t b = 0; b < fr.bit_count && b < 16; ++b)
+		{
+			n += (fr.labels[b] != nullptr ? jsonStrLen(fr.labels[b]) : 4) + 2 + 1;
+		}
+	}
+	return n;
+}
+// "sniffed_age_s":{"name":sekunden,...}
+constexpr size_t jsonSniffMaxLen()
+{
+	size_t n = 18;
+	for (const modbus_register_t &reg : registers)
+	{
+		n += jsonStrLen(reg.name) + 3 + 10 + 1;
+	}
+	return n;
+}
+constexpr size_t kModbusDataJsonMax = 2 + jsonRegistersMaxLen() + jsonFaultsMaxLen() + jsonSniffMaxLen() + 1;
 
 // --- Modbus-Worker-Task (alleiniger Bus-Owner) + Request-API ---------------------------
 // Genau EIN FreeRTOS-Task besitzt den RS485-Bus. Poll, Write und Web-Dump werden zu Requests,
@@ -88,34 +224,91 @@ void startModbusWorker();
 // Vom Loop-Task jede Iteration aufgerufen: aktualisiert den Heartbeat-Zeitstempel, den der
 // Worker-Task ueberwacht (Selbstheilung bei eingefrorenem Loop-Task, siehe LOOP_HEARTBEAT_TIMEOUT_MS).
 void feedLoopHeartbeat();
-// Reiht einen Schreibbefehl ein (non-blocking, aus jedem Task — z.B. dem MQTT-Callback).
+// Reiht einen Schreibbefehl ein (non-blocking, aus jedem Task — z.B. dem MQTT-Callback). Steht fuer
+// das Register schon ein noch nicht gesendeter Wert an, wird er ersetzt (last writer wins); der
+// ueberholte Wert erscheint im Write-Result. false nur bei unbekanntem Registernamen.
 bool enqueueModbusWrite(const char *register_name, uint16_t value);
+// Ergebnis je geschriebenem Register, vom Worker erzeugt, vom Loop-Task konsumiert (MQTT .../write_result).
+#define MODBUS_WRITE_SUPERSEDED_KEEP 4 // so viele ueberholte Werte je Register werden gemeldet
+#define MODBUS_WRITE_RESULT_QUEUE 8	   // ungelesene Ergebnisse, danach wird das aelteste verworfen
+typedef struct
+{
+	const char *name; // registers[].name (statisch)
+	uint16_t value;	  // geschriebener (juengster) Rohwert
+	bool ok;
+	uint8_t batch;		// Zahl der Register in derselben Transaktion (1 = FC06, >1 = FC16)
+	uint8_t superseded; // Zahl der ueberholten, nie gesendeten Werte
+	uint16_t supersededValues[MODBUS_WRITE_SUPERSEDED_KEEP]; // die juengsten davon, aelteste zuerst
+} modbus_write_result_t;
+bool consumeModbusWriteResult(modbus_write_result_t &out);
 
-// --- Non-blocking Register-Dump fuer den asynchronen Webserver -------------------------
-// Frueher blockierte modbusDump() den Aufrufer bis zu 20 s auf eine Semaphore — im AsyncTCP-
-// Handler (ESPAsyncWebServer) verboten. Jetzt: requestModbusDump() reiht einen Dump ein und
-// kehrt sofort zurueck; der Worker fuellt interne Puffer und setzt den Status auf MB_DUMP_DONE.
-// Der Webserver pollt modbusDumpState() (Auto-Refresh-Seite) und rendert bei DONE aus den
-// Accessor-Puffern, dann modbusDumpReset() -> der naechste Aufruf startet einen frischen Dump.
-#define MODBUS_DUMP_MAX 201 // max. Registeranzahl pro Dump (statischer Puffer im Worker)
-enum ModbusDumpState
+// --- Streamender Register-Dump fuer den asynchronen Webserver ---------------------------
+// Frueher: requestModbusDump() scannte hoechstens MODBUS_DUMP_MAX (201) Register in statische
+// Puffer, der Webserver renderte erst nach dem kompletten Scan (Warteseite + Reload). Jetzt laeuft
+// ein Dump als Sitzung: der Worker liest je Work-Item EINEN Chunk (MODBUS_DUMP_CHUNK Register,
+// im Fair-Share mit dem Poll, siehe MODBUS_POLL_SHARE_PCT) und legt ihn in einen kleinen Ring (MODBUS_DUMP_RING Plaetze); die HTTP-Antwort (chunked) holt die
+// Chunks per takeModbusDumpChunk() ab, sobald sie da sind. Ist der Ring voll, pausiert der Dump und
+// der Worker pollt normal weiter -> ein langsamer Client bremst nur seinen eigenen Dump. RAM ist
+// damit unabhaengig von der Dump-Laenge (ganzer Adressraum 0..65535 moeglich), die ersten Zeilen
+// kommen nach dem ersten Chunk. Es gibt hoechstens EINE Sitzung zugleich (ein Bus).
+#define MODBUS_DUMP_RING 4				// Chunks zwischen Worker und HTTP-Antwort
+#define MODBUS_DUMP_SPAN 65536UL		// groesste Registeranzahl je Dump (ganzer Adressraum)
+#define MODBUS_DUMP_STALL_MS 30000		// so lange ohne Abholen bei vollem Ring -> Sitzung verwerfen
+typedef struct
+{
+	uint16_t start; // erste Registeradresse des Chunks
+	uint16_t count; // 1..MODBUS_DUMP_CHUNK
+	uint16_t values[MODBUS_DUMP_CHUNK];
+	bool valid[MODBUS_DUMP_CHUNK];
+} modbus_dump_chunk_t;
+enum ModbusDumpPoll
 {
-	MB_DUMP_IDLE,
-	MB_DUMP_RUNNING,
-	MB_DUMP_DONE
+	MB_DUMP_WAIT,	// naechster Chunk noch nicht gelesen
+	MB_DUMP_CHUNK,	// out enthaelt den naechsten Chunk
+	MB_DUMP_END,	// alle Chunks abgeholt
+	MB_DUMP_ABORTED // vom Worker abgebrochen (App-Modus, Stillstand) oder Sitzung ungueltig
 };
-bool requestModbusDump(uint16_t start, uint16_t count); // false, wenn schon laufend oder Queue voll
-ModbusDumpState modbusDumpState();
-uint16_t modbusDumpStart();
-uint16_t modbusDumpCount();
-const uint16_t *modbusDumpValues();
-const bool *modbusDumpValid();
-void modbusDumpReset(); // nach dem Rendern: Status zurueck auf IDLE
+// Startet einen Dump ueber [start, start+count) (count 1..MODBUS_DUMP_SPAN, wird auf das Ende des
+// Adressraums gekuerzt). Liefert die Sitzungs-ID (> 0) oder 0, wenn kein Worker laeuft bzw. schon
+// ein Dump aktiv ist. Non-blocking, aus jedem Task. Bekannte Loecher (modbus_holes.h) liest der Dump
+// nicht erneut; relearn=true verwirft die Adresskarte fuer den Bereich und lernt ihn neu.
+uint32_t beginModbusDump(uint16_t start, uint32_t count, bool relearn = false);
+// Holt den naechsten fertigen Chunk der Sitzung ab (non-blocking, Chunks in Adressreihenfolge).
+ModbusDumpPoll takeModbusDumpChunk(uint32_t session, modbus_dump_chunk_t &out);
+// Beendet die Sitzung (fertig oder Client weg) und gibt den Dump fuer den naechsten frei.
+void endModbusDump(uint32_t session);
+
+// --- Chunk-Leser mit Loch-Bisektion (Dump, Discovery; nur Worker-Task) ------------------
+// Liest einen Chunk (<= MODBUS_DUMP_CHUNK Register) Transaktion fuer Transaktion: bekannte Loecher
+// (modbus_holes.h) werden uebersprungen, ein Bereich mit permanentem Fehler halbiert, bis die
+// unlesbaren Adressen feststehen (und gelernt sind). Teilbereiche liegen auf einem Stapel; Tiefe
+// hoechstens (MODBUS_DUMP_CHUNK+1)/2 Abschnitte zu Beginn (abwechselnd lesbar/Loch) plus eine offene
+// rechte Haelfte je Halbierungsebene (die linke wird zuerst fertig gelesen).
+#define MODBUS_RANGE_BISECT_DEPTH 8 // Halbierungsebenen bis zum Einzelregister
+#define MODBUS_RANGE_STACK ((MODBUS_DUMP_CHUNK + 1) / 2 + MODBUS_RANGE_BISECT_DEPTH)
+static_assert((1u << MODBUS_RANGE_BISECT_DEPTH) >= MODBUS_DUMP_CHUNK, "Stapel zu klein fuer die Halbierung eines vollen Chunks");
+typedef struct
+{
+	uint16_t start;
+	uint16_t count;
+	uint8_t attempt; // bisherige Versuche mit transientem Fehler
+} modbus_range_span_t;
+typedef struct
+{
+	modbus_dump_chunk_t chunk; // Ergebnis: Werte + Gueltigkeit je Register
+	modbus_range_span_t stack[MODBUS_RANGE_STACK];
+	uint8_t depth;	  // offene Teilbereiche (0 = Chunk fertig)
+	uint16_t invalid; // Register ohne Wert (Loch oder Retries erschoepft)
+} modbus_range_work_t;
+// relearn=true verwirft die Adresskarte fuer den Chunk vorher.
+void modbusRangeBegin(modbus_range_work_t &w, uint16_t start, uint16_t count, bool relearn);
+// Genau eine Transaktion (oder keine, wenn nichts mehr offen ist). true = Chunk fertig.
+bool modbusRangeStep(modbus_range_work_t &w);
+// Scope (modbus_scope.h): Block in EINER Transaktion lesen, mit Bus-Gap und Listen-before-talk, ohne
+// Retry und ohne Log je Fehler (bei Sample-Raten um 30/s). Rueckgabe: MB_RESULT_*.
+uint8_t modbusReadBlock(uint16_t start, uint16_t count, uint16_t *values);
+bool isTransientModbusError(uint8_t result);
 // loop() pollt das: liefert einmal true, nachdem der Worker neue Daten bereitgestellt hat
 // (voller Poll-Zyklus oder bestaetigter Write) -> publishModbusData() laeuft so im Loop-Task.
 bool consumeModbusPublishRequest();
-// Schuetzt register_values[]/Fault-Cache: der Worker schreibt darunter, Leser (publishModbusData)
-// nehmen es kurz fuer einen konsistenten Snapshot.
-bool lockRegisterCache(uint32_t timeout_ms);
-void unlockRegisterCache();
 #endif // SRC_MODBUS_BASE_H_
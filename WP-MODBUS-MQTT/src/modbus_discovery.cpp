@@ -0,0 +1,270 @@
+#include "modbus_discovery.h"
+#include "modbus_base.h"
+
+typedef struct
+{
+	uint16_t last;
+	uint16_t min;
+	uint16_t max;
+	uint16_t changes;		// saettigt bei 0xFFFF
+	uint32_t firstChangeMs; // ms seit Start, 0 = nie geaendert
+	uint16_t invalid;		// Snapshots ohne Wert (Loch, Retries erschoepft)
+	bool seen;				// mindestens ein gueltiger Wert
+} discovery_reg_t;
+
+// Parameter und Statistik: vom Webserver (Start/Stop/Bericht, AsyncTCP-Task) und vom Worker
+// (Einfalten eines Chunks) benutzt -> Mutex. gen zaehlt je Start hoch; der Worker verwirft einen
+// Chunk, der noch zu einem alten Lauf gehoert.
+static SemaphoreHandle_t discMutex = nullptr;
+static discovery_reg_t *discRegs = nullptr;
+static volatile bool discActive = false;
+static uint32_t discGen = 0;
+static uint16_t discStart = 0;
+static uint16_t discCount = 0;
+static uint32_t discPeriodMs = 0;
+static uint32_t discStartedMs = 0;
+static uint32_t discStoppedMs = 0;
+static uint32_t discSnapshots = 0;
+
+// Ab hier nur Worker-Task.
+static modbus_range_work_t discWork;
+static uint32_t workGen = 0;
+static bool working = false;   // discWork enthaelt einen angefangenen Chunk
+static uint16_t workOffset = 0; // naechster Chunk (Offset im Bereich)
+static uint32_t snapStartMs = 0;
+static uint32_t nextSnapMs = 0;
+static uint32_t lastItemMs = 0;
+
+bool discoveryStart(uint16_t start, uint16_t count, uint32_t periodS)
+{
+	if (count == 0 || count > MODBUS_DISCOVERY_MAX_REGS || (uint32_t)start + count > 0x10000)
+	{
+		return false;
+	}
+	if (discMutex == nullptr)
+	{
+		discMutex = xSemaphoreCreateMutex();
+	}
+	discovery_reg_t *regs = (discovery_reg_t *)calloc(count, sizeof(discovery_reg_t));
+	if (regs == nullptr)
+	{
+		LOGF(LOG_LEVEL_ERROR, "Discovery: kein RAM fuer %u Register", count);
+		return false;
+	}
+	xSemaphoreTake(discMutex, portMAX_DELAY);
+	free(discRegs);
+	discRegs = regs;
+	discStart = start;
+	discCount = count;
+	discPeriodMs = (periodS < MODBUS_DISCOVERY_MIN_PERIOD_S ? MODBUS_DISCOVERY_MIN_PERIOD_S : periodS) * 1000;
+	discStartedMs = millis();
+	discSnapshots = 0;
+	discGen++;
+	discActive = true;
+	xSemaphoreGive(discMutex);
+	LOGF(LOG_LEVEL_WARNING, "Discovery gestartet: Register %u..%u alle %lu s", start, start + count - 1, (unsigned long)(discPeriodMs / 1000));
+	return true;
+}
+
+void discoveryStop()
+{
+	if (discMutex == nullptr || !discActive)
+	{
+		return;
+	}
+	xSemaphoreTake(discMutex, portMAX_DELAY);
+	discActive = false;
+	discStoppedMs = millis();
+	xSemaphoreGive(discMutex);
+	LOGF(LOG_LEVEL_WARNING, "Discovery angehalten nach %lu Snapshots", (unsigned long)discSnapshots);
+}
+
+// Ordnung des Berichts: mehr Aenderungen zuerst, dann die frueher geaenderten, dann nach Adresse.
+static bool ranksBefore(uint16_t a, uint16_t b)
+{
+	const discovery_reg_t &ra = discRegs[a];
+	const discovery_reg_t &rb = discRegs[b];
+	if (ra.changes != rb.changes)
+	{
+		return ra.changes > rb.changes;
+	}
+	if (ra.firstChangeMs != rb.firstChangeMs)
+	{
+		return ra.firstChangeMs < rb.firstChangeMs;
+	}
+	return a < b;
+}
+
+void discoveryReportToJson(ArduinoJson::JsonVariant doc, uint16_t limit)
+{
+	doc["active"] = (bool)discActive;
+	if (discMutex == nullptr)
+	{
+		return; // noch nie gestartet
+	}
+	xSemaphoreTake(discMutex, portMAX_DELAY);
+	uint32_t endMs = discActive ? millis() : discStoppedMs;
+	doc["start"] = discStart;
+	doc["count"] = discCount;
+	doc["period_s"] = discPeriodMs / 1000;
+	doc["snapshots"] = discSnapshots;
+	doc["running_s"] = (endMs - discStartedMs) / 1000;
+	uint16_t moved = 0;
+	uint16_t unread = 0;
+	for (uint16_t i = 0; i < discCount; ++i)
+	{
+		moved += discRegs[i].changes > 0;
+		unread += !discRegs[i].seen;
+	}
+	doc["moved"] = moved;
+	doc["never_read"] = unread;
+	// Top-N ohne Sortierpuffer: je Runde das beste Register, das in der Ordnung hinter dem zuletzt
+	// gewaehlten liegt (O(limit * count), bei 100 x 512 unter 1 ms).
+	JsonArray list = doc["registers"].to<JsonArray>();
+	int prev = -1;
+	for (uint16_t n = 0; n < limit && n < moved; ++n)
+	{
+		int best = -1;
+		for (uint16_t i = 0; i < discCount; ++i)
+		{
+			if (discRegs[i].changes == 0 || (prev >= 0 && !ranksBefore(prev, i)))
+			{
+				continue;
+			}
+			if (best < 0 || ranksBefore(i, best))
+			{
+				best = i;
+			}
+		}
+		if (best < 0)
+		{
+			break;
+		}
+		const discovery_reg_t &r = discRegs[best];
+		JsonObject o = list.add<JsonObject>();
+		o["reg"] = discStart + best;
+		o["changes"] = r.changes;
+		o["min"] = r.min;
+		o["max"] = r.max;
+		o["last"] = r.last;
+		o["first_change_ms"] = r.firstChangeMs;
+		if (r.invalid > 0)
+		{
+			o["invalid"] = r.invalid;
+		}
+		prev = best;
+	}
+	xSemaphoreGive(discMutex);
+}
+
+// Einen fertigen Chunk in die Statistik einfalten (unter discMutex).
+static void foldChunk(const modbus_dump_chunk_t &chunk, uint16_t offset, uint32_t nowMs)
+{
+	for (uint16_t i = 0; i < chunk.count && offset + i < discCount; ++i)
+	{
+		discovery_reg_t &r = discRegs[offset + i];
+		if (!chunk.valid[i])
+		{
+			if (r.invalid < 0xFFFF)
+			{
+				r.invalid++;
+			}
+			continue;
+		}
+		uint16_t v = chunk.values[i];
+		if (!r.seen)
+		{
+			r.seen = true;
+			r.last = r.min = r.max = v;
+			continue;
+		}
+		if (v != r.last)
+		{
+			if (r.changes < 0xFFFF)
+			{
+				r.changes++;
+			}
+			if (r.firstChangeMs == 0)
+			{
+				r.firstChangeMs = (nowMs - discStartedMs) | 1; // nie 0 (= "nie geaendert")
+			}
+			r.last = v;
+		}
+		r.min = v < r.min ? v : r.min;
+		r.max = v > r.max ? v : r.max;
+	}
+}
+
+bool discoveryDue()
+{
+	if (!discActive)
+	{
+		return false;
+	}
+	uint32_t now = millis();
+	if ((uint32_t)(now - lastItemMs) < MODBUS_DISCOVERY_ITEM_GAP_MS)
+	{
+		return false;
+	}
+	if (workGen != discGen || working || workOffset > 0)
+	{
+		return true; // neuer Lauf bzw. Snapshot in Arbeit
+	}
+	return (int32_t)(now - nextSnapMs) >= 0;
+}
+
+void serviceDiscovery()
+{
+	uint32_t now = millis();
+	lastItemMs = now;
+	xSemaphoreTake(discMutex, portMAX_DELAY);
+	bool active = discActive;
+	uint32_t gen = discGen;
+	uint16_t start = discStart;
+	uint16_t count = discCount;
+	uint32_t periodMs = discPeriodMs;
+	xSemaphoreGive(discMutex);
+	if (!active)
+	{
+		return;
+	}
+	if (gen != workGen)
+	{
+		workGen = gen;
+		working = false;
+		workOffset = 0;
+	}
+	if (!working)
+	{
+		if (workOffset == 0)
+		{
+			snapStartMs = now;
+		}
+		uint16_t n = count - workOffset > MODBUS_DUMP_CHUNK ? MODBUS_DUMP_CHUNK : count - workOffset;
+		modbusRangeBegin(discWork, start + workOffset, n, false);
+		working = true;
+	}
+	if (!modbusRangeStep(discWork))
+	{
+		return;
+	}
+	working = false;
+	uint16_t offset = workOffset;
+	workOffset += discWork.chunk.count;
+	bool snapDone = workOffset >= count;
+	if (snapDone)
+	{
+		workOffset = 0;
+		nextSnapMs = snapStartMs + periodMs;
+	}
+	xSemaphoreTake(discMutex, portMAX_DELAY);
+	if (discActive && discGen == gen)
+	{
+		foldChunk(discWork.chunk, offset, millis());
+		if (snapDone)
+		{
+			discSnapshots++;
+		}
+	}
+	xSemaphoreGive(discMutex);
+}
@@ -0,0 +1,38 @@
+#ifndef SRC_MODBUS_DISCOVERY_H_
+#define SRC_MODBUS_DISCOVERY_H_
+
+#include <ArduinoJson.h>
+#include "Arduino.h"
+
+// Discovery-Modus: der "Dump-Diff" auf dem Geraet. registers[] und modbus_faults.h entstanden aus
+// CSV-Dumps, die von Hand ueber verschiedene Anlagenzustaende verglichen wurden (Stunden je Runde).
+// Jetzt nimmt der Worker im Hintergrund periodisch Snapshots eines Adressbereichs auf und fuehrt je
+// Register mit: Zahl der Aenderungen, Min/Max, letzter Wert, Zeitpunkt der ersten Aenderung. Der
+// Bericht (discoveryReportToJson, GET /api/discovery) listet die Register, die sich bewegt haben,
+// nach Zahl der Aenderungen sortiert.
+//
+// Gelesen wird mit dem Chunk-Leser des Dumps (modbusRangeBegin/-Step: bekannte Loecher aus der
+// Adresskarte werden uebersprungen, neue per Halbierung gefunden). Gedrosselt: niedrigste Prioritaet
+// im Worker (nur wenn weder Write, Poll noch Dump faellig ist) und hoechstens eine Transaktion je
+// MODBUS_DISCOVERY_ITEM_GAP_MS; ein Snapshot beginnt fruehestens eine Periode nach dem vorigen.
+// Die Statistik liegt im RAM (je Register 16 Byte) und ist nach einem Neustart weg.
+#define MODBUS_DISCOVERY_MAX_REGS 512		 // groesster Bereich (8 KB Statistik)
+#define MODBUS_DISCOVERY_DEFAULT_PERIOD_S 60 // Abstand der Snapshots
+#define MODBUS_DISCOVERY_MIN_PERIOD_S 10
+#define MODBUS_DISCOVERY_ITEM_GAP_MS 1000 // Drossel: Mindestabstand zweier Discovery-Transaktionen
+#define MODBUS_DISCOVERY_REPORT_MAX 100	  // hoechstens so viele Register im Bericht
+
+// Startet (bzw. startet neu) ueber [start, start+count) mit frischer Statistik. false, wenn der Bereich
+// leer/zu gross ist oder kein RAM frei ist. Aus jedem Task (Webserver).
+bool discoveryStart(uint16_t start, uint16_t count, uint32_t periodS);
+// Haelt an; die Statistik bleibt bis zum naechsten Start abrufbar.
+void discoveryStop();
+// Bericht: Parameter, Zahl der Snapshots und die bis zu limit Register mit den meisten Aenderungen
+// (bei Gleichstand die frueher geaenderten zuerst).
+void discoveryReportToJson(ArduinoJson::JsonVariant doc, uint16_t limit);
+
+// Worker-Task (modbus_base.cpp): steht eine Discovery-Transaktion an bzw. eine ausfuehren.
+bool discoveryDue();
+void serviceDiscovery();
+
+#endif // SRC_MODBUS_DISCOVERY_H_
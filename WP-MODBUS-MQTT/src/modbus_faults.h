@@ -2,6 +2,7 @@
 #define SRC_MODBUS_FAULTS_H_
 
 #include "Arduino.h"
+#include "modbus_registers.h" // poll_class_t
 
 // ============================================================================
 // Geraete-Fehlercodes der Pumpe (Tuya-Fault-DPs), vorbereitet zum Dekodieren.
@@ -34,11 +35,12 @@ typedef struct
 	uint8_t first_code;		 // Codenummer von Bit 0 (nur bei generierten Codes)
 	uint8_t bit_count;		 // wie viele Bits dieses Registers gueltig sind (<= 16)
 	const char *labels[16];	 // explizite Labels Bit0..Bit15; nullptr -> Code generieren
+	poll_class_t poll_class = POLL_CLASS_NORMAL; // Refresh-Klasse (weglassbar), siehe modbus_registers.h
 } fault_register_t;
 
 // Hinweis zu mehr-als-16-Bit-DPs: pro 16-Bit-Modbus-Register ein Eintrag (lo/hi).
 // Beim Eintragen der Adressen sind lo- und hi-Wort i.d.R. aufeinanderfolgende Register.
-const fault_register_t faultRegisters[] = {
+constexpr fault_register_t faultRegisters[] = {
 	// --- Haupt-Stoerung (benanntes Public-Bitmap) -- enthaelt flow_fault (Bit 2) ---
 	{FAULT_ADDR_TODO, "fault_main", 0, 0, 16, {
 		"sys_high_fault",  // Bit 0: Hochdruck
@@ -66,8 +68,9 @@ const fault_register_t faultRegisters[] = {
 	// BESTAETIGT per Dump-Diff (clean vs. provozierter Flow-Fehler): Reg 26 = lo, Reg 27 = hi.
 	// Im Fehlerfall ("Flow Control", Wasserpumpe aus) zeigt das Display E17 -> Reg 27 == 1 (Bit 0,
 	// first_code 17 -> E17). Damit ist die DP103->Register-Abbildung dieser Pumpe eindeutig.
-	{26, "new_fault_01_lo", 'E', 1, 16, {nullptr}},  // DP103: E01..E16
-	{27, "new_fault_01_hi", 'E', 17, 14, {nullptr}}, // DP103: E17..E30
+	// Fehler sollen schnell nach MQTT -> POLL_CLASS_FAST.
+	{26, "new_fault_01_lo", 'E', 1, 16, {nullptr}, POLL_CLASS_FAST},  // DP103: E01..E16
+	{27, "new_fault_01_hi", 'E', 17, 14, {nullptr}, POLL_CLASS_FAST}, // DP103: E17..E30
 	{FAULT_ADDR_TODO, "new_fault_02", 'E', 31, 13, {nullptr}},    // DP107: E31..E43
 	{FAULT_ADDR_TODO, "fault_2_lo", 'E', 30, 16, {nullptr}},      // DP118: E30..E45
 	{FAULT_ADDR_TODO, "fault_2_hi", 'E', 46, 14, {nullptr}},      // DP118: E46..E59
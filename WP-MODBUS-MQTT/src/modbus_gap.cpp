@@ -0,0 +1,132 @@
+#include "modbus_gap.h"
+#include "modbus_base.h"
+#include <ArduinoJson.h>
+#include <LittleFS.h>
+#include <esp_timer.h>
+
+// Nur vom Worker-Task geschrieben; busGapMs()/busGapFirstTryPct() lesen aus dem Loop-Task (Status).
+static volatile uint32_t gapMs = MODBUS_TX_SPACING_MS;
+// Sichern: der Worker merkt nur vor (saveDirty), geschrieben wird aus dem Loop-Task
+// (busGapSaveIfDirty) -- keine Flash-I/O im Bus-Worker. gapMux schuetzt die drei Werte.
+static portMUX_TYPE gapMux = portMUX_INITIALIZER_UNLOCKED;
+static uint32_t savedGapMs = MODBUS_TX_SPACING_MS;
+static uint32_t lastSaveMs = 0;
+static bool saveDirty = false;
+static uint16_t successStreak = 0;
+// Erstversuch-Statistik als gleitendes Fenster (Zaehler halbieren, statt Historie zu speichern).
+static volatile uint16_t firstTries = 0;
+static volatile uint16_t firstTryOk = 0;
+
+void busGapInit()
+{
+	File f = LittleFS.open(MODBUS_GAP_FILE, "r");
+	if (!f)
+	{
+		return; // noch nichts gelernt -> Startwert MODBUS_TX_SPACING_MS
+	}
+	JsonDocument json;
+	if (!deserializeJson(json, f))
+	{
+		uint32_t learned = json["gap_ms"] | (uint32_t)MODBUS_TX_SPACING_MS;
+		gapMs = constrain(learned, (uint32_t)MODBUS_GAP_MIN_MS, (uint32_t)MODBUS_GAP_MAX_MS);
+		savedGapMs = gapMs;
+	}
+	f.close();
+	LOGF(LOG_LEVEL_WARNING, "Bus-Gap Startwert %lu ms", (unsigned long)gapMs);
+}
+
+void busGapWait()
+{
+	int64_t sinceMs = (esp_timer_get_time() - rtuLastFrameEndUs()) / 1000;
+	if (sinceMs < (int64_t)gapMs)
+	{
+		rtuListen(gapMs - sinceMs); // wartet auf der UART-Event-Queue -> Fremdverkehr wird mitgehoert
+	}
+}
+
+void busGapReport(uint8_t result, bool first_try)
+{
+	if (!first_try)
+	{
+		return; // Retries sagen nichts ueber die Luecke (sie folgen ohnehin mit voller Luecke)
+	}
+	if (firstTries >= 200)
+	{
+		firstTries /= 2;
+		firstTryOk /= 2;
+	}
+	firstTries++;
+
+	if (result == MB_RESULT_SUCCESS)
+	{
+		firstTryOk++;
+		if (++successStreak >= MODBUS_GAP_PROBE_AFTER)
+		{
+			successStreak = 0;
+			if (gapMs > MODBUS_GAP_MIN_MS + MODBUS_GAP_PROBE_STEP_MS)
+			{
+				gapMs -= MODBUS_GAP_PROBE_STEP_MS;
+			}
+			else
+			{
+				gapMs = MODBUS_GAP_MIN_MS;
+			}
+		}
+	}
+	else if (result == MB_RESULT_RESPONSE_TIMED_OUT)
+	{
+		// Kollisionsfehler (CRC/Slave-ID) sind Fremdverkehr, kein Gap-Problem -> nur der Timeout zaehlt.
+		successStreak = 0;
+		uint32_t doubled = gapMs * 2;
+		gapMs = doubled > MODBUS_GAP_MAX_MS ? MODBUS_GAP_MAX_MS : doubled;
+		LOGF(LOG_LEVEL_INFO, "Bus-Gap nach Erstversuch-Timeout auf %lu ms erhoeht", (unsigned long)gapMs);
+	}
+
+	uint32_t now = millis();
+	portENTER_CRITICAL(&gapMux);
+	uint32_t delta = gapMs > savedGapMs ? gapMs - savedGapMs : savedGapMs - gapMs;
+	if (delta >= MODBUS_GAP_SAVE_DELTA_MS && (uint32_t)(now - lastSaveMs) >= MODBUS_GAP_SAVE_MIN_INTERVAL_MS)
+	{
+		saveDirty = true;
+	}
+	portEXIT_CRITICAL(&gapMux);
+}
+
+bool busGapSaveIfDirty()
+{
+	portENTER_CRITICAL(&gapMux);
+	if (!saveDirty)
+	{
+		portEXIT_CRITICAL(&gapMux);
+		return false;
+	}
+	saveDirty = false;
+	uint32_t value = gapMs;
+	// Auch bei Schreibfehler als gesichert vermerken: naechster Versuch erst nach dem Mindestabstand.
+	savedGapMs = value;
+	lastSaveMs = millis();
+	portEXIT_CRITICAL(&gapMux);
+	File f = LittleFS.open(MODBUS_GAP_FILE, "w");
+	if (!f)
+	{
+		LOGF(LOG_LEVEL_ERROR, "Bus-Gap: %s nicht schreibbar", MODBUS_GAP_FILE);
+		return true;
+	}
+	JsonDocument json;
+	json["gap_ms"] = value;
+	serializeJson(json, f);
+	f.close();
+	LOGF(LOG_LEVEL_INFO, "Bus-Gap %lu ms gesichert", (unsigned long)value);
+	return true;
+}
+
+uint32_t busGapMs()
+{
+	return gapMs;
+}
+
+uint8_t busGapFirstTryPct()
+{
+	uint16_t tries = firstTries;
+	return tries == 0 ? 100 : (uint8_t)((uint32_t)firstTryOk * 100 / tries);
+}
@@ -0,0 +1,40 @@
+#ifndef SRC_MODBUS_GAP_H_
+#define SRC_MODBUS_GAP_H_
+
+#include "Arduino.h"
+
+// Adaptiver Inter-Transaktions-Abstand ("Bus-Gap"). Ersetzt die festen 500 ms aus der Diagnose
+// 2026-06-15 (MODBUS_TX_SPACING_MS/MODBUS_POLL_INTERVAL_MS), die zudem doppelt anfielen: ein Write
+// schlief 500 ms vorher UND der Worker 500 ms danach, auch wenn der Bus schon Sekunden still war.
+//
+// busGapWait() misst die Zeit seit dem Ende der letzten Transaktion (RTU-Transport) und wartet nur
+// die noch fehlende Luecke ab. busGapReport() lernt aus den ERSTEN Versuchen (AIMD, wie TCP, nur auf
+// die Luecke statt auf die Rate gemuenzt): nach MODBUS_GAP_PROBE_AFTER Erstversuch-Erfolgen in Folge
+// wird die Luecke um MODBUS_GAP_PROBE_STEP_MS verkuerzt (additiv), ein Erstversuch-Timeout — das
+// Symptom "Slave verschluckt zu dicht folgende Anfrage" — verdoppelt sie (multiplikativ). Der
+// gelernte Wert wird (aus dem Loop-Task) in LittleFS gesichert und beim naechsten Boot als Startwert genommen.
+
+#define MODBUS_GAP_MIN_MS 50				// nie kuerzer (Schutz gegen Fehllernen bei ruhigem Bus)
+#define MODBUS_GAP_MAX_MS 2000				// nie laenger (Obergrenze fuer die Verdopplung)
+#define MODBUS_GAP_PROBE_STEP_MS 10			// additive Verkuerzung je Probe
+#define MODBUS_GAP_PROBE_AFTER 20			// Erstversuch-Erfolge in Folge vor der naechsten Probe
+#define MODBUS_GAP_SAVE_DELTA_MS 50			// erst ab dieser Abweichung zum gesicherten Wert speichern
+#define MODBUS_GAP_SAVE_MIN_INTERVAL_MS 600000 // hoechstens alle 10 min in den Flash
+#define MODBUS_GAP_FILE "/modbus_gap.json"
+
+// Gelernten Wert aus LittleFS laden (sonst Startwert MODBUS_TX_SPACING_MS). Nach initFileLog().
+void busGapInit();
+// Blockiert nur fuer den Rest der Luecke seit dem Ende der letzten Transaktion (per rtuListen, d.h.
+// waehrenddessen wird Fremdverkehr fuer den Bus-Arbiter mitgehoert).
+void busGapWait();
+// Ergebnis einer Transaktion melden; first_try=false (Retries) fliesst nicht ins Lernen ein.
+void busGapReport(uint8_t result, bool first_try);
+// Sichert den gelernten Wert, wenn busGapReport() es vorgemerkt hat (Abweichung >=
+// MODBUS_GAP_SAVE_DELTA_MS, hoechstens alle MODBUS_GAP_SAVE_MIN_INTERVAL_MS). Loop-Task, jede Runde:
+// keine Flash-I/O im Bus-Worker. true = gesichert.
+bool busGapSaveIfDirty();
+// Aktuelle Luecke in ms bzw. Erstversuch-Erfolgsquote in Prozent (fuer das /status-JSON).
+uint32_t busGapMs();
+uint8_t busGapFirstTryPct();
+
+#endif // SRC_MODBUS_GAP_H_
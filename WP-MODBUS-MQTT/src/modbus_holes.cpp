@@ -0,0 +1,224 @@
+#include "modbus_holes.h"
+#include "log.h"
+#include <ArduinoJson.h>
+#include <LittleFS.h>
+
+typedef struct
+{
+	uint16_t first;
+	uint16_t last; // inklusive
+	modbus_addr_state_t state;
+} hole_span_t;
+
+// Sortiert nach first, disjunkt, nie zwei benachbarte Intervalle mit gleichem Zustand, kein UNKNOWN.
+static hole_span_t spans[MODBUS_HOLES_MAX_SPANS];
+static volatile uint8_t numSpans = 0;
+static volatile uint32_t unreadableCount = 0;
+// Nur der Worker aendert die Karte (und liest sie ohne Lock); der Loop-Task sichert eine Kopie. Die
+// Kopie und das Uebernehmen einer Aenderung laufen unter holesMux.
+static portMUX_TYPE holesMux = portMUX_INITIALIZER_UNLOCKED;
+static bool dirty = false;
+static uint32_t changedMs = 0;
+static bool overflowWarned = false;
+
+static void recount()
+{
+	uint32_t n = 0;
+	for (uint8_t i = 0; i < numSpans; ++i)
+	{
+		if (spans[i].state == MODBUS_ADDR_UNREADABLE)
+		{
+			n += (uint32_t)spans[i].last - spans[i].first + 1;
+		}
+	}
+	unreadableCount = n;
+}
+
+// Haengt s an out an und verschmilzt es mit dem Vorgaenger, wenn beide aneinanderstossen und gleich sind.
+static void appendSpan(hole_span_t *out, int &n, const hole_span_t &s)
+{
+	if (n > 0 && out[n - 1].state == s.state && (uint32_t)out[n - 1].last + 1 == s.first)
+	{
+		out[n - 1].last = s.last;
+		return;
+	}
+	out[n++] = s;
+}
+
+void modbusHolesInit()
+{
+	File f = LittleFS.open(MODBUS_HOLES_FILE, "r");
+	if (!f)
+	{
+		return; // noch nichts gelernt
+	}
+	JsonDocument json;
+	if (!deserializeJson(json, f))
+	{
+		// Nur uebernehmen, was die Invarianten erfuellt (Datei von Hand bearbeitet / Format geaendert).
+		int n = 0;
+		for (JsonVariantConst s : json["spans"].as<JsonArrayConst>())
+		{
+			uint32_t first = s[0] | 0xFFFFFFFFu;
+			uint32_t last = s[1] | 0u;
+			uint8_t state = s[2] | 0;
+			if (n >= MODBUS_HOLES_MAX_SPANS || first > last || last > 0xFFFF ||
+				(state != MODBUS_ADDR_READABLE && state != MODBUS_ADDR_UNREADABLE) ||
+				(n > 0 && first <= spans[n - 1].last))
+			{
+				break;
+			}
+			hole_span_t span = {(uint16_t)first, (uint16_t)last, (modbus_addr_state_t)state};
+			appendSpan(spans, n, span);
+		}
+		numSpans = n;
+	}
+	f.close();
+	recount();
+	LOGF(LOG_LEVEL_WARNING, "Adresskarte: %u Intervalle, %lu unlesbare Adressen", numSpans, (unsigned long)unreadableCount);
+}
+
+modbus_addr_state_t modbusHolesState(uint16_t addr)
+{
+	for (uint8_t i = 0; i < numSpans && spans[i].first <= addr; ++i)
+	{
+		if (addr <= spans[i].last)
+		{
+			return spans[i].state;
+		}
+	}
+	return MODBUS_ADDR_UNKNOWN;
+}
+
+void modbusHolesMark(uint16_t first, uint16_t last, modbus_addr_state_t state)
+{
+	// Neu aufbauen: alte Intervalle links/rechts von [first..last] behalten (ueberlappende kappen),
+	// das neue an seiner Stelle einfuegen. Ein gekapptes Intervall kann zwei Reste ergeben -> +2.
+	hole_span_t out[MODBUS_HOLES_MAX_SPANS + 2];
+	int n = 0;
+	bool inserted = false;
+	hole_span_t mark = {first, last, state};
+	for (uint8_t i = 0; i < numSpans; ++i)
+	{
+		const hole_span_t &s = spans[i];
+		if (s.last < first)
+		{
+			appendSpan(out, n, s);
+			continue;
+		}
+		if (!inserted)
+		{
+			if (s.first < first)
+			{
+				appendSpan(out, n, {s.first, (uint16_t)(first - 1), s.state});
+			}
+			if (state != MODBUS_ADDR_UNKNOWN)
+			{
+				appendSpan(out, n, mark);
+			}
+			inserted = true;
+		}
+		if (s.last > last)
+		{
+			appendSpan(out, n, s.first > last ? s : hole_span_t{(uint16_t)(last + 1), s.last, s.state});
+		}
+	}
+	if (!inserted && state != MODBUS_ADDR_UNKNOWN)
+	{
+		appendSpan(out, n, mark);
+	}
+	if (n > MODBUS_HOLES_MAX_SPANS)
+	{
+		if (!overflowWarned)
+		{
+			overflowWarned = true;
+			LOGF(LOG_LEVEL_WARNING, "Adresskarte voll (%u Intervalle), %u..%u nicht gelernt", MODBUS_HOLES_MAX_SPANS, first, last);
+		}
+		return;
+	}
+	bool same = n == numSpans;
+	for (int i = 0; same && i < n; ++i)
+	{
+		same = out[i].first == spans[i].first && out[i].last == spans[i].last && out[i].state == spans[i].state;
+	}
+	if (same)
+	{
+		return;
+	}
+	portENTER_CRITICAL(&holesMux);
+	memcpy(spans, out, n * sizeof(hole_span_t));
+	numSpans = n;
+	dirty = true;
+	changedMs = millis();
+	portEXIT_CRITICAL(&holesMux);
+	recount();
+}
+
+int modbusHolesCollect(uint16_t first, uint16_t last, uint16_t *out, int max)
+{
+	int n = 0;
+	for (uint8_t i = 0; i < numSpans; ++i)
+	{
+		const hole_span_t &s = spans[i];
+		if (s.state != MODBUS_ADDR_UNREADABLE || s.last < first || s.first > last)
+		{
+			continue;
+		}
+		uint32_t lo = s.first > first ? s.first : first;
+		uint32_t hi = s.last < last ? s.last : last;
+		for (uint32_t a = lo; a <= hi; ++a)
+		{
+			if (n >= max)
+			{
+				return -1;
+			}
+			out[n++] = (uint16_t)a;
+		}
+	}
+	return n;
+}
+
+bool modbusHolesSaveIfDirty()
+{
+	hole_span_t copy[MODBUS_HOLES_MAX_SPANS];
+	uint8_t n;
+	portENTER_CRITICAL(&holesMux);
+	if (!dirty || (uint32_t)(millis() - changedMs) < MODBUS_HOLES_SAVE_DELAY_MS)
+	{
+		portEXIT_CRITICAL(&holesMux);
+		return false;
+	}
+	dirty = false; // auch bei Schreibfehler: nicht jede Loop-Runde erneut versuchen
+	n = numSpans;
+	memcpy(copy, spans, n * sizeof(hole_span_t));
+	portEXIT_CRITICAL(&holesMux);
+	File f = LittleFS.open(MODBUS_HOLES_FILE, "w");
+	if (!f)
+	{
+		log(LOG_LEVEL_ERROR, "Adresskarte: " MODBUS_HOLES_FILE " nicht schreibbar");
+		return true;
+	}
+	JsonDocument json;
+	JsonArray arr = json["spans"].to<JsonArray>();
+	for (uint8_t i = 0; i < n; ++i)
+	{
+		JsonArray s = arr.add<JsonArray>();
+		s.add(copy[i].first);
+		s.add(copy[i].last);
+		s.add((uint8_t)copy[i].state);
+	}
+	serializeJson(json, f);
+	f.close();
+	LOGF(LOG_LEVEL_INFO, "Adresskarte gesichert: %u Intervalle, %lu unlesbare Adressen", n, (unsigned long)unreadableCount);
+	return true;
+}
+
+uint32_t modbusHolesUnreadable()
+{
+	return unreadableCount;
+}
+
+uint8_t modbusHolesSpans()
+{
+	return numSpans;
+}
@@ -0,0 +1,48 @@
+#ifndef SRC_MODBUS_HOLES_H_
+#define SRC_MODBUS_HOLES_H_
+
+#include "Arduino.h"
+
+// Gelernte Adresskarte des Slaves: welche Holding-Register lesbar sind und welche mit einer Slave-
+// Exception (Illegal Data Address) antworten. Bisher gab es nur die handgepflegte pollHoles[]
+// (modbus_registers.h), und ein Dump-Chunk mit EINER unlesbaren Adresse lieferte 50x ERR.
+//
+// Der Dump (modbus_base.cpp) halbiert einen Chunk mit permanentem Fehler, bis die einzelnen
+// unlesbaren Adressen feststehen, und traegt jedes Ergebnis hier ein. Gehalten als sortierte,
+// disjunkte Intervalle gleichen Zustands (Nachbarn werden verschmolzen, typische Karten haben eine
+// Handvoll Intervalle) und in LittleFS gesichert. Nutzer:
+//   - spaetere Dumps ueberspringen bekannte Loecher ohne Bustransaktion und lesen die Luecken
+//     dazwischen direkt als maximale Bloecke
+//   - der Poll-Planer plant beim Boot mit den gelernten Loechern neu (buildPollPlan zur Laufzeit)
+// Nur der Worker-Task liest und aendert die Karte (kein Lock); gesichert wird sie vom Loop-Task aus
+// einer Kopie (Flash-I/O nie auf dem Bus-Worker). Die Zaehler fuer /status sind atomar lesbar.
+
+#define MODBUS_HOLES_MAX_SPANS 64		// Intervalle in RAM und Datei
+#define MODBUS_HOLES_SAVE_DELAY_MS 5000 // erst nach so viel Ruhe sichern -> ein Dump = ein Flash-Schreibvorgang
+#define MODBUS_HOLES_FILE "/modbus_holes.json"
+#define MODBUS_HOLES_PLAN_MAX 64		// so viele gelernte Loecher im Poll-Adressbereich beruecksichtigt der Planer
+
+enum modbus_addr_state_t : uint8_t
+{
+	MODBUS_ADDR_UNKNOWN = 0,
+	MODBUS_ADDR_READABLE = 1,
+	MODBUS_ADDR_UNREADABLE = 2
+};
+
+// Karte aus LittleFS laden (nach initFileLog, vor dem ersten Poll-Plan).
+void modbusHolesInit();
+modbus_addr_state_t modbusHolesState(uint16_t addr);
+// Setzt [first .. last] auf state (MODBUS_ADDR_UNKNOWN = vergessen). Laeuft die Karte ueber, bleibt
+// sie unveraendert (Warnung einmal je Boot).
+void modbusHolesMark(uint16_t first, uint16_t last, modbus_addr_state_t state);
+// Schreibt die bekannt unlesbaren Adressen in [first .. last] nach out. Liefert ihre Zahl oder -1,
+// wenn es mehr als max sind.
+int modbusHolesCollect(uint16_t first, uint16_t last, uint16_t *out, int max);
+// Sichert die Karte, wenn sie sich geaendert hat und seitdem MODBUS_HOLES_SAVE_DELAY_MS vergangen
+// sind (Loop-Task, jede Runde). true = gesichert, d.h. die Karte hat sich seit dem letzten Mal geaendert.
+bool modbusHolesSaveIfDirty();
+// Bekannt unlesbare Adressen bzw. Zahl der Intervalle (fuer das /status-JSON).
+uint32_t modbusHolesUnreadable();
+uint8_t modbusHolesSpans();
+
+#endif // SRC_MODBUS_HOLES_H_
@@ -0,0 +1,273 @@
+#ifndef SRC_MODBUS_POLL_PLAN_H_
+#define SRC_MODBUS_POLL_PLAN_H_
+
+#include "Arduino.h"
+#include "modbus_registers.h"
+#include "modbus_faults.h"
+#include "modbus_rtu.h"
+
+// =========================================================================================
+// Poll-Planer: berechnet die Block-Reads fuer das Daten-JSON zur COMPILEZEIT aus registers[] und
+// faultRegisters[] (frueher handgepflegtes pollRanges[] + Laufzeit-Warnung checkPollRangeCoverage()).
+// Ein neu eingetragenes Register landet damit automatisch in einem Block — oder der Build bricht ab
+// (static_assert unten), falls es auf einer bekannten unlesbaren Adresse (pollHoles[]) liegt.
+// Geplant wird je Refresh-Klasse (poll_class_t) getrennt, die schnellste zuerst: jeder Range traegt
+// genau eine Klasse, der Deadline-Scheduler im Worker liest ihn mit deren Periode. Adressen einer
+// langsameren Klasse, die schon in einem Range einer schnelleren liegen, fahren dort mit (kein eigener
+// Read, z.B. die Sollwerte 105..108 im schnellen Block 92..132) -> keine zusaetzliche Buslast.
+//
+// Kostenmodell je Block: MODBUS_PLAN_TX_COST_REGS (feste Kosten einer Transaktion, in Register-
+// Aequivalenten) + Anzahl gelesener Register (inkl. Luecken). Minimiert per DP ueber die sortierten
+// Adressen (O(n^2), n = Zahl der Adressen), Nebenbedingungen: Block <= RTU_MAX_READ_REGS und kein
+// Block ueberdeckt eine Adresse aus pollHoles[].
+//
+// Zusaetzlich entsteht je Range eine Offset->Slot-Tabelle (welches Register/Fehlerregister an welchem
+// Offset im Block steht) -> distributeBlock/distributeFaultBlock verteilen in O(k) statt jeden Range
+// gegen alle Register zu pruefen.
+// =========================================================================================
+
+// Feste Kosten einer Transaktion in "Register-Aequivalenten" (1 Register = 2 Byte Antwort). Anfrage
+// (8 Byte) + Antwortkopf/CRC (5 Byte) + 2x t3.5 + Slave-Latenz liegen bei ~15 Registern, dazu kommt
+// der Inter-Transaktions-Abstand (Bus-Gap, modbus_gap.h) und jede Transaktion ist ein weiteres
+// Kollisionsfenster mit dem Tuya-Master -> grosszuegig angesetzt, Luecken mitlesen ist billig.
+// 64 statt 32, seit je Klasse geplant wird: sonst zerfiele 92,93 | 132 der schnellen Klasse in zwei
+// Transaktionen alle MODBUS_POLL_PERIOD_FAST_MS — mehr Buslast als der eine 41er-Block. Die schnelle
+// Klasse bleibt trotzdem zwei Blocks (26..39 | 92..132): 26..132 ist laenger als RTU_MAX_READ_REGS.
+#ifndef MODBUS_PLAN_TX_COST_REGS
+#define MODBUS_PLAN_TX_COST_REGS 64
+#endif
+
+typedef enum : uint8_t
+{
+	POLL_SLOT_REGISTER = 0, // index -> registers[] / register_values[]
+	POLL_SLOT_FAULT = 1		// index -> faultRegisters[] / Fault-Cache
+} poll_slot_kind_t;
+
+typedef struct
+{
+	uint8_t offset; // Position im Blockpuffer (Adresse - range.start)
+	poll_slot_kind_t kind;
+	uint8_t index;
+} poll_slot_t;
+
+typedef struct
+{
+	uint16_t start;
+	uint16_t count;
+	uint8_t first_slot;		 // erster Eintrag in PollPlan::slots
+	uint8_t slot_count;		 // Anzahl Eintraege dieses Ranges
+	poll_class_t poll_class; // Refresh-Klasse aller Eintraege dieses Ranges
+} poll_range_t;
+
+constexpr int kPollNumRegisters = sizeof(registers) / sizeof(modbus_register_t);
+constexpr int kPollNumFaultRegs = sizeof(faultRegisters) / sizeof(fault_register_t);
+// Obergrenze fuer Adressen, Ranges und Slots (jedes Register ergibt hoechstens eine Adresse/einen Slot,
+// auch ueber alle Klassen summiert).
+constexpr int kPollMaxEntries = kPollNumRegisters + kPollNumFaultRegs;
+static_assert(kPollMaxEntries <= 255, "poll_slot_t/poll_range_t nutzen uint8_t-Indizes");
+
+#define POLL_PLAN_INFEASIBLE 0xFFFFFFFFu
+
+typedef struct
+{
+	poll_range_t ranges[kPollMaxEntries];
+	int num_ranges;
+	poll_slot_t slots[kPollMaxEntries];
+	int num_slots;
+	uint32_t cost; // POLL_PLAN_INFEASIBLE, wenn ein Register auf einem Loch liegt
+} PollPlan;
+
+constexpr bool pollSpanHasHole(uint16_t lo, uint16_t hi, const uint16_t *holes, int num_holes)
+{
+	for (int h = 0; h < num_holes; ++h)
+	{
+		if (holes[h] != POLL_HOLE_NONE && holes[h] >= lo && holes[h] <= hi)
+		{
+			return true;
+		}
+	}
+	return false;
+}
+
+// Traegt addr sortiert und ohne Duplikate in addrs[0..n) ein.
+constexpr void pollInsertAddr(uint16_t *addrs, int &n, uint16_t addr)
+{
+	int pos = 0;
+	while (pos < n && addrs[pos] < addr)
+	{
+		++pos;
+	}
+	if (pos < n && addrs[pos] == addr)
+	{
+		return;
+	}
+	for (int k = n; k > pos; --k)
+	{
+		addrs[k] = addrs[k - 1];
+	}
+	addrs[pos] = addr;
+	++n;
+}
+
+// Reihenfolge der Planung: schnellste Klasse zuerst, damit langsamere in deren Ranges mitfahren.
+constexpr poll_class_t kPollClassOrder[] = {POLL_CLASS_FAST, POLL_CLASS_NORMAL, POLL_CLASS_SLOW};
+static_assert(sizeof(kPollClassOrder) / sizeof(kPollClassOrder[0]) == POLL_CLASS_COUNT,
+			  "kPollClassOrder muss jede Poll-Klasse genau einmal enthalten");
+
+// true, wenn addr schon in einem der bisher geplanten Ranges liegt.
+constexpr bool pollAddrCovered(const PollPlan &plan, uint16_t addr)
+{
+	for (int r = 0; r < plan.num_ranges; ++r)
+	{
+		if (addr >= plan.ranges[r].start && addr < plan.ranges[r].start + plan.ranges[r].count)
+		{
+			return true;
+		}
+	}
+	return false;
+}
+
+// Plant die noch nicht abgedeckten Adressen EINER Refresh-Klasse und haengt deren Ranges an plan an.
+// Liefert false, wenn eine Adresse der Klasse auf einem Loch liegt (nicht abdeckbar).
+constexpr bool pollPlanClass(PollPlan &plan, poll_class_t cls, const uint16_t *holes, int num_holes, uint32_t tx_cost)
+{
+	uint16_t addrs[kPollMaxEntries] = {};
+	int n = 0;
+	for (int i = 0; i < kPollNumRegisters; ++i)
+	{
+		if (registers[i].poll_class == cls && !pollAddrCovered(plan, registers[i].id))
+		{
+			pollInsertAddr(addrs, n, registers[i].id);
+		}
+	}
+	for (int i = 0; i < kPollNumFaultRegs; ++i)
+	{
+		uint16_t addr = faultRegisters[i].modbus_addr;
+		if (addr != FAULT_ADDR_TODO && faultRegisters[i].poll_class == cls && !pollAddrCovered(plan, addr))
+		{
+			pollInsertAddr(addrs, n, addr);
+		}
+	}
+
+	// best[j] = minimale Kosten, um addrs[0..j) abzudecken; from[j] = Startindex des letzten Blocks.
+	uint32_t best[kPollMaxEntries + 1] = {};
+	int from[kPollMaxEntries + 1] = {};
+	for (int j = 1; j <= n; ++j)
+	{
+		best[j] = POLL_PLAN_INFEASIBLE;
+		for (int i = j - 1; i >= 0; --i)
+		{
+			uint16_t lo = addrs[i];
+			uint16_t hi = addrs[j - 1];
+			uint32_t span = hi - lo + 1;
+			// Weiter nach links wird der Block nur groesser bzw. behaelt das Loch -> abbrechen.
+			if (span > RTU_MAX_READ_REGS || pollSpanHasHole(lo, hi, holes, num_holes))
+			{
+				break;
+			}
+			if (best[i] == POLL_PLAN_INFEASIBLE)
+			{
+				continue;
+			}
+			uint32_t c = best[i] + tx_cost + span;
+			if (c < best[j])
+			{
+				best[j] = c;
+				from[j] = i;
+			}
+		}
+	}
+	if (best[n] == POLL_PLAN_INFEASIBLE)
+	{
+		return false;
+	}
+	plan.cost += best[n];
+
+	// Ranges rueckwaerts aus from[] rekonstruieren, dann in aufsteigende Reihenfolge drehen.
+	int first_range = plan.num_ranges;
+	for (int j = n; j > 0; j = from[j])
+	{
+		poll_range_t &r = plan.ranges[plan.num_ranges++];
+		r.start = addrs[from[j]];
+		r.count = addrs[j - 1] - addrs[from[j]] + 1;
+		r.poll_class = cls;
+	}
+	for (int a = first_range, b = plan.num_ranges - 1; a < b; ++a, --b)
+	{
+		poll_range_t tmp = plan.ranges[a];
+		plan.ranges[a] = plan.ranges[b];
+		plan.ranges[b] = tmp;
+	}
+	return true;
+}
+
+// Offset->Slot-Tabellen: jedes Register/Fehlerregister genau einmal, im ersten Range, der seine
+// Adresse enthaelt (Ranges schnellerer Klassen stehen vorn -> Mitfahrer landen dort).
+constexpr void pollPlanSlots(PollPlan &plan)
+{
+	bool regDone[kPollNumRegisters] = {};
+	bool faultDone[kPollNumFaultRegs] = {};
+	for (int r = 0; r < plan.num_ranges; ++r)
+	{
+		poll_range_t &range = plan.ranges[r];
+		range.first_slot = plan.num_slots;
+		for (int i = 0; i < kPollNumRegisters; ++i)
+		{
+			uint16_t id = registers[i].id;
+			if (!regDone[i] && id >= range.start && id < range.start + range.count)
+			{
+				plan.slots[plan.num_slots++] = {(uint8_t)(id - range.start), POLL_SLOT_REGISTER, (uint8_t)i};
+				regDone[i] = true;
+			}
+		}
+		for (int i = 0; i < kPollNumFaultRegs; ++i)
+		{
+			uint16_t addr = faultRegisters[i].modbus_addr;
+			if (!faultDone[i] && addr != FAULT_ADDR_TODO && addr >= range.start && addr < range.start + range.count)
+			{
+				plan.slots[plan.num_slots++] = {(uint8_t)(addr - range.start), POLL_SLOT_FAULT, (uint8_t)i};
+				faultDone[i] = true;
+			}
+		}
+		range.slot_count = plan.num_slots - range.first_slot;
+	}
+}
+
+// Auch zur Laufzeit aufrufbar (andere Loch-Liste), zur Compilezeit mit pollHoles[] ausgewertet.
+constexpr PollPlan buildPollPlan(const uint16_t *holes, int num_holes, uint32_t tx_cost)
+{
+	PollPlan plan{};
+	for (poll_class_t cls : kPollClassOrder)
+	{
+		if (!pollPlanClass(plan, cls, holes, num_holes, tx_cost))
+		{
+			plan.cost = POLL_PLAN_INFEASIBLE;
+			return plan;
+		}
+	}
+	pollPlanSlots(plan);
+	return plan;
+}
+
+// Zaehlt die Eintraege, die der Plan abdecken MUSS (alle Register + alle Fehlerregister mit Adresse).
+constexpr int pollRequiredSlots()
+{
+	int n = kPollNumRegisters;
+	for (int i = 0; i < kPollNumFaultRegs; ++i)
+	{
+		if (faultRegisters[i].modbus_addr != FAULT_ADDR_TODO)
+		{
+			++n;
+		}
+	}
+	return n;
+}
+
+constexpr PollPlan pollPlan = buildPollPlan(pollHoles, sizeof(pollHoles) / sizeof(pollHoles[0]), MODBUS_PLAN_TX_COST_REGS);
+
+static_assert(pollPlan.cost != POLL_PLAN_INFEASIBLE,
+			  "Ein Register/Fehlerregister liegt auf einer Adresse aus pollHoles[] -> nicht pollbar");
+static_assert(pollPlan.num_slots == pollRequiredSlots(),
+			  "Poll-Plan deckt nicht alle Register/Fehlerregister ab");
+
+#endif // SRC_MODBUS_POLL_PLAN_H_
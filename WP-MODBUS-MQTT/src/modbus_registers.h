@@ -30,6 +30,19 @@ typedef union
 	const char *bitfield[16];
 } optional_param_t;
 
+// Refresh-Klasse je Register/Fehlerregister: legt fest, wie oft der Deadline-Scheduler im Worker
+// den Block mit diesem Eintrag liest (Perioden: MODBUS_POLL_PERIOD_*_MS in modbus_base.h). Der Poll-
+// Planer bildet Blocks je Klasse getrennt, damit schnelle Zustaende nicht die langsamen Kandidaten-
+// Register mitschleppen. Die Periode ist eine Obergrenze: liegt die Adresse schon in einem Block einer
+// schnelleren Klasse, faehrt sie dort mit (kein eigener Read). Nicht angegeben = POLL_CLASS_NORMAL.
+typedef enum : uint8_t
+{
+	POLL_CLASS_NORMAL = 0, // Standard (Soll-/Ist-Temperaturen, Lastwerte)
+	POLL_CLASS_FAST,	   // Schaltzustand, Modus, Fehler -> schnell nach MQTT
+	POLL_CLASS_SLOW,	   // traege Kandidaten-Register (_v), nur zur Identifikation geloggt
+	POLL_CLASS_COUNT
+} poll_class_t;
+
 typedef struct
 {
 	uint16_t id;
@@ -37,16 +50,24 @@ typedef struct
 	register_type_t type;		   /*!< Float, U8, U16, U32, ASCII, etc. */
 	const char *name;
 	optional_param_t optional_param;
+	poll_class_t poll_class = POLL_CLASS_NORMAL; /*!< Refresh-Klasse (in der Tabelle weglassbar) */
+	uint16_t deadband = 0;						 /*!< Publish-Totband in Rohwert-Einheiten (0 = jede Aenderung) */
 } modbus_register_t;
 
-const modbus_register_t registers[] = { //register IDs are zero-based, i.e. register 40001 has id 0
-	{92, MODBUS_TYPE_HOLDING, REGISTER_TYPE_U16, "ein_aus"},
-	{93, MODBUS_TYPE_HOLDING, REGISTER_TYPE_U16, "modus"},
-	{132, MODBUS_TYPE_HOLDING, REGISTER_TYPE_U16, "sub_modus"},
-	{50, MODBUS_TYPE_HOLDING, REGISTER_TYPE_U16, "temp_akt"},
-	{106, MODBUS_TYPE_HOLDING, REGISTER_TYPE_U16, "temp_soll_kuehl"},
-	{105, MODBUS_TYPE_HOLDING, REGISTER_TYPE_U16, "temp_soll_heiz"},
-	{108, MODBUS_TYPE_HOLDING, REGISTER_TYPE_U16, "temp_soll_auto"},
+// Totband (deadband): eine Aenderung gilt erst als Aenderung, wenn sie vom zuletzt PUBLIZIERTEN Wert
+// um mehr als deadband Rohwert-Einheiten abweicht (Hysterese, siehe registerChanged in modbus_base.h).
+// Gegen rauschende Temperaturen (+-0,1 °C Flattern), die sonst jeden Poll einen Publish ausloesen.
+// Schalt-/Soll-Werte bleiben bei 0: dort zaehlt jede Aenderung sofort (Write-Feedback!).
+
+// constexpr (statt const): der Poll-Planer (modbus_poll_plan.h) rechnet zur Compilezeit darueber.
+constexpr modbus_register_t registers[] = { //register IDs are zero-based, i.e. register 40001 has id 0
+	{92, MODBUS_TYPE_HOLDING, REGISTER_TYPE_U16, "ein_aus", {}, POLL_CLASS_FAST},
+	{93, MODBUS_TYPE_HOLDING, REGISTER_TYPE_U16, "modus", {}, POLL_CLASS_FAST},
+	{132, MODBUS_TYPE_HOLDING, REGISTER_TYPE_U16, "sub_modus", {}, POLL_CLASS_FAST},
+	{50, MODBUS_TYPE_HOLDING, REGISTER_TYPE_U16, "temp_akt", {}, POLL_CLASS_NORMAL, 2}, // Totband 0,2 °C
+	{106, MODBUS_TYPE_HOLDING, REGISTER_TYPE_U16, "temp_soll_kuehl", {}, POLL_CLASS_NORMAL},
+	{105, MODBUS_TYPE_HOLDING, REGISTER_TYPE_U16, "temp_soll_heiz", {}, POLL_CLASS_NORMAL},
+	{108, MODBUS_TYPE_HOLDING, REGISTER_TYPE_U16, "temp_soll_auto", {}, POLL_CLASS_NORMAL},
 	{39, MODBUS_TYPE_HOLDING, REGISTER_TYPE_BITFIELD, "status_bits", {.bitfield = {
 		"wasserpumpe",       // Bit 0: bestätigt
 		"kompressor_aktiv",  // Bit 1: bestätigt (Standby vs. Heizen)
@@ -54,7 +75,7 @@ const modbus_register_t registers[] = { //register IDs are zero-based, i.e. regi
 		"status_bit3",       // Bit 3: vermutet 4-Wege-/Magnetventil
 		"status_bit4",       // Bit 4: vermutet Heizmodus aktiv
 		"status_bit5"        // Bit 5: vermutet Heizmodus aktiv
-	}}},
+	}}, POLL_CLASS_FAST},
 	// Temperatur-Block 51–55 (Rohwert ×10 wie temp_akt; ÷10 → °C) — alle noch Kandidaten (_v).
 	// Quervergleich mit den alten 1-basierten Scans (old reg = new+1) im selben Vollheiz-Zustand
 	// (Außentemp damals ~20 °C, jetzt 14 °C, also -6 °C / -60 roh):
@@ -66,16 +87,24 @@ const modbus_register_t registers[] = { //register IDs are zero-based, i.e. regi
 	// FAZIT: KEIN Register liest echte Umgebungsluft (~20 alt / ~14 neu) → around_temp (DP26)
 	// bleibt UNIDENTIFIZIERT. Block trotzdem als Kandidaten loggen, um coiler/effluent/return
 	// per weiterer Diffs (Kühlbetrieb, andere Außentemp) endgültig zuzuordnen.
-	{51, MODBUS_TYPE_HOLDING, REGISTER_TYPE_U16, "temp_spule_v"},
-	{53, MODBUS_TYPE_HOLDING, REGISTER_TYPE_U16, "temp_spule2_v"},
-	{52, MODBUS_TYPE_HOLDING, REGISTER_TYPE_U16, "temp_wasser_v"},
-	{54, MODBUS_TYPE_HOLDING, REGISTER_TYPE_U16, "temp_wasser2_v"},
-	{55, MODBUS_TYPE_HOLDING, REGISTER_TYPE_U16, "temp_55_v"},
+	{51, MODBUS_TYPE_HOLDING, REGISTER_TYPE_U16, "temp_spule_v", {}, POLL_CLASS_SLOW, 2},
+	{53, MODBUS_TYPE_HOLDING, REGISTER_TYPE_U16, "temp_spule2_v", {}, POLL_CLASS_SLOW, 2},
+	{52, MODBUS_TYPE_HOLDING, REGISTER_TYPE_U16, "temp_wasser_v", {}, POLL_CLASS_SLOW, 2},
+	{54, MODBUS_TYPE_HOLDING, REGISTER_TYPE_U16, "temp_wasser2_v", {}, POLL_CLASS_SLOW, 2},
+	{55, MODBUS_TYPE_HOLDING, REGISTER_TYPE_U16, "temp_55_v", {}, POLL_CLASS_SLOW, 2},
 	// Vermutete Status-/Last-Register — zur weiteren Identifikation über MQTT loggen.
-	{41, MODBUS_TYPE_HOLDING, REGISTER_TYPE_U16, "frequenz_soll_v"},
-	{48, MODBUS_TYPE_HOLDING, REGISTER_TYPE_U16, "kompressor_ist_v"},
-	{64, MODBUS_TYPE_HOLDING, REGISTER_TYPE_U16, "luefter_v"},
-	{75, MODBUS_TYPE_HOLDING, REGISTER_TYPE_U16, "kompressor_last_v"},
+	{41, MODBUS_TYPE_HOLDING, REGISTER_TYPE_U16, "frequenz_soll_v", {}, POLL_CLASS_NORMAL},
+	{48, MODBUS_TYPE_HOLDING, REGISTER_TYPE_U16, "kompressor_ist_v", {}, POLL_CLASS_NORMAL},
+	{64, MODBUS_TYPE_HOLDING, REGISTER_TYPE_U16, "luefter_v", {}, POLL_CLASS_NORMAL},
+	{75, MODBUS_TYPE_HOLDING, REGISTER_TYPE_U16, "kompressor_last_v", {}, POLL_CLASS_NORMAL},
+};
+
+// Bekannt UNLESBARE Adressen (Illegal Data Address im Dump). Der Poll-Planer legt keinen Block-Read
+// ueber sie; ein Register auf einer dieser Adressen bricht den Build ab. Laut Dump ist 26..199
+// lueckenlos lesbar -> derzeit kein Eintrag (POLL_HOLE_NONE, da C++ keine leeren Arrays erlaubt).
+#define POLL_HOLE_NONE 0xFFFF
+constexpr uint16_t pollHoles[] = {
+	POLL_HOLE_NONE,
 };
 
 #endif // SRC_MODBUS_REGISTERS_H_
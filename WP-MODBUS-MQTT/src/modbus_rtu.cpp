@@ -0,0 +1,424 @@
+#include "modbus_rtu.h"
+#include "modbus_base.h"
+#include <driver/uart.h>
+#include <esp_timer.h>
+
+// UART2 dient der Modbus-Kommunikation (UART0 = Debug/Serial). Direkt ueber den IDF-Treiber,
+// NICHT mehr ueber HardwareSerial — beide gleichzeitig auf demselben Port wuerden sich den
+// Treiber/ISR streitig machen.
+#define RTU_UART UART_NUM_2
+#define RTU_RX_BUF_SIZE 512	 // > UART-HW-FIFO (128), Pflicht fuer uart_driver_install
+// 32 statt 16: mit der kleinen RX-FIFO-Schwelle (s.u.) erzeugt ein langes Frame mehr Events.
+#define RTU_EVENT_QUEUE_LEN 32
+// RX-Timeout in Zeichenzeiten: der UART meldet ein UART_DATA-Event mit timeout_flag, sobald die
+// Leitung so lange still ist -> Frame-Ende (Modbus t3.5). Ganzzahlig, daher 4 statt 3,5.
+#define RTU_RX_TIMEOUT_SYMBOLS 4
+// RX-FIFO-Schwelle in Byte: der Treiber meldet schon nach so vielen Zeichen ein UART_DATA-Event statt
+// erst am Frame-Ende (Default 120). Nur so sieht der Listen-before-talk-Pfad einen LAUFENDEN Fremd-
+// Frame rechtzeitig (rtuLineBusy) und kennt dessen Anfang auf wenige Zeichen genau.
+#define RTU_RX_FULL_THRESHOLD 4
+// Zeichenzeit (8N1 = 10 Bit) in us; daraus Frame-Beginn/-Ende der mitgehoerten Fremd-Frames.
+#define RTU_CHAR_US (10000000LL / MODBUS_BAUDRATE)
+// Laengstes Frame: FC03-Antwort mit RTU_MAX_READ_REGS Registern (Unit+FC+Count+Daten+CRC).
+#define RTU_MAX_FRAME (5 + 2 * RTU_MAX_READ_REGS)
+
+#if MODBUS_BAUDRATE > 19200
+static const int64_t rtuT35Us = 1750;
+#else
+static const int64_t rtuT35Us = (1000000LL * 39) / MODBUS_BAUDRATE + 500; // +500us : to be safe
+#endif
+
+static QueueHandle_t rtuEventQueue = nullptr;
+// Ende des letzten eigenen Frames (esp_timer, us). Erst wenn t3.5 seitdem verstrichen ist, darf das
+// naechste Frame raus. Frueher wurde davor IMMER delayMicroseconds(t3_5) gesponnen; bei dem
+// ohnehin groesseren Bus-Gap zwischen Transaktionen (modbus_gap.h) faellt die Wartezeit so weg.
+static int64_t lastFrameEndUs = 0;
+
+// Mithoeren zwischen den eigenen Transaktionen (rtuListen): Fremd-Frame im Aufbau + Zeitstempel.
+static rtu_frame_handler_t foreignFrameHandler = nullptr;
+static uint8_t listenBuf[RTU_MAX_FRAME];
+static size_t listenLen = 0;
+static bool listenOverflow = false;
+static int64_t listenStartUs = 0; // geschaetzter Beginn des Frames im Aufbau
+static int64_t lastRxUs = 0;	  // letztes empfangenes Zeichen (Fremdverkehr)
+
+static const uint16_t rtuCrcTable[256] = {
+	0x0000, 0xC0C1, 0xC181, 0x0140, 0xC301, 0x03C0, 0x0280, 0xC241,
+	0xC601, 0x06C0, 0x0780, 0xC741, 0x0500, 0xC5C1, 0xC481, 0x0440,
+	0xCC01, 0x0CC0, 0x0D80, 0xCD41, 0x0F00, 0xCFC1, 0xCE81, 0x0E40,
+	0x0A00, 0xCAC1, 0xCB81, 0x0B40, 0xC901, 0x09C0, 0x0880, 0xC841,
+	0xD801, 0x18C0, 0x1980, 0xD941, 0x1B00, 0xDBC1, 0xDA81, 0x1A40,
+	0x1E00, 0xDEC1, 0xDF81, 0x1F40, 0xDD01, 0x1DC0, 0x1C80, 0xDC41,
+	0x1400, 0xD4C1, 0xD581, 0x1540, 0xD701, 0x17C0, 0x1680, 0xD641,
+	0xD201, 0x12C0, 0x1380, 0xD341, 0x1100, 0xD1C1, 0xD081, 0x1040,
+	0xF001, 0x30C0, 0x3180, 0xF141, 0x3300, 0xF3C1, 0xF281, 0x3240,
+	0x3600, 0xF6C1, 0xF781, 0x3740, 0xF501, 0x35C0, 0x3480, 0xF441,
+	0x3C00, 0xFCC1, 0xFD81, 0x3D40, 0xFF01, 0x3FC0, 0x3E80, 0xFE41,
+	0xFA01, 0x3AC0, 0x3B80, 0xFB41, 0x3900, 0xF9C1, 0xF881, 0x3840,
+	0x2800, 0xE8C1, 0xE981, 0x2940, 0xEB01, 0x2BC0, 0x2A80, 0xEA41,
+	0xEE01, 0x2EC0, 0x2F80, 0xEF41, 0x2D00, 0xEDC1, 0xEC81, 0x2C40,
+	0xE401, 0x24C0, 0x2580, 0xE541, 0x2700, 0xE7C1, 0xE681, 0x2640,
+	0x2200, 0xE2C1, 0xE381, 0x2340, 0xE101, 0x21C0, 0x2080, 0xE041,
+	0xA001, 0x60C0, 0x6180, 0xA141, 0x6300, 0xA3C1, 0xA281, 0x6240,
+	0x6600, 0xA6C1, 0xA781, 0x6740, 0xA501, 0x65C0, 0x6480, 0xA441,
+	0x6C00, 0xACC1, 0xAD81, 0x6D40, 0xAF01, 0x6FC0, 0x6E80, 0xAE41,
+	0xAA01, 0x6AC0, 0x6B80, 0xAB41, 0x6900, 0xA9C1, 0xA881, 0x6840,
+	0x7800, 0xB8C1, 0xB981, 0x7940, 0xBB01, 0x7BC0, 0x7A80, 0xBA41,
+	0xBE01, 0x7EC0, 0x7F80, 0xBF41, 0x7D00, 0xBDC1, 0xBC81, 0x7C40,
+	0xB401, 0x74C0, 0x7580, 0xB541, 0x7700, 0xB7C1, 0xB681, 0x7640,
+	0x7200, 0xB2C1, 0xB381, 0x7340, 0xB101, 0x71C0, 0x7080, 0xB041,
+	0x5000, 0x90C1, 0x9181, 0x5140, 0x9301, 0x53C0, 0x5280, 0x9241,
+	0x9601, 0x56C0, 0x5780, 0x9741, 0x5500, 0x95C1, 0x9481, 0x5440,
+	0x9C01, 0x5CC0, 0x5D80, 0x9D41, 0x5F00, 0x9FC1, 0x9E81, 0x5E40,
+	0x5A00, 0x9AC1, 0x9B81, 0x5B40, 0x9901, 0x59C0, 0x5880, 0x9841,
+	0x8801, 0x48C0, 0x4980, 0x8941, 0x4B00, 0x8BC1, 0x8A81, 0x4A40,
+	0x4E00, 0x8EC1, 0x8F81, 0x4F40, 0x8D01, 0x4DC0, 0x4C80, 0x8C41,
+	0x4400, 0x84C1, 0x8581, 0x4540, 0x8701, 0x47C0, 0x4680, 0x8641,
+	0x8201, 0x42C0, 0x4380, 0x8341, 0x4100, 0x81C1, 0x8081, 0x4040,
+};
+
+int64_t rtuLastFrameEndUs()
+{
+	return lastFrameEndUs;
+}
+
+uint16_t rtuCrc16(const uint8_t *buf, size_t len)
+{
+	uint16_t crc = 0xFFFF;
+	for (size_t i = 0; i < len; ++i)
+	{
+		crc = (crc >> 8) ^ rtuCrcTable[(crc ^ buf[i]) & 0xFF];
+	}
+	return crc;
+}
+
+void rtuInit()
+{
+	uart_config_t cfg = {};
+	cfg.baud_rate = MODBUS_BAUDRATE;
+	cfg.data_bits = UART_DATA_8_BITS;
+	cfg.parity = UART_PARITY_DISABLE;
+	cfg.stop_bits = UART_STOP_BITS_1;
+	cfg.flow_ctrl = UART_HW_FLOWCTRL_DISABLE;
+	cfg.source_clk = UART_SCLK_DEFAULT;
+
+	// TX-Puffer 0: uart_write_bytes() kopiert direkt in den HW-FIFO (unsere Anfragen sind <= 8 Byte).
+	uart_driver_install(RTU_UART, RTU_RX_BUF_SIZE, 0, RTU_EVENT_QUEUE_LEN, &rtuEventQueue, 0);
+	uart_param_config(RTU_UART, &cfg);
+	uart_set_pin(RTU_UART, TXD, RXD, UART_PIN_NO_CHANGE, UART_PIN_NO_CHANGE);
+	uart_set_rx_timeout(RTU_UART, RTU_RX_TIMEOUT_SYMBOLS);
+	uart_set_rx_full_threshold(RTU_UART, RTU_RX_FULL_THRESHOLD);
+
+	// do we have a flow control pin?
+	if (RTS != NOT_A_PIN)
+	{
+		// Init in receive mode
+		pinMode(RTS, OUTPUT);
+		digitalWrite(RTS, 0);
+	}
+}
+
+// Verwirft alles, was seit der letzten Transaktion eingegangen ist (Fremdverkehr des Tuya-Masters/
+// Displays, Reste verstuemmelter Frames), samt der zugehoerigen Events.
+static void rtuDiscardInput()
+{
+	uart_flush_input(RTU_UART);
+	xQueueReset(rtuEventQueue);
+	listenLen = 0;
+	listenOverflow = false;
+}
+
+// Verarbeitet ein Event ausserhalb einer eigenen Transaktion: Bytes sammeln, bei timeout_flag das
+// fertige Fremd-Frame samt Zeitstempeln an den Handler geben. Die Zeitstempel werden aus dem
+// Event-Zeitpunkt zurueckgerechnet (Frame-Ende = jetzt - RX-Timeout, Beginn = Ende - Laenge).
+static void rtuListenEvent(const uart_event_t &ev)
+{
+	int64_t now = esp_timer_get_time();
+	if (ev.type == UART_FIFO_OVF || ev.type == UART_BUFFER_FULL)
+	{
+		rtuDiscardInput();
+		lastRxUs = now;
+		return;
+	}
+	if (ev.type != UART_DATA)
+	{
+		return;
+	}
+	int64_t rxEnd = ev.timeout_flag ? now - RTU_RX_TIMEOUT_SYMBOLS * RTU_CHAR_US : now;
+	size_t avail = ev.size;
+	if (listenLen == 0 && !listenOverflow)
+	{
+		listenStartUs = rxEnd - (int64_t)avail * RTU_CHAR_US;
+	}
+	if (avail > 0)
+	{
+		lastRxUs = rxEnd;
+	}
+	while (avail > 0)
+	{
+		if (listenLen + avail > RTU_MAX_FRAME)
+		{
+			listenOverflow = true; // kein gueltiges Modbus-Frame mehr, nur noch abraeumen
+		}
+		uint8_t sink[32];
+		uint8_t *dst = listenOverflow ? sink : listenBuf + listenLen;
+		size_t n = listenOverflow ? (avail > sizeof(sink) ? sizeof(sink) : avail) : avail;
+		int got = uart_read_bytes(RTU_UART, dst, n, 0);
+		if (got <= 0)
+		{
+			break;
+		}
+		if (!listenOverflow)
+		{
+			listenLen += got;
+		}
+		avail -= got;
+	}
+	if (!ev.timeout_flag)
+	{
+		return; // Frame laeuft noch
+	}
+	if (foreignFrameHandler != nullptr && (listenLen > 0 || listenOverflow))
+	{
+		foreignFrameHandler(listenBuf, listenOverflow ? 0 : listenLen, listenStartUs, rxEnd);
+	}
+	listenLen = 0;
+	listenOverflow = false;
+}
+
+void rtuSetForeignFrameHandler(rtu_frame_handler_t handler)
+{
+	foreignFrameHandler = handler;
+}
+
+void rtuListen(uint32_t wait_ms)
+{
+	if (rtuEventQueue == nullptr)
+	{
+		vTaskDelay(pdMS_TO_TICKS(wait_ms));
+		return;
+	}
+	TickType_t deadline = xTaskGetTickCount() + pdMS_TO_TICKS(wait_ms);
+	for (;;)
+	{
+		int32_t remaining = (int32_t)(deadline - xTaskGetTickCount());
+		uart_event_t ev;
+		if (xQueueReceive(rtuEventQueue, &ev, remaining > 0 ? remaining : 0) != pdTRUE)
+		{
+			return;
+		}
+		rtuListenEvent(ev);
+	}
+}
+
+bool rtuLineBusy()
+{
+	// Ein Frame im Aufbau (FIFO-Schwelle gemeldet, Timeout noch nicht) oder Zeichen juenger als t3.5.
+	return listenLen > 0 || listenOverflow || esp_timer_get_time() - lastRxUs < rtuT35Us;
+}
+
+int64_t rtuLastForeignRxUs()
+{
+	return lastRxUs;
+}
+
+int64_t rtuTransactionUs(size_t req_len, size_t resp_len)
+{
+	// Zeichen beider Richtungen (+CRC) + 2x t3.5 + typische Slave-Antwortlatenz.
+	return (int64_t)(req_len + resp_len + 4) * RTU_CHAR_US + 2 * rtuT35Us + RTU_SLAVE_LATENCY_US;
+}
+
+// Sendet ein Anfrage-Frame (CRC wird hier angehaengt) und sammelt die Antwort bis zum Frame-Ende.
+// expected_len = Laenge der regulaeren Antwort inkl. CRC; eine Exception-Antwort (5 Byte) wird
+// ebenfalls erkannt. resp muss RTU_MAX_FRAME Byte fassen. Ergebnis und Fehlerklassen wie
+// ModbusMaster::ModbusMasterTransaction().
+static uint8_t rtuTransaction(uint8_t *req, size_t req_len, uint8_t *resp, size_t expected_len)
+{
+	if (rtuEventQueue == nullptr)
+	{
+		return MB_RESULT_RESPONSE_TIMED_OUT;
+	}
+	uint16_t crc = rtuCrc16(req, req_len);
+	req[req_len++] = crc & 0xFF;
+	req[req_len++] = crc >> 8;
+
+	// Inter-Frame-Abstand nur, falls das letzte Frame noch keine t3.5 her ist (dann per vTaskDelay).
+	int64_t since = esp_timer_get_time() - lastFrameEndUs;
+	if (since < rtuT35Us)
+	{
+		vTaskDelay(pdMS_TO_TICKS((rtuT35Us - since) / 1000 + 1));
+	}
+
+	// Bis hierher Aufgelaufenes noch als Fremdverkehr auswerten (Zeitstempel fuer den Arbiter), erst
+	// danach verwerfen; Reste eines verstuemmelten Frames duerfen nicht in unsere Antwort geraten.
+	rtuListen(0);
+	rtuDiscardInput();
+	preTransmission();
+	uart_write_bytes(RTU_UART, (const char *)req, req_len);
+	// Blockiert auf der TX-Done-Semaphore des Treibers (kein Busy-Wait), bis das letzte Stopbit
+	// draussen ist — erst dann darf der Transceiver auf Empfang, sonst wird das Frame-Ende abgeschnitten.
+	uart_wait_tx_done(RTU_UART, pdMS_TO_TICKS(100));
+	postTransmission();
+	lastFrameEndUs = esp_timer_get_time();
+
+	size_t len = 0;
+	bool overflow = false;
+	TickType_t deadline = xTaskGetTickCount() + pdMS_TO_TICKS(MODBUS_TIMEOUT);
+	for (;;)
+	{
+		int32_t remaining = (int32_t)(deadline - xTaskGetTickCount());
+		uart_event_t ev;
+		if (remaining <= 0 || xQueueReceive(rtuEventQueue, &ev, remaining) != pdTRUE)
+		{
+			lastFrameEndUs = esp_timer_get_time();
+			return MB_RESULT_RESPONSE_TIMED_OUT;
+		}
+		if (ev.type == UART_FIFO_OVF || ev.type == UART_BUFFER_FULL)
+		{
+			rtuDiscardInput();
+			overflow = true;
+			continue;
+		}
+		if (ev.type != UART_DATA)
+		{
+			continue; // Frame-/Parity-/Break-Fehler: das Frame faellt spaeter durch die CRC-Pruefung
+		}
+		size_t avail = ev.size;
+		if (len + avail > RTU_MAX_FRAME)
+		{
+			overflow = true; // laenger als jede gueltige Antwort -> Fremdverkehr, nur noch abraeumen
+		}
+		if (!overflow)
+		{
+			int n = uart_read_bytes(RTU_UART, resp + len, avail, 0);
+			if (n > 0)
+			{
+				len += n;
+			}
+		}
+		else
+		{
+			uint8_t sink[32];
+			while (avail > 0)
+			{
+				size_t n = avail > sizeof(sink) ? sizeof(sink) : avail;
+				uart_read_bytes(RTU_UART, sink, n, 0);
+				avail -= n;
+			}
+		}
+		if (!ev.timeout_flag)
+		{
+			continue; // FIFO-Schwelle erreicht, Frame laeuft noch
+		}
+		// Leitung t3.5 still. Ein Slave mit Luecken im Frame koennte hier zu frueh enden: solange
+		// weder die volle Laenge noch eine Exception-Antwort vorliegt, bis zur Deadline weiter sammeln.
+		bool exception = len >= 5 && (resp[1] & 0x80);
+		if (overflow || len >= expected_len || exception)
+		{
+			break;
+		}
+	}
+	lastFrameEndUs = esp_timer_get_time();
+
+	if (overflow || len < 5)
+	{
+		return MB_RESULT_INVALID_CRC;
+	}
+	uint16_t rx_crc = resp[len - 2] | (resp[len - 1] << 8);
+	if (rtuCrc16(resp, len - 2) != rx_crc)
+	{
+		return MB_RESULT_INVALID_CRC;
+	}
+	if (resp[0] != req[0])
+	{
+		return MB_RESULT_INVALID_SLAVE_ID;
+	}
+	if ((resp[1] & 0x7F) != req[1])
+	{
+		return MB_RESULT_INVALID_FUNCTION;
+	}
+	if (resp[1] & 0x80)
+	{
+		return resp[2]; // Exception-Code 01..06 == MB_RESULT_ILLEGAL_* / SLAVE_DEVICE_* / ACKNOWLEDGE
+	}
+	if (len != expected_len)
+	{
+		return MB_RESULT_INVALID_FUNCTION; // gueltiges Frame, passt aber nicht zur Anfrage
+	}
+	return MB_RESULT_SUCCESS;
+}
+
+uint8_t rtuReadHoldingRegisters(uint16_t start, uint16_t count, uint16_t *out)
+{
+	if (count == 0 || count > RTU_MAX_READ_REGS)
+	{
+		return MB_RESULT_ILLEGAL_DATA_VALUE;
+	}
+	uint8_t req[8] = {MODBUS_UNIT, 0x03, (uint8_t)(start >> 8), (uint8_t)start, (uint8_t)(count >> 8), (uint8_t)count};
+	uint8_t resp[RTU_MAX_FRAME];
+	uint8_t result = rtuTransaction(req, 6, resp, 5 + 2 * count);
+	if (result != MB_RESULT_SUCCESS)
+	{
+		return result;
+	}
+	if (resp[2] != 2 * count)
+	{
+		return MB_RESULT_INVALID_FUNCTION;
+	}
+	for (uint16_t i = 0; i < count; ++i)
+	{
+		out[i] = (resp[3 + 2 * i] << 8) | resp[4 + 2 * i];
+	}
+	return MB_RESULT_SUCCESS;
+}
+
+uint8_t rtuWriteSingleRegister(uint16_t addr, uint16_t value)
+{
+	uint8_t req[8] = {MODBUS_UNIT, 0x06, (uint8_t)(addr >> 8), (uint8_t)addr, (uint8_t)(value >> 8), (uint8_t)value};
+	uint8_t resp[RTU_MAX_FRAME];
+	uint8_t result = rtuTransaction(req, 6, resp, 8);
+	if (result != MB_RESULT_SUCCESS)
+	{
+		return result;
+	}
+	// FC06 spiegelt Adresse und Wert; Abweichung = Antwort gehoert nicht zu dieser Anfrage.
+	if (memcmp(resp, req, 6) != 0)
+	{
+		return MB_RESULT_INVALID_FUNCTION;
+	}
+	return MB_RESULT_SUCCESS;
+}
+
+uint8_t rtuWriteMultipleRegisters(uint16_t start, uint16_t count, const uint16_t *values)
+{
+	if (count == 0 || count > RTU_MAX_WRITE_REGS)
+	{
+		return MB_RESULT_ILLEGAL_DATA_VALUE;
+	}
+	uint8_t req[RTU_MAX_FRAME];
+	size_t len = 0;
+	req[len++] = MODBUS_UNIT;
+	req[len++] = 0x10;
+	req[len++] = start >> 8;
+	req[len++] = start;
+	req[len++] = count >> 8;
+	req[len++] = count;
+	req[len++] = 2 * count;
+	for (uint16_t i = 0; i < count; ++i)
+	{
+		req[len++] = values[i] >> 8;
+		req[len++] = values[i];
+	}
+	uint8_t resp[RTU_MAX_FRAME];
+	uint8_t result = rtuTransaction(req, len, resp, 8);
+	if (result != MB_RESULT_SUCCESS)
+	{
+		return result;
+	}
+	// FC16 bestaetigt Startadresse und Anzahl.
+	if (memcmp(resp + 2, req + 2, 4) != 0)
+	{
+		return MB_RESULT_INVALID_FUNCTION;
+	}
+	return MB_RESULT_SUCCESS;
+}
@@ -0,0 +1,70 @@
+#ifndef SRC_MODBUS_RTU_H_
+#define SRC_MODBUS_RTU_H_
+
+#include "Arduino.h"
+
+// Nativer Modbus-RTU-Transport auf dem ESP-IDF-UART-Treiber (ersetzt die ModbusMaster-Lib).
+// ModbusMaster pollte _serial->available() und gab nur ueber den idle-Callback (delay(1)) ab, vor
+// jedem Frame spann delayMicroseconds(t3_5). Hier blockiert der Worker stattdessen auf der Event-
+// Queue des UART-Treibers: das Frame-Ende meldet der RX-Timeout-Interrupt (Leitung >= t3.5 still),
+// das Senden wartet per uart_wait_tx_done() auf die TX-Semaphore. Waehrend eines anstehenden
+// MODBUS_TIMEOUT ist Core 0 damit komplett frei fuer AsyncTCP.
+
+// Ergebniscodes: bewusst WERTGLEICH mit ModbusMaster::ku8MB*, damit Logs/modbus_status und die
+// Fehlerklassen (isTransientModbusError) gegenueber der alten Lib unveraendert bleiben.
+#define MB_RESULT_SUCCESS              0x00
+#define MB_RESULT_ILLEGAL_FUNCTION     0x01 // Slave-Exception 01
+#define MB_RESULT_ILLEGAL_DATA_ADDRESS 0x02 // Slave-Exception 02
+#define MB_RESULT_ILLEGAL_DATA_VALUE   0x03 // Slave-Exception 03
+#define MB_RESULT_SLAVE_DEVICE_FAILURE 0x04 // Slave-Exception 04
+#define MB_RESULT_ACKNOWLEDGE          0x05 // Slave-Exception 05 (Anfrage angenommen, dauert)
+#define MB_RESULT_SLAVE_DEVICE_BUSY    0x06 // Slave-Exception 06
+#define MB_RESULT_INVALID_SLAVE_ID     0xE0 // Antwort von fremder Unit-ID (Fremdverkehr)
+#define MB_RESULT_INVALID_FUNCTION     0xE1 // Antwort passt nicht zur Anfrage (Funktion/Laenge)
+#define MB_RESULT_RESPONSE_TIMED_OUT   0xE2 // kein vollstaendiges Frame innerhalb MODBUS_TIMEOUT
+#define MB_RESULT_INVALID_CRC          0xE3 // Frame verstuemmelt (CRC falsch / zu kurz)
+
+// Groesster Block pro Read-Transaktion (wie ku8MaxBufferSize der frueheren Lib). Das Protokoll
+// erlaubt 125; 64 haelt den Antwortpuffer klein und alle bestehenden Ranges/Chunks passen.
+#define RTU_MAX_READ_REGS 64
+
+// UART-Treiber installieren, Pins/Baudrate/RX-Timeout setzen, Richtungspin auf Empfang.
+void rtuInit();
+
+// FC03: liest count (<= RTU_MAX_READ_REGS) Holding-Register ab start nach out[]. Genau eine
+// Transaktion, kein Retry (der liegt aufrufseitig). Rueckgabe: MB_RESULT_*.
+uint8_t rtuReadHoldingRegisters(uint16_t start, uint16_t count, uint16_t *out);
+
+// FC06: schreibt ein Holding-Register. Rueckgabe: MB_RESULT_*.
+uint8_t rtuWriteSingleRegister(uint16_t addr, uint16_t value);
+
+// FC16: schreibt count (<= RTU_MAX_WRITE_REGS) zusammenhaengende Holding-Register ab start in EINER
+// Transaktion (Write-Coalescing im Worker). Rueckgabe: MB_RESULT_*.
+#define RTU_MAX_WRITE_REGS 32
+uint8_t rtuWriteMultipleRegisters(uint16_t start, uint16_t count, const uint16_t *values);
+
+// esp_timer-Zeitpunkt (us), zu dem die letzte Transaktion endete (Antwort komplett bzw. Timeout).
+// Basis fuer den adaptiven Bus-Gap (modbus_gap.h).
+int64_t rtuLastFrameEndUs();
+
+// --- Mithoeren (Listen-before-talk, modbus_arbiter.h) ------------------------------------
+// Zwischen den eigenen Transaktionen gehoert der Bus auch dem Display (und ggf. dem Tuya-Master).
+// Statt deren Frames vor jeder Anfrage blind zu verwerfen, wertet rtuListen() sie aus: jedes
+// vollstaendige Fremd-Frame geht mit geschaetztem Beginn/Ende (esp_timer, us) an den Handler.
+// len = 0 bei einem ueberlangen (verstuemmelten) Frame — das Timing zaehlt trotzdem.
+typedef void (*rtu_frame_handler_t)(const uint8_t *frame, size_t len, int64_t start_us, int64_t end_us);
+void rtuSetForeignFrameHandler(rtu_frame_handler_t handler);
+// Blockiert bis zu wait_ms auf der UART-Event-Queue und verarbeitet dabei eingehenden Fremdverkehr;
+// wait_ms = 0 verarbeitet nur Aufgelaufenes. Ersetzt vTaskDelay() ueberall, wo der Worker auf den Bus wartet.
+void rtuListen(uint32_t wait_ms);
+// true, solange ein Fremd-Frame laeuft bzw. das letzte Fremdzeichen juenger als t3.5 ist.
+bool rtuLineBusy();
+int64_t rtuLastForeignRxUs();
+// Geschaetzte Busbelegung einer eigenen Transaktion (Anfrage + Antwort in Byte, ohne CRC) in us.
+#define RTU_SLAVE_LATENCY_US 50000 // typische Antwortverzoegerung des Slaves (Diagnose-Dumps)
+int64_t rtuTransactionUs(size_t req_len, size_t resp_len);
+
+// CRC16/MODBUS (Polynom 0xA001, Start 0xFFFF), tabellengetrieben.
+uint16_t rtuCrc16(const uint8_t *buf, size_t len);
+
+#endif // SRC_MODBUS_RTU_H_
@@ -0,0 +1,180 @@
+#include "modbus_scope.h"
+#include "modbus_base.h"
+#include <esp_timer.h>
+
+// Zustand unter scopeMux (Webserver startet/stoppt/liest, der Worker nimmt auf). Die Sample-Daten
+// selbst schreibt nur der Worker, und zwar bevor er info.samples erhoeht -> jedes Sample < samples
+// ist vollstaendig.
+static portMUX_TYPE scopeMux = portMUX_INITIALIZER_UNLOCKED;
+static uint8_t *scopeBuf = nullptr; // einmal reserviert, nie freigegeben
+static modbus_scope_info_t info = {};
+static int64_t startUs = 0; // esp_timer beim ersten Sample, 0 = noch keins
+
+// Nur Worker-Task.
+static uint32_t workGen = 0;
+static uint8_t errorsInRow = 0;
+
+static size_t sampleBytes(uint16_t count)
+{
+	return sizeof(uint32_t) + count * sizeof(uint16_t);
+}
+
+bool scopeStart(uint16_t start, uint16_t count, uint32_t windowMs)
+{
+	if (count == 0 || count > MODBUS_SCOPE_MAX_REGS || (uint32_t)start + count > 0x10000)
+	{
+		return false;
+	}
+	if (scopeBuf == nullptr)
+	{
+		scopeBuf = (uint8_t *)malloc(MODBUS_SCOPE_BUFFER_BYTES);
+		if (scopeBuf == nullptr)
+		{
+			log(LOG_LEVEL_ERROR, "Scope: kein RAM fuer den Puffer");
+			return false;
+		}
+	}
+	windowMs = constrain(windowMs, (uint32_t)MODBUS_SCOPE_MIN_WINDOW_MS, (uint32_t)MODBUS_SCOPE_MAX_WINDOW_MS);
+	portENTER_CRITICAL(&scopeMux);
+	if (info.state == SCOPE_RUNNING)
+	{
+		portEXIT_CRITICAL(&scopeMux);
+		return false;
+	}
+	info.gen++;
+	info.state = SCOPE_RUNNING;
+	info.start = start;
+	info.count = count;
+	info.windowMs = windowMs;
+	info.samples = 0;
+	info.capacity = MODBUS_SCOPE_BUFFER_BYTES / sampleBytes(count);
+	info.errors = 0;
+	info.durationUs = 0;
+	info.end = nullptr;
+	startUs = 0;
+	portEXIT_CRITICAL(&scopeMux);
+	LOGF(LOG_LEVEL_WARNING, "Scope gestartet: Register %u..%u fuer %lu ms", start, start + count - 1, (unsigned long)windowMs);
+	return true;
+}
+
+// Beendet die Aufnahme gen (0 = die laufende, egal welche).
+static void finishScope(uint32_t gen, const char *reason)
+{
+	portENTER_CRITICAL(&scopeMux);
+	if (info.state != SCOPE_RUNNING || (gen != 0 && gen != info.gen))
+	{
+		portEXIT_CRITICAL(&scopeMux);
+		return;
+	}
+	info.state = SCOPE_DONE;
+	info.end = reason;
+	modbus_scope_info_t done = info;
+	portEXIT_CRITICAL(&scopeMux);
+	LOGF(LOG_LEVEL_WARNING, "Scope beendet (%s): %lu Samples in %lu ms, %lu Fehler", reason,
+		 (unsigned long)done.samples, (unsigned long)(done.durationUs / 1000), (unsigned long)done.errors);
+}
+
+void scopeStop(const char *reason)
+{
+	finishScope(0, reason);
+}
+
+modbus_scope_info_t scopeInfo()
+{
+	portENTER_CRITICAL(&scopeMux);
+	modbus_scope_info_t copy = info;
+	portEXIT_CRITICAL(&scopeMux);
+	return copy;
+}
+
+bool scopeSample(uint32_t gen, uint32_t i, uint32_t &tUs, uint16_t *values)
+{
+	bool ok = false;
+	portENTER_CRITICAL(&scopeMux);
+	if (gen == info.gen && i < info.samples)
+	{
+		const uint8_t *p = scopeBuf + i * sampleBytes(info.count);
+		memcpy(&tUs, p, sizeof(uint32_t));
+		memcpy(values, p + sizeof(uint32_t), info.count * sizeof(uint16_t));
+		ok = true;
+	}
+	portEXIT_CRITICAL(&scopeMux);
+	return ok;
+}
+
+bool scopeActive()
+{
+	return info.state == SCOPE_RUNNING;
+}
+
+void serviceScope()
+{
+	portENTER_CRITICAL(&scopeMux);
+	modbus_scope_info_t cur = info;
+	int64_t t0 = startUs;
+	portEXIT_CRITICAL(&scopeMux);
+	if (cur.state != SCOPE_RUNNING)
+	{
+		return;
+	}
+	if (cur.gen != workGen)
+	{
+		workGen = cur.gen;
+		errorsInRow = 0;
+	}
+	int64_t now = esp_timer_get_time();
+	if (t0 == 0)
+	{
+		t0 = now;
+		portENTER_CRITICAL(&scopeMux);
+		if (info.gen == cur.gen)
+		{
+			startUs = t0;
+		}
+		portEXIT_CRITICAL(&scopeMux);
+	}
+	if (now - t0 >= (int64_t)cur.windowMs * 1000)
+	{
+		finishScope(cur.gen, "window");
+		return;
+	}
+	if (cur.samples >= cur.capacity)
+	{
+		finishScope(cur.gen, "full");
+		return;
+	}
+	uint16_t values[MODBUS_SCOPE_MAX_REGS];
+	uint8_t result = modbusReadBlock(cur.start, cur.count, values);
+	if (result != MB_RESULT_SUCCESS)
+	{
+		portENTER_CRITICAL(&scopeMux);
+		if (info.gen == cur.gen)
+		{
+			info.errors++;
+		}
+		portEXIT_CRITICAL(&scopeMux);
+		if (!isTransientModbusError(result))
+		{
+			LOGF(LOG_LEVEL_ERROR, "Scope: Register %u..%u nicht lesbar (result=0x%x)", cur.start, cur.start + cur.count - 1, result);
+			finishScope(cur.gen, "error");
+		}
+		else if (++errorsInRow >= MODBUS_SCOPE_MAX_ERRORS)
+		{
+			LOGF(LOG_LEVEL_ERROR, "Scope: %u Fehler in Folge (result=0x%x)", errorsInRow, result);
+			finishScope(cur.gen, "error");
+		}
+		return;
+	}
+	errorsInRow = 0;
+	uint32_t t = (uint32_t)(rtuLastFrameEndUs() - t0);
+	uint8_t *p = scopeBuf + cur.samples * sampleBytes(cur.count);
+	memcpy(p, &t, sizeof(uint32_t));
+	memcpy(p + sizeof(uint32_t), values, cur.count * sizeof(uint16_t));
+	portENTER_CRITICAL(&scopeMux);
+	if (info.gen == cur.gen && info.state == SCOPE_RUNNING)
+	{
+		info.samples = cur.samples + 1;
+		info.durationUs = t;
+	}
+	portEXIT_CRITICAL(&scopeMux);
+}
@@ -0,0 +1,63 @@
+#ifndef SRC_MODBUS_SCOPE_H_
+#define SRC_MODBUS_SCOPE_H_
+
+#include "Arduino.h"
+
+// Scope-Modus: einen kleinen Registerblock so schnell lesen, wie Bus und Slave es hergeben, fuer
+// Vorgaenge, die der Poll-Zyklus (1..3 s je Klasse) nicht aufloest: Verdichteranlauf, Luefterrampe,
+// Abtauen, Regelschleifen-Timing. Obergrenze der Rate: gelernter Bus-Gap (>= MODBUS_GAP_MIN_MS) plus
+// eine Transaktion je Sample, bei 9600 Baud also hoechstens ~15 Hz. Der Gap bleibt bewusst: er
+// schuetzt den Slave vor zu dicht folgenden Anfragen (modbus_gap.h).
+// Waehrend einer Aufnahme liest der Worker nur noch diesen Block (eine Transaktion je Sample, Bus-Gap
+// und Listen-before-talk gelten weiter); Poll, Dump-Chunks und Discovery pausieren, Writes haben
+// weiter Vorrang. Danach plant der Poll neu (alle Ranges sofort).
+//
+// Samples liegen in einem Puffer fester Groesse, der beim ersten Start einmal reserviert wird und
+// danach bleibt (keine Allokation pro Aufnahme, kein Heap-Verschnitt). Je Sample: Zeitstempel in us
+// seit Aufnahmebeginn + die Werte. Zeitstempel = Ende des Antwort-Frames (rtuLastFrameEndUs); der
+// Slave hat den Wert kurz davor (innerhalb der Antwort-Frame-Dauer) gelesen. Die Aufnahme endet nach
+// dem Zeitfenster, bei vollem Puffer, per Stop, im App-Modus oder bei einem permanenten Lesefehler.
+// Ein Fenster unter MODBUS_DUMP_STALL_MS haelt einen pausierten Dump am Leben.
+#define MODBUS_SCOPE_MAX_REGS 8				// zusammenhaengender Block, eine Transaktion je Sample
+#define MODBUS_SCOPE_BUFFER_BYTES 16384		// 1 Register: 2730 Samples, 8 Register: 819 Samples
+#define MODBUS_SCOPE_DEFAULT_WINDOW_MS 10000
+#define MODBUS_SCOPE_MIN_WINDOW_MS 100
+#define MODBUS_SCOPE_MAX_WINDOW_MS 20000
+#define MODBUS_SCOPE_MAX_ERRORS 10			// so viele transiente Fehler in Folge -> Abbruch
+
+enum modbus_scope_state_t
+{
+	SCOPE_IDLE,	   // noch nie aufgenommen
+	SCOPE_RUNNING,
+	SCOPE_DONE	   // Aufnahme liegt zum Download bereit
+};
+
+typedef struct
+{
+	uint32_t gen;		 // zaehlt je Start hoch; der Download prueft damit, ob der Puffer noch passt
+	modbus_scope_state_t state;
+	uint16_t start;
+	uint16_t count;
+	uint32_t windowMs;
+	uint32_t samples;
+	uint32_t capacity;	 // Samples, die der Puffer bei count Registern fasst
+	uint32_t errors;	 // fehlgeschlagene Reads (ohne Sample)
+	uint32_t durationUs; // Zeitstempel des letzten Samples
+	const char *end;	 // Grund des Endes ("window", "full", "stop", "app", "error"), nullptr solange sie laeuft
+} modbus_scope_info_t;
+
+// Startet eine Aufnahme von [start, start+count) fuer windowMs (wird auf MIN..MAX begrenzt). false,
+// wenn count nicht passt, schon eine Aufnahme laeuft oder der Puffer nicht reserviert werden kann.
+bool scopeStart(uint16_t start, uint16_t count, uint32_t windowMs);
+// Beendet eine laufende Aufnahme (reason landet in info.end und im Log). Aus jedem Task.
+void scopeStop(const char *reason);
+modbus_scope_info_t scopeInfo();
+// Sample i der Aufnahme gen nach tUs/values (info.count Werte). false, wenn inzwischen neu gestartet
+// wurde oder i >= samples.
+bool scopeSample(uint32_t gen, uint32_t i, uint32_t &tUs, uint16_t *values);
+
+// Worker-Task (modbus_base.cpp): laeuft eine Aufnahme bzw. ein Sample aufnehmen.
+bool scopeActive();
+void serviceScope();
+
+#endif // SRC_MODBUS_SCOPE_H_
@@ -0,0 +1,164 @@
+#include "modbus_sniffer.h"
+#include "modbus_base.h"
+
+// Nur aus dem Worker-Task (rtuListen -> Frame-Handler); die Zaehler liest der Loop-Task.
+static sniff_handler_t sniffHandler = nullptr;
+static sniff_state_t sniffState = SNIFF_IDLE;
+static uint8_t pendingFc = 0;
+static uint16_t pendingStart = 0;
+static uint16_t pendingCount = 0;
+static uint16_t pendingValues[RTU_MAX_READ_REGS]; // FC06/FC16: Werte aus der Anfrage
+static int64_t pendingEndUs = 0;
+static volatile uint32_t pairs = 0;
+static volatile uint32_t dropped = 0;
+
+static uint16_t be16(const uint8_t *p)
+{
+	return (p[0] << 8) | p[1];
+}
+
+static void deliver(uint16_t start, uint16_t count, const uint16_t *values)
+{
+	pairs++;
+	if (sniffHandler != nullptr)
+	{
+		sniffHandler(start, count, values);
+	}
+}
+
+// Versucht das Frame als Antwort auf die gemerkte Anfrage zu deuten. true = verbraucht.
+static bool matchResponse(const uint8_t *frame, size_t len)
+{
+	if ((frame[1] & 0x7F) != pendingFc)
+	{
+		return false;
+	}
+	if (frame[1] & 0x80)
+	{
+		return len == 5; // Exception: Anfrage erledigt, keine Werte
+	}
+	switch (pendingFc)
+	{
+	case 0x03:
+	{
+		if (len != 5u + 2 * pendingCount || frame[2] != 2 * pendingCount)
+		{
+			return false;
+		}
+		uint16_t values[RTU_MAX_READ_REGS];
+		for (uint16_t i = 0; i < pendingCount; ++i)
+		{
+			values[i] = be16(frame + 3 + 2 * i);
+		}
+		deliver(pendingStart, pendingCount, values);
+		return true;
+	}
+	case 0x06:
+		// Echo der Anfrage (Adresse + Wert)
+		if (len != 8 || be16(frame + 2) != pendingStart || be16(frame + 4) != pendingValues[0])
+		{
+			return false;
+		}
+		deliver(pendingStart, 1, pendingValues);
+		return true;
+	case 0x10:
+		// Bestaetigung: Startadresse + Anzahl
+		if (len != 8 || be16(frame + 2) != pendingStart || be16(frame + 4) != pendingCount)
+		{
+			return false;
+		}
+		deliver(pendingStart, pendingCount, pendingValues);
+		return true;
+	}
+	return false;
+}
+
+// Merkt sich das Frame als Anfrage, falls es eine ist, die wir auswerten koennen. true = Anfrage.
+static bool takeRequest(const uint8_t *frame, size_t len)
+{
+	uint8_t fc = frame[1];
+	if (fc == 0x03 && len == 8)
+	{
+		uint16_t count = be16(frame + 4);
+		if (count == 0 || count > RTU_MAX_READ_REGS)
+		{
+			return false;
+		}
+		pendingCount = count;
+	}
+	else if (fc == 0x06 && len == 8)
+	{
+		pendingCount = 1;
+		pendingValues[0] = be16(frame + 4);
+	}
+	else if (fc == 0x10 && len >= 9)
+	{
+		uint16_t count = be16(frame + 4);
+		if (count == 0 || count > RTU_MAX_READ_REGS || frame[6] != 2 * count || len != 9u + 2 * count)
+		{
+			return false;
+		}
+		pendingCount = count;
+		for (uint16_t i = 0; i < count; ++i)
+		{
+			pendingValues[i] = be16(frame + 7 + 2 * i);
+		}
+	}
+	else
+	{
+		return false;
+	}
+	pendingFc = fc;
+	pendingStart = be16(frame + 2);
+	return true;
+}
+
+void snifferSetHandler(sniff_handler_t handler)
+{
+	sniffHandler = handler;
+}
+
+void snifferFrame(const uint8_t *frame, size_t len, int64_t start_us, int64_t end_us)
+{
+	if (len < 5 || rtuCrc16(frame, len - 2) != (uint16_t)(frame[len - 2] | (frame[len - 1] << 8)))
+	{
+		// Verstuemmelt (Kollision): eine offene Anfrage ist nicht mehr sicher zuzuordnen.
+		dropped++;
+		sniffState = SNIFF_IDLE;
+		return;
+	}
+	if (frame[0] != MODBUS_UNIT)
+	{
+		sniffState = SNIFF_IDLE; // Verkehr mit einem anderen Teilnehmer, nicht unser Slave
+		return;
+	}
+	if (sniffState == SNIFF_AWAIT_RESPONSE)
+	{
+		sniffState = SNIFF_IDLE;
+		// FC06-Anfrage und -Antwort sind identisch -> eine Antwort hat hier immer Vorrang.
+		if (start_us - pendingEndUs <= (int64_t)MODBUS_TIMEOUT * 1000 && matchResponse(frame, len))
+		{
+			return;
+		}
+		dropped++; // Anfrage ohne passende Antwort
+	}
+	if (takeRequest(frame, len))
+	{
+		sniffState = SNIFF_AWAIT_RESPONSE;
+		pendingEndUs = end_us;
+	}
+	else
+	{
+		dropped++; // Antwort ohne Anfrage bzw. nicht ausgewertete Funktion
+	}
+}
+
+uint32_t snifferPairs()
+{
+	return pairs;
+}
+
+uint32_t snifferDropped()
+{
+	return dropped;
+}
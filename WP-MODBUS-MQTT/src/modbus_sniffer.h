@@ -0,0 +1,33 @@
+#ifndef SRC_MODBUS_SNIFFER_H_
+#define SRC_MODBUS_SNIFFER_H_
+
+#include "Arduino.h"
+
+// Passiver Bus-Decoder. Im App-Modus (setControlMode(true)) gehoert der Bus dem WBR3D, der Worker
+// sendet nichts -> /data blieb bisher fuer die ganze Dauer stehen. Der Sniffer paart die mitgehoerten
+// Anfrage-/Antwort-Frames des fremden Masters (Tuya bzw. Display) mit unserem Slave und liefert die
+// darin transportierten Registerwerte an den Handler (modbus_base.cpp -> distributeBlock-Pfad).
+// Null eigene Transaktionen. Laeuft auch im MQTT-Modus mit: was das Display liest, ist gratis frisch.
+//
+// Paarung (Zustandsmaschine je Frame):
+//   IDLE           --Anfrage FC03/06/16 an MODBUS_UNIT-->  AWAIT_RESPONSE (Anfrage gemerkt)
+//   AWAIT_RESPONSE --passende Antwort (<= MODBUS_TIMEOUT)->  Werte liefern, IDLE
+//   AWAIT_RESPONSE --Exception / fremde Unit / Timeout--->  IDLE (bzw. neue Anfrage gemerkt)
+// FC03: Werte aus der Antwort. FC06/FC16: Werte aus der Anfrage, erst mit der Bestaetigung des Slaves.
+
+typedef enum : uint8_t
+{
+	SNIFF_IDLE = 0,
+	SNIFF_AWAIT_RESPONSE
+} sniff_state_t;
+
+// Bekommt einen gepaarten Block (count <= RTU_MAX_READ_REGS) zusammenhaengender Register ab start.
+typedef void (*sniff_handler_t)(uint16_t start, uint16_t count, const uint16_t *values);
+void snifferSetHandler(sniff_handler_t handler);
+// Ein mitgehoertes Fremd-Frame (len = 0: verstuemmelt/ueberlang). Aus dem Frame-Handler des Workers.
+void snifferFrame(const uint8_t *frame, size_t len, int64_t start_us, int64_t end_us);
+// Zaehler seit Boot (fuer das /status-JSON): gepaarte Transaktionen und verworfene Frames.
+uint32_t snifferPairs();
+uint32_t snifferDropped();
+
+#endif // SRC_MODBUS_SNIFFER_H_
@@ -1,7 +1,13 @@
 #include "setupWebserver.h"
 #include "modbus_base.h"
+#include "modbus_discovery.h"
+#include "modbus_scope.h"
+#include "log_syslog.h"
+#include "web_live.h"
+#include "web_assets.h"
 #include <LittleFS.h>
 #include <Update.h>
+#include <memory>
 
 // In main.cpp definiert — Umschaltung App-/MQTT-Steuerung inkl. WBR3_EN_PIN und Modbus-Poll.
 void setControlMode(bool appControl);
@@ -33,51 +39,34 @@ static void scheduleAction(uint8_t action)
 	pendingAction = action;
 }
 
-// Registerdump 0..200 (= 201 Register). Der Bus wird vom Worker gescannt (non-blocking angestossen),
-// die HTML-Tabelle bei Fertigstellung gerendert. Der CSV-Download wird client-seitig aus genau
-// dieser Tabelle erzeugt (siehe dlcsv() im HTML) → eine Datenquelle, kein server-seitiger State.
-#define MODBUS_DUMP_START 0
-#define MODBUS_DUMP_COUNT 201
+// Registerdump: per Default 0..200 (= 201 Register), ?start=&count= waehlen einen anderen Bereich
+// bis zum ganzen Adressraum (MODBUS_DUMP_SPAN), ?format=csv|json statt der HTML-Tabelle.
+#define MODBUS_DUMP_DEFAULT_START 0
+#define MODBUS_DUMP_DEFAULT_COUNT 201
 
-// 4-stelliges Grossbuchstaben-Hex mit fuehrenden Nullen (z.B. 0x00FF → "00FF").
-static String hex4(uint16_t value)
+// Statische Oberflaeche (web/*.html, per tools/build_web.py als gzip nach web_assets.h): direkt aus
+// dem Flash, ohne String-Bau im AsyncTCP-Task. Starker ETag -> ein erneuter Aufruf kostet nur ein 304.
+// Die dynamischen Werte holt die Seite ueber /api/state (sendState).
+static void sendAsset(AsyncWebServerRequest *request, const web_asset_t &asset)
 {
-	String s = String(value, HEX);
-	s.toUpperCase();
-	while (s.length() < 4)
+	if (request->hasHeader("If-None-Match") && request->header("If-None-Match") == asset.etag)
 	{
-		s = "0" + s;
+		AsyncWebServerResponse *response = request->beginResponse(304);
+		response->addHeader("ETag", asset.etag);
+		request->send(response);
+		return;
 	}
-	return s;
+	AsyncWebServerResponse *response = request->beginResponse(200, asset.mime, asset.gz, asset.len);
+	response->addHeader("Content-Encoding", "gzip");
+	response->addHeader("ETag", asset.etag);
+	response->addHeader("Cache-Control", "no-cache"); // cachen, aber vor Verwendung per ETag pruefen
+	request->send(response);
 }
 
-// 16-stellige Binaerdarstellung mit fuehrenden Nullen.
-static String bin16(uint16_t value)
+// Alte Seiten-URLs (Lesezeichen) auf den passenden Abschnitt der statischen Oberflaeche umleiten.
+static void redirectToSection(AsyncWebServerRequest *request, const char *section)
 {
-	String s;
-	for (int8_t b = 15; b >= 0; --b)
-	{
-		s += ((value >> b) & 1) ? '1' : '0';
-	}
-	return s;
-}
-
-void handleRoot(AsyncWebServerRequest *request)
-{
-	String content = "<html><head><meta name=\"viewport\" content=\"width=device-width, initial-scale=1\">";
-	content += "<link rel=\"icon\" href=\"data:,\">";
-	content += "<style>body { font-family: Arial; text-align: center;}</style>";
-	content += "</head><body><h1>Reconfigure modbus bridge</h1>";
-	content += "<p>Click <a href=\"/reconfigure\">here</a> to reconfigure modbus bridge.</p>";
-	content += "<p>Click <a href=\"/update\">here</a> to update Firmware.</p>";
-	content += "<p>Click <a href=\"/modbusdump\">here</a> to create a Modbus register dump (0..200).</p>";
-	content += "<p>Click <a href=\"/control\">here</a> to switch control mode (Hersteller-App / MQTT).</p>";
-	content += "<p>Click <a href=\"/logs\">here</a> to view logs.</p>";
-	content += "<p>Click <a href=\"/reboot\">here</a> to reboot the ESP.</p>";
-	content += "<hr><p><small>Firmware version: " + String(FIRMWARE_VERSION) + "</small></p>";
-	content += "</body></html>";
-
-	request->send(200, "text/html", content);
+	request->redirect((String("/#") + section).c_str());
 }
 
 // Klartext-Name eines Log-Levels (siehe log.h: 1=ERROR..4=DEBUG).
@@ -93,114 +82,196 @@ static String logLevelName(int16_t level)
 	}
 }
 
-// Sendet eine Logdatei als text/plain. Liest sie unter logFsLock() komplett in einen String (<= ~32 KB,
-// FILE_LOG_MAX_BYTES) und gibt sie dann als eine Antwort aus. Der Lock wird NUR waehrend des kurzen
-// Lesens gehalten (nicht waehrend der asynchronen Uebertragung) — verhindert, dass ein gleichzeitiger
-// log()-Schreibzugriff bzw. eine Trim-/Rotate-Operation die Datei mitten im Lesen veraendert.
-static void sendLogFile(AsyncWebServerRequest *request, const char *path)
+// "bytes=a-b", "bytes=a-" oder "bytes=-n" (nur ein Bereich) gegen total pruefen. false = nicht erfuellbar.
+static bool parseByteRange(const String &header, uint32_t total, uint32_t *from, uint32_t *to)
+{
+	if (!header.startsWith("bytes=") || header.indexOf(',') >= 0 || total == 0)
+	{
+		return false;
+	}
+	String spec = header.substring(6);
+	int dash = spec.indexOf('-');
+	if (dash < 0)
+	{
+		return false;
+	}
+	String a = spec.substring(0, dash);
+	String b = spec.substring(dash + 1);
+	if (a.length() == 0)
+	{
+		uint32_t n = strtoul(b.c_str(), nullptr, 10); // Suffix: die letzten n Bytes
+		if (n == 0)
+		{
+			return false;
+		}
+		*from = n < total ? total - n : 0;
+		*to = total - 1;
+		return true;
+	}
+	*from = strtoul(a.c_str(), nullptr, 10);
+	*to = b.length() > 0 ? strtoul(b.c_str(), nullptr, 10) : total - 1;
+	if (*to >= total)
+	{
+		*to = total - 1;
+	}
+	return *from <= *to;
+}
+
+// ?raw=1: das Set unveraendert (binaere Records) fuer tools/logdecode.py, mit Content-Length und
+// HTTP-Range (Fortsetzen eines Downloads). Die Laenge steht zum Anfragezeitpunkt fest; was der
+// Writer danach anhaengt, kommt erst mit der naechsten Anfrage. Fehlen Bytes, weil inzwischen ein
+// Segment wegrotiert wurde, wird mit Nullbytes aufgefuellt (der Dekoder ueberspringt sie).
+static void sendRawLog(AsyncWebServerRequest *request, const char *set)
 {
-	if (!logFsLock(2000))
+	uint32_t total = logSetSize(set);
+	uint32_t from = 0;
+	uint32_t to = total > 0 ? total - 1 : 0;
+	bool partial = request->hasHeader("Range");
+	if (partial && !parseByteRange(request->header("Range"), total, &from, &to))
 	{
-		request->send(503, "text/plain", "Log busy, bitte erneut versuchen.");
+		AsyncWebServerResponse *response = request->beginResponse(416, "text/plain", "Range nicht erfuellbar");
+		response->addHeader("Content-Range", "bytes */" + String(total));
+		request->send(response);
 		return;
 	}
-	File f = LittleFS.open(path, "r");
-	if (!f)
+	auto cursor = std::make_shared<log_cursor_t>(); // mit Entpack-Fenster zu gross fuer Stack/Capture
+	logSetSeekByte(set, *cursor, from);
+	size_t length = total > 0 ? to - from + 1 : 0;
+	AsyncWebServerResponse *response = request->beginResponse("application/octet-stream", length,
+		[set, cursor, remaining = length](uint8_t *buffer, size_t maxLen, size_t index) mutable -> size_t
+		{
+			size_t want = maxLen < remaining ? maxLen : remaining;
+			if (want == 0)
+			{
+				return 0;
+			}
+			size_t n = logSetRead(set, *cursor, buffer, want);
+			if (n == 0)
+			{
+				memset(buffer, 0, want);
+				n = want;
+			}
+			remaining -= n;
+			return n;
+		});
+	if (partial)
+	{
+		response->setCode(206);
+		response->addHeader("Content-Range", "bytes " + String(from) + "-" + String(to) + "/" + String(total));
+	}
+	response->addHeader("Accept-Ranges", "bytes");
+	response->addHeader("Content-Disposition", "attachment; filename=\"log.bin\"");
+	request->send(response);
+}
+
+// Sendet ein Log-Set (Segmentverzeichnis, siehe log.h) als text/plain, chunked in Segment-
+// Reihenfolge. logSetRead nimmt den Log-Mutex nur je Chunk (kurzes Lesen, nicht waehrend der
+// asynchronen Uebertragung); rotiert der Writer waehrenddessen ein Segment weg, setzt der Cursor
+// beim aeltesten vorhandenen fort. Frueher wurde die ganze Datei in einen String (<= 32 KB) gelesen.
+// Die binaeren Records (log_record.h) werden dabei zu Textzeilen dekodiert. Parameter:
+//   ?level=N   nur Zeilen bis Level N (1=ERROR .. 4=DEBUG)
+//   ?tail=N    nur die letzten N passenden Zeilen (hoechstens LOG_TAIL_MAX_LINES)
+//   ?since=P   erst ab Position P: Wert aus dem Header X-Log-Next der vorigen Antwort. So kostet
+//              das Verfolgen des Logs je Abfrage nur die neuen Zeilen statt des ganzen Sets.
+//   ?raw=1     Rohdaten fuer tools/logdecode.py (siehe sendRawLog, mit Range-Unterstuetzung)
+// X-Log-Next = Ende des Sets zum Anfragezeitpunkt; spaeter geschriebene Zeilen kommen erst mit der
+// naechsten Abfrage (keine Zeile doppelt oder verloren, solange sie nicht wegrotiert ist).
+static void sendLogFile(AsyncWebServerRequest *request, const char *set)
+{
+	if (strcmp(set, FILE_LOG_SET_CURRENT) == 0)
+	{
+		// Noch im RAM-Ring stehende Zeilen schreibt der Writer-Task (nicht hier: Flash-Schreiben samt
+		// evtl. Rotation/Kompression gehoert nicht in den AsyncTCP-Task). Was er bis zu logSetEnd()
+		// geschafft hat, kommt mit; der Rest mit der naechsten Abfrage per ?since=X-Log-Next.
+		requestFileLogFlush();
+	}
+	if (!logSetExists(set))
 	{
-		logFsUnlock();
 		request->send(404, "text/plain", "Noch keine Logdatei vorhanden.");
 		return;
 	}
-	String body = f.readString();
-	f.close();
-	logFsUnlock();
-	request->send(200, "text/plain", body);
+	if (request->hasParam("raw"))
+	{
+		sendRawLog(request, set);
+		return;
+	}
+	auto cursor = std::make_shared<log_text_cursor_t>();
+	if (request->hasParam("level"))
+	{
+		cursor->maxLevel = constrain(request->getParam("level")->value().toInt(), LOG_LEVEL_ERROR, LOG_LEVEL_DEBUG);
+	}
+	cursor->end = logSetEnd(set);
+	if (request->hasParam("since"))
+	{
+		logTextSeek(set, *cursor, strtoull(request->getParam("since")->value().c_str(), nullptr, 10));
+	}
+	else if (request->hasParam("tail"))
+	{
+		logTextSeekTail(set, *cursor, request->getParam("tail")->value().toInt());
+	}
+	AsyncWebServerResponse *response = request->beginChunkedResponse("text/plain",
+		[set, cursor](uint8_t *buffer, size_t maxLen, size_t index) -> size_t
+		{
+			return logSetReadText(set, *cursor, (char *)buffer, maxLen);
+		});
+	char next[24];
+	snprintf(next, sizeof(next), "%llu", (unsigned long long)cursor->end);
+	response->addHeader("X-Log-Next", next);
+	response->addHeader("Cache-Control", "no-store");
+	request->send(response);
+}
+
+// GET /api/state: alles, was die statische Oberflaeche anzeigt (klein, ohne Registerwerte -> /events).
+static void sendState(AsyncWebServerRequest *request)
+{
+	JsonDocument doc;
+	doc["firmware"] = FIRMWARE_VERSION;
+	doc["app_control"] = isAppControlMode();
+	doc["file_log_level"] = fileLogLevel;
+	doc["syslog_active"] = syslogActive();
+	doc["syslog_level"] = syslogLevel;
+	String body;
+	serializeJson(doc, body);
+	AsyncWebServerResponse *response = request->beginResponse(200, "application/json", body);
+	response->addHeader("Cache-Control", "no-store");
+	request->send(response);
 }
 
-// /logs: GET zeigt aktuellen Datei-Log-Level + Umschalt-Buttons + Links zu den Logdateien.
-// POST setzt fileLogLevel (validiert 1..4). Der Datei-Log-Level ist unabhaengig von MAX_LOG_LEVEL
-// (Serial) und nur zur Laufzeit gedacht (kein Persistieren): nach Reboot wieder Default WARNING.
+// POST /api/logs: setzt fileLogLevel (validiert 1..4) und, falls ein Syslog-Ziel konfiguriert ist,
+// syslogLevel (0 = aus). Der Datei-Log-Level ist unabhaengig von MAX_LOG_LEVEL (Serial) und nur zur
+// Laufzeit gedacht (kein Persistieren): nach Reboot wieder Default WARNING. Antwort wie /api/state.
 void handleLogs(AsyncWebServerRequest *request)
 {
-	if (request->method() == HTTP_POST)
+	if (request->hasParam("level", true))
 	{
-		if (request->hasParam("level", true))
+		int lvl = request->getParam("level", true)->value().toInt();
+		if (lvl >= LOG_LEVEL_ERROR && lvl <= LOG_LEVEL_DEBUG)
 		{
-			int lvl = request->getParam("level", true)->value().toInt();
-			if (lvl >= LOG_LEVEL_ERROR && lvl <= LOG_LEVEL_DEBUG)
-			{
-				fileLogLevel = (int16_t)lvl;
-				log(LOG_LEVEL_WARNING, "File log level set to " + logLevelName(fileLogLevel) + " via web");
-			}
+			fileLogLevel = (int16_t)lvl;
+			log(LOG_LEVEL_WARNING, "File log level set to " + logLevelName(fileLogLevel) + " via web");
 		}
-		String content = "<html><head><meta name=\"viewport\" content=\"width=device-width, initial-scale=1\">";
-		content += "<link rel=\"icon\" href=\"data:,\"><style>body{font-family:Arial;text-align:center;}</style>";
-		content += "</head><body><h1>Log-Level geaendert</h1>";
-		content += "<p>Datei-Log-Level: <b>" + logLevelName(fileLogLevel) + "</b></p>";
-		content += "<p><a href=\"/logs\">Zurueck</a> | <a href=\"/\">Home</a></p></body></html>";
-		request->send(200, "text/html", content);
-		return;
 	}
-
-	String content = "<html><head><meta name=\"viewport\" content=\"width=device-width, initial-scale=1\">";
-	content += "<link rel=\"icon\" href=\"data:,\"><style>body{font-family:Arial;text-align:center;}label{margin:0 .5em;}</style>";
-	content += "</head><body><h1>Logs</h1>";
-	content += "<p>Aktueller Datei-Log-Level: <b>" + logLevelName(fileLogLevel) + "</b></p>";
-	content += "<form method='POST' action='/logs'>";
-	for (int lvl = LOG_LEVEL_ERROR; lvl <= LOG_LEVEL_DEBUG; ++lvl)
-	{
-		content += "<label><input type='radio' name='level' value='" + String(lvl) + "'";
-		content += (lvl == fileLogLevel) ? " checked" : "";
-		content += "> " + logLevelName(lvl) + "</label>";
-	}
-	content += "<br><br><input type='submit' value='Level uebernehmen'></form>";
-	content += "<p>INFO/DEBUG nur kurz fuer Diagnose nutzen (Flash-Verschleiss).</p>";
-	content += "<hr><p><a href=\"/log/current\">Aktuelles Log anzeigen</a></p>";
-	content += "<p><a href=\"/log/previous\">Log vor letztem Reboot (pre-restart) anzeigen</a></p>";
-	content += "<p><a href=\"/log/crash\">Letztes Crash-Log (Panic/Watchdog) anzeigen</a></p>";
-	content += "<p><a href=\"/\">Home</a></p></body></html>";
-	request->send(200, "text/html", content);
+	if (syslogActive() && request->hasParam("syslog_level", true))
+	{
+		int lvl = request->getParam("syslog_level", true)->value().toInt();
+		if (lvl >= 0 && lvl <= LOG_LEVEL_DEBUG)
+		{
+			syslogLevel = (int16_t)lvl;
+			log(LOG_LEVEL_WARNING, "Syslog level set to " + (lvl == 0 ? String("OFF") : logLevelName(syslogLevel)) + " via web");
+		}
+	}
+	sendState(request);
 }
 
-// Umschalter zwischen Hersteller-App-Steuerung (WBR3D an, ESP-Poll pausiert) und
-// MQTT-Steuerung (WBR3D aus, ESP pollt). GET zeigt das Formular mit dem aktuell aktiven
-// Modus vorausgewaehlt; POST uebernimmt die Auswahl via setControlMode().
+// POST /api/control: Umschalter zwischen Hersteller-App-Steuerung (WBR3D an, ESP-Poll pausiert) und
+// MQTT-Steuerung (WBR3D aus, ESP pollt) via setControlMode(). Antwort wie /api/state.
 void handleControl(AsyncWebServerRequest *request)
 {
-	if (request->method() == HTTP_POST)
-	{
-		bool appControl = request->hasParam("mode", true) && request->getParam("mode", true)->value() == "app";
-		setControlMode(appControl);
-		String content = "<html><head><meta name=\"viewport\" content=\"width=device-width, initial-scale=1\">";
-		content += "<link rel=\"icon\" href=\"data:,\">";
-		content += "<style>body { font-family: Arial; text-align: center;}</style>";
-		content += "</head><body><h1>Steuerungsmodus geaendert</h1>";
-		content += appControl
-					   ? "<p>Aktiv: <b>Hersteller-App</b> (WBR3D AN, Modbus-Poll pausiert).</p>"
-					   : "<p>Aktiv: <b>MQTT</b> (WBR3D AUS, Modbus-Poll aktiv).</p>";
-		content += "<p><a href=\"/control\">Zurueck</a> | <a href=\"/\">Home</a></p>";
-		content += "</body></html>";
-		request->send(200, "text/html", content);
-		return;
+	if (request->hasParam("mode", true))
+	{
+		setControlMode(request->getParam("mode", true)->value() == "app");
 	}
-
-	bool app = isAppControlMode();
-	String content = "<html><head><meta name=\"viewport\" content=\"width=device-width, initial-scale=1\">";
-	content += "<link rel=\"icon\" href=\"data:,\">";
-	content += "<style>body { font-family: Arial; text-align: center;} label{display:block;margin:1em;}</style>";
-	content += "</head><body><h1>Steuerungsmodus</h1>";
-	content += "<form method='POST' action='/control'>";
-	content += "<label><input type='radio' name='mode' value='mqtt'";
-	content += app ? "" : " checked";
-	content += "> Steuerung via MQTT (WBR3D aus, ESP pollt)</label>";
-	content += "<label><input type='radio' name='mode' value='app'";
-	content += app ? " checked" : "";
-	content += "> Steuerung via Hersteller-App (WBR3D an, ESP-Poll pausiert)</label>";
-	content += "<input type='submit' value='Uebernehmen'>";
-	content += "</form>";
-	content += "<p><a href=\"/\">Home</a></p>";
-	content += "</body></html>";
-	request->send(200, "text/html", content);
+	sendState(request);
 }
 
 void handleReconfigure(AsyncWebServerRequest *request)
@@ -218,19 +289,6 @@ void handleReconfigure(AsyncWebServerRequest *request)
 	scheduleAction(2);
 }
 
-void handleUploadForm(AsyncWebServerRequest *request)
-{
-	String content = "<html><head><meta name=\"viewport\" content=\"width=device-width, initial-scale=1\">";
-	content += "<link rel=\"icon\" href=\"data:,\">";
-	content += "<style>body { font-family: Arial; text-align: center;}</style>";
-	content += "</head><body><h1>Firmware Update</h1>";
-	content += "<form method='POST' action='/uploadFirmware' enctype='multipart/form-data'>";
-	content += "<input type='file' name='update'>";
-	content += "<input type='submit' value='Update Firmware'>";
-	content += "</form></body></html>";
-	request->send(200, "text/html", content);
-}
-
 // OTA-Upload-Handler: wird von ESPAsyncWebServer pro Datei-Chunk aufgerufen (index/len/final).
 // Schreibt das Firmware-Image stueckweise via Update. Laeuft im AsyncTCP-Task -> kein blockierender
 // Code, nur Update.write(). Der Reboot wird im Abschluss-Handler (siehe setupWebserver) aufgeschoben.
@@ -264,99 +322,456 @@ static void handleUpload(AsyncWebServerRequest *request, const String &filename,
 	}
 }
 
-// HTML-Ansicht des Registerdumps — non-blocking ueber den Worker. Zustandsmaschine je Aufruf:
-//   IDLE   -> Dump anstossen (requestModbusDump), Auto-Refresh-Warteseite ausliefern
-//   RUNNING-> Auto-Refresh-Warteseite (Worker scannt gerade den Bus, ~Sekunden)
-//   DONE   -> Tabelle aus den Worker-Puffern rendern, danach Reset -> naechster Aufruf scannt neu
-// Frueher blockierte der Handler bis zu 20 s auf den Bus-Scan — im AsyncTCP-Task verboten.
-// Gerendert wird in einen AsyncResponseStream (waechst im Heap, ~16 KB), den AsyncWebServer
-// segmentiert ueber die Verbindung schickt. Der CSV-Download entsteht client-seitig via dlcsv().
-void handleModbusDump(AsyncWebServerRequest *request)
+enum dump_format_t
 {
-	ModbusDumpState st = modbusDumpState();
-	if (st == MB_DUMP_DONE)
-	{
-		const uint16_t *values = modbusDumpValues();
-		const bool *valid = modbusDumpValid();
-		uint16_t start = modbusDumpStart();
-		uint16_t count = modbusDumpCount();
-
-		AsyncResponseStream *resp = request->beginResponseStream("text/html");
-		resp->print("<html><head><meta name=\"viewport\" content=\"width=device-width, initial-scale=1\">");
-		resp->print("<link rel=\"icon\" href=\"data:,\">");
-		resp->print("<script>function dlcsv(){var r=document.querySelectorAll('#dump tr'),o=[];");
-		resp->print("for(var i=0;i<r.length;i++){var c=r[i].querySelectorAll('th,td'),l=[];");
-		resp->print("for(var j=0;j<c.length;j++){l.push(c[j].textContent);}o.push(l.join(','));}");
-		resp->print("var b=new Blob([o.join('\\r\\n')],{type:'text/csv'}),a=document.createElement('a');");
-		resp->print("a.href=URL.createObjectURL(b);a.download='modbus_dump.csv';a.click();}</script>");
-		resp->print("</head><body><h1>Modbus Dump (Register 0..200)</h1>");
-		resp->print("<p><button onclick=\"dlcsv()\">Download CSV</button> | <a href=\"/\">Home</a></p>");
-		resp->print("<table border=\"1\" id=\"dump\"><tr><th>Reg</th><th>Dez</th><th>Hex</th><th>Bin</th></tr>");
-		for (uint16_t i = 0; i < count; ++i)
+	DUMP_HTML,
+	DUMP_CSV,
+	DUMP_JSON
+};
+
+// Zustand einer laufenden /modbusdump-Antwort. Lebt als shared_ptr im Callback der chunked Antwort;
+// verwirft AsyncWebServer die Antwort (fertig oder Client weg), gibt der Destruktor die Dump-Sitzung frei.
+struct dump_stream_t
+{
+	uint32_t session = 0;
+	dump_format_t format = DUMP_HTML;
+	uint8_t phase = 0; // 0 = Kopf, 1 = Zeilen, 2 = Fuss, 3 = fertig
+	bool aborted = false;
+	bool haveChunk = false;
+	bool first = true; // JSON: noch kein Wert geschrieben (Komma)
+	uint16_t row = 0;  // naechste Zeile in chunk
+	modbus_dump_chunk_t chunk;
+	String head;
+	char line[96];
+	const char *text = nullptr; // noch nicht ausgelieferter Rest (head, line oder Fuss-Literal)
+	size_t textLen = 0;
+	~dump_stream_t() { endModbusDump(session); }
+};
+
+// Eine Zeile fuer Register chunk.start + row nach d.line; liefert die Laenge.
+static size_t dumpRow(dump_stream_t &d)
+{
+	uint16_t reg = d.chunk.start + d.row;
+	uint16_t v = d.chunk.values[d.row];
+	bool ok = d.chunk.valid[d.row];
+	char bin[17];
+	for (uint8_t b = 0; b < 16; ++b)
+	{
+		bin[b] = ((v >> (15 - b)) & 1) ? '1' : '0';
+	}
+	bin[16] = 0;
+	int n = 0;
+	switch (d.format)
+	{
+	case DUMP_CSV:
+		n = ok ? snprintf(d.line, sizeof(d.line), "%u,%u,0x%04X,%s\r\n", reg, v, v, bin)
+			   : snprintf(d.line, sizeof(d.line), "%u,ERR,ERR,ERR\r\n", reg);
+		break;
+	case DUMP_JSON:
+		n = ok ? snprintf(d.line, sizeof(d.line), "%s%u", d.first ? "" : ",", v)
+			   : snprintf(d.line, sizeof(d.line), "%snull", d.first ? "" : ",");
+		d.first = false;
+		break;
+	default:
+		n = ok ? snprintf(d.line, sizeof(d.line), "<tr><td>%u</td><td>%u</td><td>0x%04X</td><td>%s</td></tr>\n", reg, v, v, bin)
+			   : snprintf(d.line, sizeof(d.line), "<tr><td>%u</td><td>ERR</td><td>ERR</td><td>ERR</td></tr>\n", reg);
+		break;
+	}
+	return n > 0 ? (size_t)n : 0;
+}
+
+static const char *dumpFoot(const dump_stream_t &d)
+{
+	switch (d.format)
+	{
+	case DUMP_CSV:
+		return d.aborted ? "# Dump abgebrochen\r\n" : "";
+	case DUMP_JSON:
+		return d.aborted ? "],\"aborted\":true}" : "]}";
+	default:
+		return d.aborted ? "</table><p><b>Dump abgebrochen</b> (App-Modus oder Client zu langsam).</p></body></html>"
+						 : "</table><p>Fertig.</p></body></html>";
+	}
+}
+
+// Callback der chunked Antwort: Kopf, dann die Zeilen jedes Chunks, sobald der Worker ihn liefert,
+// dann der Fuss. Solange der naechste Chunk noch gelesen wird, RESPONSE_TRY_AGAIN (AsyncWebServer
+// fragt beim naechsten ACK/Poll erneut). Zeilen, die nicht mehr in buffer passen, gehen im naechsten Aufruf weiter.
+static size_t fillDump(dump_stream_t &d, uint8_t *buffer, size_t maxLen)
+{
+	size_t n = 0;
+	while (n < maxLen)
+	{
+		if (d.textLen > 0)
+		{
+			size_t k = d.textLen < maxLen - n ? d.textLen : maxLen - n;
+			memcpy(buffer + n, d.text, k);
+			n += k;
+			d.text += k;
+			d.textLen -= k;
+			continue;
+		}
+		if (d.phase == 0)
 		{
-			String row = "<tr><td>" + String(start + i) + "</td>";
-			if (valid[i])
+			d.text = d.head.c_str();
+			d.textLen = d.head.length();
+			d.phase = 1;
+		}
+		else if (d.phase == 1)
+		{
+			if (!d.haveChunk)
 			{
-				row += "<td>" + String(values[i]) + "</td><td>0x" + hex4(values[i]) + "</td><td>" + bin16(values[i]) + "</td>";
+				ModbusDumpPoll poll = takeModbusDumpChunk(d.session, d.chunk);
+				if (poll == MB_DUMP_WAIT)
+				{
+					break;
+				}
+				if (poll != MB_DUMP_CHUNK)
+				{
+					d.aborted = poll == MB_DUMP_ABORTED;
+					d.phase = 2;
+					continue;
+				}
+				d.haveChunk = true;
+				d.row = 0;
 			}
-			else
+			d.text = d.line;
+			d.textLen = dumpRow(d);
+			if (++d.row >= d.chunk.count)
 			{
-				row += "<td>ERR</td><td>ERR</td><td>ERR</td>";
+				d.haveChunk = false;
 			}
-			row += "</tr>";
-			resp->print(row);
 		}
-		resp->print("</table></body></html>");
-		request->send(resp);
-		modbusDumpReset(); // naechster Aufruf startet einen frischen Scan
+		else if (d.phase == 2)
+		{
+			endModbusDump(d.session); // Bus sofort fuer den naechsten Dump frei, nicht erst beim Verwerfen der Antwort
+			d.text = dumpFoot(d);
+			d.textLen = strlen(d.text);
+			d.phase = 3;
+		}
+		else
+		{
+			break;
+		}
+	}
+	if (n == 0 && d.phase == 1)
+	{
+		return RESPONSE_TRY_AGAIN;
+	}
+	return n;
+}
+
+// GET /modbusdump: Registerdump, gestreamt. Frueher scannte der Worker hoechstens 201 Register in
+// statische Puffer, der Browser sah eine Warteseite und erst nach dem kompletten Scan die Tabelle.
+// Jetzt startet der Handler eine Dump-Sitzung (beginModbusDump) und antwortet chunked: jede Zeile
+// geht raus, sobald ihr Chunk gelesen ist. Speicher je Antwort ist konstant (ein Chunk + eine Zeile),
+// egal wie gross der Bereich ist. Laeuft schon ein Dump, gibt es 503 (ein Bus, eine Sitzung).
+// ?relearn=1 liest auch bekannte Loecher erneut (Adresskarte fuer den Bereich neu lernen).
+void handleModbusDump(AsyncWebServerRequest *request)
+{
+	long start = MODBUS_DUMP_DEFAULT_START;
+	long count = MODBUS_DUMP_DEFAULT_COUNT;
+	if (request->hasParam("start"))
+	{
+		start = constrain(request->getParam("start")->value().toInt(), 0L, 65535L);
+	}
+	if (request->hasParam("count"))
+	{
+		count = constrain(request->getParam("count")->value().toInt(), 1L, (long)MODBUS_DUMP_SPAN);
+	}
+	if (count > (long)MODBUS_DUMP_SPAN - start)
+	{
+		count = (long)MODBUS_DUMP_SPAN - start;
+	}
+	auto d = std::make_shared<dump_stream_t>();
+	String format = request->hasParam("format") ? request->getParam("format")->value() : String("html");
+	d->format = format == "csv" ? DUMP_CSV : format == "json" ? DUMP_JSON : DUMP_HTML;
+	d->session = beginModbusDump((uint16_t)start, (uint32_t)count, request->hasParam("relearn"));
+	if (d->session == 0)
+	{
+		AsyncWebServerResponse *response = request->beginResponse(503, "text/plain", "Es laeuft bereits ein Registerdump, bitte spaeter erneut versuchen.");
+		response->addHeader("Retry-After", "5");
+		request->send(response);
 		return;
 	}
+	String range = "start=" + String(start) + "&count=" + String(count);
+	const char *mime = "text/html";
+	if (d->format == DUMP_CSV)
+	{
+		mime = "text/csv";
+		d->head = "reg,dec,hex,bin\r\n";
+	}
+	else if (d->format == DUMP_JSON)
+	{
+		mime = "application/json";
+		d->head = "{\"start\":" + String(start) + ",\"count\":" + String(count) + ",\"values\":[";
+	}
+	else
+	{
+		d->head = "<html><head><meta name=\"viewport\" content=\"width=device-width, initial-scale=1\">";
+		d->head += "<link rel=\"icon\" href=\"data:,\"><style>body{font-family:Arial}td{font-family:monospace}</style>";
+		d->head += "</head><body><h1>Modbus Dump (Register " + String(start) + ".." + String(start + count - 1) + ")</h1>";
+		d->head += "<form>Start <input name=\"start\" size=\"5\" value=\"" + String(start) + "\"> Anzahl <input name=\"count\" size=\"5\" value=\"" + String(count) + "\"> <input type=\"submit\" value=\"Dump\"></form>";
+		d->head += "<p><a href=\"/modbusdump?format=csv&" + range + "\">CSV</a> | <a href=\"/modbusdump?format=json&" + range + "\">JSON</a> | <a href=\"/\">Home</a></p>";
+		d->head += "<table border=\"1\"><tr><th>Reg</th><th>Dez</th><th>Hex</th><th>Bin</th></tr>\n";
+	}
+	AsyncWebServerResponse *response = request->beginChunkedResponse(mime,
+		[d](uint8_t *buffer, size_t maxLen, size_t index) -> size_t
+		{
+			return fillDump(*d, buffer, maxLen);
+		});
+	if (d->format == DUMP_CSV)
+	{
+		response->addHeader("Content-Disposition", "attachment; filename=\"modbus_dump_" + String(start) + ".csv\"");
+	}
+	response->addHeader("Cache-Control", "no-store");
+	request->send(response);
+}
 
-	if (st == MB_DUMP_IDLE)
+// GET /api/discovery: Bericht des Discovery-Modus (modbus_discovery.h), ?limit=N Register (Default
+// und Obergrenze MODBUS_DISCOVERY_REPORT_MAX). POST /api/discovery: action=start mit start, count und
+// period (Sekunden) bzw. action=stop; Antwort wie GET. 400, wenn der Bereich nicht passt.
+void handleDiscovery(AsyncWebServerRequest *request)
+{
+	if (request->method() == HTTP_POST && request->hasParam("action", true))
 	{
-		requestModbusDump(MODBUS_DUMP_START, MODBUS_DUMP_COUNT); // non-blocking; bei Queue-voll einfach erneut laden
+		String action = request->getParam("action", true)->value();
+		if (action == "start")
+		{
+			long start = request->hasParam("start", true) ? request->getParam("start", true)->value().toInt() : 0;
+			long count = request->hasParam("count", true) ? request->getParam("count", true)->value().toInt() : 0;
+			long period = request->hasParam("period", true) ? request->getParam("period", true)->value().toInt() : MODBUS_DISCOVERY_DEFAULT_PERIOD_S;
+			if (start < 0 || start > 65535 || count < 1 || count > MODBUS_DISCOVERY_MAX_REGS || period < 1 ||
+				!discoveryStart((uint16_t)start, (uint16_t)count, (uint32_t)period))
+			{
+				request->send(400, "text/plain", "Ungueltiger Bereich (count 1.." + String(MODBUS_DISCOVERY_MAX_REGS) + ", Ende <= 65535) oder kein RAM frei.");
+				return;
+			}
+		}
+		else if (action == "stop")
+		{
+			discoveryStop();
+		}
 	}
+	long limit = MODBUS_DISCOVERY_REPORT_MAX;
+	if (request->hasParam("limit"))
+	{
+		limit = constrain(request->getParam("limit")->value().toInt(), 0L, (long)MODBUS_DISCOVERY_REPORT_MAX);
+	}
+	JsonDocument doc;
+	discoveryReportToJson(doc.to<JsonVariant>(), (uint16_t)limit);
+	String body;
+	serializeJson(doc, body);
+	AsyncWebServerResponse *response = request->beginResponse(200, "application/json", body);
+	response->addHeader("Cache-Control", "no-store");
+	request->send(response);
+}
 
-	// RUNNING (oder gerade angestossen): Auto-Refresh-Warteseite.
-	String wait = "<html><head><meta name=\"viewport\" content=\"width=device-width, initial-scale=1\">";
-	wait += "<meta http-equiv=\"refresh\" content=\"2\"><link rel=\"icon\" href=\"data:,\">";
-	wait += "<style>body{font-family:Arial;text-align:center;}</style></head><body>";
-	wait += "<h1>Modbus Dump</h1><p>Dump laeuft... die Seite laedt automatisch neu.</p>";
-	wait += "<p><a href=\"/\">Home</a></p></body></html>";
-	request->send(200, "text/html", wait);
+static void sendScopeState(AsyncWebServerRequest *request)
+{
+	static const char *const states[] = {"idle", "running", "done"};
+	modbus_scope_info_t s = scopeInfo();
+	JsonDocument doc;
+	doc["state"] = states[s.state];
+	if (s.state != SCOPE_IDLE)
+	{
+		doc["start"] = s.start;
+		doc["count"] = s.count;
+		doc["window_ms"] = s.windowMs;
+		doc["samples"] = s.samples;
+		doc["capacity"] = s.capacity;
+		doc["errors"] = s.errors;
+		doc["duration_us"] = s.durationUs;
+		if (s.samples > 1 && s.durationUs > 0)
+		{
+			doc["rate_hz"] = (float)(s.samples - 1) * 1e6f / s.durationUs;
+		}
+		if (s.end != nullptr)
+		{
+			doc["end"] = s.end;
+		}
+	}
+	String body;
+	serializeJson(doc, body);
+	AsyncWebServerResponse *response = request->beginResponse(200, "application/json", body);
+	response->addHeader("Cache-Control", "no-store");
+	request->send(response);
 }
 
-// /reboot: GET zeigt einen Bestaetigungs-Button, POST startet den ESP neu. Bewusst nur per POST
-// (kein Reboot durch versehentlichen GET/Browser-Prefetch). Der eigentliche ESP.restart() wird
-// aufgeschoben (loopWebserver), damit die Antwort noch ausgeliefert wird.
-void handleReboot(AsyncWebServerRequest *request)
+// GET /api/scope: Zustand der Scope-Aufnahme (modbus_scope.h). POST /api/scope: action=start mit start,
+// count (1..MODBUS_SCOPE_MAX_REGS) und window (ms) bzw. action=stop; Antwort wie GET. 409, wenn schon
+// eine Aufnahme laeuft, 400 bei ungueltigem Bereich.
+void handleScope(AsyncWebServerRequest *request)
+{
+	if (request->method() == HTTP_POST && request->hasParam("action", true))
+	{
+		String action = request->getParam("action", true)->value();
+		if (action == "start")
+		{
+			long start = request->hasParam("start", true) ? request->getParam("start", true)->value().toInt() : -1;
+			long count = request->hasParam("count", true) ? request->getParam("count", true)->value().toInt() : 1;
+			long window = request->hasParam("window", true) ? request->getParam("window", true)->value().toInt() : MODBUS_SCOPE_DEFAULT_WINDOW_MS;
+			if (start < 0 || start > 65535 || count < 1 || count > MODBUS_SCOPE_MAX_REGS || start + count > 65536 || window < 1)
+			{
+				request->send(400, "text/plain", "Ungueltiger Bereich (count 1.." + String(MODBUS_SCOPE_MAX_REGS) + ", Ende <= 65535).");
+				return;
+			}
+			if (!scopeStart((uint16_t)start, (uint16_t)count, (uint32_t)window))
+			{
+				request->send(409, "text/plain", "Es laeuft bereits eine Aufnahme (oder kein RAM fuer den Puffer).");
+				return;
+			}
+		}
+		else if (action == "stop")
+		{
+			scopeStop("stop");
+		}
+	}
+	sendScopeState(request);
+}
+
+struct scope_stream_t
+{
+	uint32_t gen = 0;
+	uint16_t start = 0;
+	uint16_t count = 0;
+	uint32_t samples = 0;
+	uint32_t next = 0; // naechstes Sample
+	bool csv = true;
+	uint8_t phase = 0; // 0 = Kopf, 1 = Samples, 2 = Fuss, 3 = fertig
+	bool truncated = false;
+	String head;
+	char line[16 + 7 * MODBUS_SCOPE_MAX_REGS];
+	const char *text = nullptr;
+	size_t textLen = 0;
+};
+
+// Callback der chunked Antwort: wie fillDump, nur liegen alle Samples schon vor (kein TRY_AGAIN).
+// Wird waehrend des Downloads neu gestartet, endet die Antwort mit einer Markierung.
+static size_t fillScope(scope_stream_t &d, uint8_t *buffer, size_t maxLen)
+{
+	size_t n = 0;
+	while (n < maxLen)
+	{
+		if (d.textLen > 0)
+		{
+			size_t k = d.textLen < maxLen - n ? d.textLen : maxLen - n;
+			memcpy(buffer + n, d.text, k);
+			n += k;
+			d.text += k;
+			d.textLen -= k;
+			continue;
+		}
+		if (d.phase == 0)
+		{
+			d.text = d.head.c_str();
+			d.textLen = d.head.length();
+			d.phase = 1;
+		}
+		else if (d.phase == 1)
+		{
+			uint32_t t;
+			uint16_t v[MODBUS_SCOPE_MAX_REGS];
+			if (d.next >= d.samples || !scopeSample(d.gen, d.next, t, v))
+			{
+				d.truncated = d.next < d.samples;
+				d.phase = 2;
+				continue;
+			}
+			// passt immer: ",[" + 10 Ziffern + MAX_REGS x ",65535" + Zeilenende
+			int k = d.csv ? snprintf(d.line, sizeof(d.line), "%lu", (unsigned long)t)
+						  : snprintf(d.line, sizeof(d.line), "%s[%lu", d.next == 0 ? "" : ",", (unsigned long)t);
+			for (uint16_t i = 0; i < d.count; ++i)
+			{
+				k += snprintf(d.line + k, sizeof(d.line) - k, ",%u", v[i]);
+			}
+			k += snprintf(d.line + k, sizeof(d.line) - k, "%s", d.csv ? "\r\n" : "]");
+			d.text = d.line;
+			d.textLen = k;
+			d.next++;
+		}
+		else if (d.phase == 2)
+		{
+			d.text = d.csv ? (d.truncated ? "# Aufnahme inzwischen neu gestartet\r\n" : "")
+						   : (d.truncated ? "],\"truncated\":true}" : "]}");
+			d.textLen = strlen(d.text);
+			d.phase = 3;
+		}
+		else
+		{
+			break;
+		}
+	}
+	return n;
+}
+
+// GET /scopedata?format=csv|json: die letzte abgeschlossene Aufnahme, gestreamt (Speicher je Antwort
+// konstant). CSV: t_us,<reg>,... je Zeile ein Sample; JSON: {"start","count","samples":[[t_us,v..],..]}.
+// 409, solange die Aufnahme laeuft, 404, wenn es noch keine gibt.
+void handleScopeData(AsyncWebServerRequest *request)
 {
-	if (request->method() == HTTP_POST)
-	{
-		log(LOG_LEVEL_WARNING, "Reboot via web requested");
-		String content = "<html><head><meta name=\"viewport\" content=\"width=device-width, initial-scale=1\">";
-		content += "<link rel=\"icon\" href=\"data:,\"><style>body{font-family:Arial;text-align:center;}</style>";
-		content += "</head><body><h1>Neustart...</h1>";
-		content += "<p>Der ESP startet neu. <a href=\"/\">Home</a> (nach ein paar Sekunden erneut laden).</p>";
-		content += "</body></html>";
-		request->send(200, "text/html", content);
-		scheduleAction(1);
+	modbus_scope_info_t s = scopeInfo();
+	if (s.state == SCOPE_IDLE)
+	{
+		request->send(404, "text/plain", "Noch keine Aufnahme.");
 		return;
 	}
+	if (s.state == SCOPE_RUNNING)
+	{
+		AsyncWebServerResponse *response = request->beginResponse(409, "text/plain", "Aufnahme laeuft noch.");
+		response->addHeader("Retry-After", String(s.windowMs / 1000 + 1));
+		request->send(response);
+		return;
+	}
+	auto d = std::make_shared<scope_stream_t>();
+	d->gen = s.gen;
+	d->start = s.start;
+	d->count = s.count;
+	d->samples = s.samples;
+	d->csv = !(request->hasParam("format") && request->getParam("format")->value() == "json");
+	if (d->csv)
+	{
+		d->head = "t_us";
+		for (uint16_t i = 0; i < s.count; ++i)
+		{
+			d->head += "," + String(s.start + i);
+		}
+		d->head += "\r\n";
+	}
+	else
+	{
+		d->head = "{\"start\":" + String(s.start) + ",\"count\":" + String(s.count) + ",\"end\":\"" + String(s.end) +
+				  "\",\"errors\":" + String(s.errors) + ",\"samples\":[";
+	}
+	AsyncWebServerResponse *response = request->beginChunkedResponse(d->csv ? "text/csv" : "application/json",
+		[d](uint8_t *buffer, size_t maxLen, size_t index) -> size_t
+		{
+			return fillScope(*d, buffer, maxLen);
+		});
+	if (d->csv)
+	{
+		response->addHeader("Content-Disposition", "attachment; filename=\"modbus_scope_" + String(s.start) + ".csv\"");
+	}
+	response->addHeader("Cache-Control", "no-store");
+	request->send(response);
+}
 
-	String content = "<html><head><meta name=\"viewport\" content=\"width=device-width, initial-scale=1\">";
-	content += "<link rel=\"icon\" href=\"data:,\"><style>body{font-family:Arial;text-align:center;}</style>";
-	content += "</head><body><h1>Neustart</h1>";
-	content += "<p>ESP wirklich neu starten?</p>";
-	content += "<form method='POST' action='/reboot'><input type='submit' value='Jetzt neu starten'></form>";
-	content += "<p><a href=\"/\">Abbrechen</a></p></body></html>";
-	request->send(200, "text/html", content);
+// POST /reboot startet den ESP neu (Bestaetigung in der Oberflaeche, Abschnitt #system). Bewusst nur
+// per POST (kein Reboot durch versehentlichen GET/Browser-Prefetch). Der eigentliche ESP.restart() wird
+// aufgeschoben (loopWebserver), damit die Antwort noch ausgeliefert wird.
+void handleReboot(AsyncWebServerRequest *request)
+{
+	log(LOG_LEVEL_WARNING, "Reboot via web requested");
+	request->send(200, "text/plain", "Neustart...");
+	scheduleAction(1);
 }
 
 // Fuehrt aufgeschobene Aktionen aus dem Loop-Task aus (nicht aus dem AsyncTCP-Handler): Reboot bzw.
-// Reconfigure. Bedient KEINEN Webserver mehr (der laeuft asynchron). Wird jede Loop-Iteration gerufen.
+// Reconfigure. Bedient KEINEN Webserver mehr (der laeuft asynchron); verteilt aber die Live-Events
+// (web_live.h), damit deren JSON im Loop- statt im AsyncTCP-Task entsteht. Jede Loop-Iteration gerufen.
 void loopWebserver()
 {
+	loopLiveEvents();
 	if (pendingAction != 0 && (int32_t)(millis() - pendingActionAtMs) >= 0)
 	{
 		uint8_t action = pendingAction;
@@ -364,6 +779,7 @@ void loopWebserver()
 		if (action == 1)
 		{
 			log(LOG_LEVEL_WARNING, "Aufgeschobener Reboot -> ESP.restart()");
+			flushFileLog();
 			ESP.restart();
 		}
 		else if (action == 2)
@@ -376,19 +792,34 @@ void loopWebserver()
 
 void setupWebserver()
 {
-	server.on("/", HTTP_GET, handleRoot);
+	for (const web_asset_t &asset : webAssets)
+	{
+		server.on(asset.url, HTTP_GET, [&asset](AsyncWebServerRequest *request)
+				  { sendAsset(request, asset); });
+	}
+	server.on("/api/state", HTTP_GET, sendState);
+	server.on("/api/control", HTTP_POST, handleControl);
+	server.on("/api/logs", HTTP_POST, handleLogs);
+	server.on("/reboot", HTTP_POST, handleReboot);
 	server.on("/reconfigure", HTTP_GET, handleReconfigure);
-	server.on("/update", HTTP_GET, handleUploadForm);
 	server.on("/modbusdump", HTTP_GET, handleModbusDump);
-	server.on("/control", HTTP_ANY, handleControl); // GET-Formular + POST-Submit
-	server.on("/reboot", HTTP_ANY, handleReboot);
-	server.on("/logs", HTTP_ANY, handleLogs);
+	server.on("/api/discovery", HTTP_GET | HTTP_POST, handleDiscovery);
+	server.on("/api/scope", HTTP_GET | HTTP_POST, handleScope);
+	server.on("/scopedata", HTTP_GET, handleScopeData);
+	server.on("/control", HTTP_GET, [](AsyncWebServerRequest *request)
+			  { redirectToSection(request, "control"); });
+	server.on("/logs", HTTP_GET, [](AsyncWebServerRequest *request)
+			  { redirectToSection(request, "logs"); });
+	server.on("/update", HTTP_GET, [](AsyncWebServerRequest *request)
+			  { redirectToSection(request, "system"); });
+	server.on("/reboot", HTTP_GET, [](AsyncWebServerRequest *request)
+			  { redirectToSection(request, "system"); });
 	server.on("/log/current", HTTP_GET, [](AsyncWebServerRequest *request)
-			  { sendLogFile(request, FILE_LOG_PATH_CURRENT); });
+			  { sendLogFile(request, FILE_LOG_SET_CURRENT); });
 	server.on("/log/previous", HTTP_GET, [](AsyncWebServerRequest *request)
-			  { sendLogFile(request, FILE_LOG_PATH_PREVIOUS); });
+			  { sendLogFile(request, logPreviousSet()); });
 	server.on("/log/crash", HTTP_GET, [](AsyncWebServerRequest *request)
-			  { sendLogFile(request, FILE_LOG_PATH_CRASH); });
+			  { sendLogFile(request, FILE_LOG_SET_CRASH); });
 	server.on(
 		"/uploadFirmware", HTTP_POST,
 		[](AsyncWebServerRequest *request)
@@ -399,6 +830,7 @@ void setupWebserver()
 			scheduleAction(1); // Reboot aufschieben (Antwort erst ausliefern)
 		},
 		handleUpload);
+	initLiveEvents(server);
 	server.begin();
 	log(LOG_LEVEL_INFO, "Async webserver started on port 80");
 }
@@ -9,7 +9,8 @@
 
 // loopWebserver() bedient NICHT mehr den Webserver (der laeuft jetzt asynchron im AsyncTCP-Task) —
 // es fuehrt nur noch aufgeschobene Aktionen aus (Reboot / Reconfigure), die nicht im AsyncTCP-
-// Handler laufen duerfen. Wird weiter jede Loop-Iteration aufgerufen.
+// Handler laufen duerfen, und verteilt die Live-Events (web_live.h). Wird weiter jede Loop-Iteration
+// aufgerufen.
 void loopWebserver();
 void setupWebserver();
 void restartWebserver();
@@ -5,6 +5,10 @@
 char param_mqtt_server[40];
 char param_mqtt_port[6] = "8080";
 char param_mqtt_topic[50] = "esp/modbus";
+char param_mqtt_per_register[2] = "0";
+char param_syslog_host[40] = "";
+char param_syslog_port[6] = "514";
+char param_syslog_raw[2] = "0";
 
 #define FORMAT_LITTLEFS_IF_FAILED true
 
@@ -32,6 +36,7 @@ void setupWifiManager(bool forceConfigPortal)
 	{
 		wifiManager.resetSettings();
 		log(LOG_LEVEL_INFO, "Erased WiFi settings, config fields kept. Rebooting to launch captive portal");
+		flushFileLog();
 		delay(1000);
 		ESP.restart();
 	}
@@ -68,6 +73,11 @@ void setupWifiManager(bool forceConfigPortal)
 			strcpy(param_mqtt_server, json["mqtt_server"]);
 			strcpy(param_mqtt_port, json["mqtt_port"]);
 			strcpy(param_mqtt_topic, json["mqtt_topic"]);
+			// Erst spaeter eingefuehrt: aeltere config.json kennen den Schluessel nicht -> Default.
+			strlcpy(param_mqtt_per_register, json["mqtt_per_register"] | "0", sizeof(param_mqtt_per_register));
+			strlcpy(param_syslog_host, json["syslog_host"] | "", sizeof(param_syslog_host));
+			strlcpy(param_syslog_port, json["syslog_port"] | "514", sizeof(param_syslog_port));
+			strlcpy(param_syslog_raw, json["syslog_raw"] | "0", sizeof(param_syslog_raw));
 		}
 		else
 		{
@@ -85,6 +95,10 @@ void setupWifiManager(bool forceConfigPortal)
 	WiFiManagerParameter custom_mqtt_server("server", "mqtt server", param_mqtt_server, 40);
 	WiFiManagerParameter custom_mqtt_port("port", "mqtt port", param_mqtt_port, 6);
 	WiFiManagerParameter custom_mqtt_topic("topic", "mqtt topic", param_mqtt_topic, 50);
+	WiFiManagerParameter custom_mqtt_per_register("per_register", "mqtt per-register topics (0/1)", param_mqtt_per_register, 2);
+	WiFiManagerParameter custom_syslog_host("syslog_host", "syslog host (leer = aus)", param_syslog_host, 40);
+	WiFiManagerParameter custom_syslog_port("syslog_port", "syslog port", param_syslog_port, 6);
+	WiFiManagerParameter custom_syslog_raw("syslog_raw", "syslog kompakt/binaer (0/1)", param_syslog_raw, 2);
 
 	// WiFiManager
 	// Local intialization. Once its business is done, there is no need to keep it around
@@ -99,6 +113,10 @@ void setupWifiManager(bool forceConfigPortal)
 	wifiManager.addParameter(&custom_mqtt_server);
 	wifiManager.addParameter(&custom_mqtt_port);
 	wifiManager.addParameter(&custom_mqtt_topic);
+	wifiManager.addParameter(&custom_mqtt_per_register);
+	wifiManager.addParameter(&custom_syslog_host);
+	wifiManager.addParameter(&custom_syslog_port);
+	wifiManager.addParameter(&custom_syslog_raw);
 
 	// reset settings - for testing
 	// wifiManager.resetSettings();
@@ -127,6 +145,7 @@ void setupWifiManager(bool forceConfigPortal)
 	if (!wifiManager.autoConnect("AutoConnectAP", "password"))
 	{
 		log(LOG_LEVEL_ERROR, "failed to connect and hit timeout");
+		flushFileLog();
 		delay(3000);
 		// reset and try again, or maybe put it to deep sleep
 		ESP.restart();
@@ -139,11 +158,17 @@ void setupWifiManager(bool forceConfigPortal)
 	strncpy(param_mqtt_server, custom_mqtt_server.getValue(), 40);
 	strncpy(param_mqtt_port, custom_mqtt_port.getValue(), 6);
 	strncpy(param_mqtt_topic, custom_mqtt_topic.getValue(), 50);
+	strlcpy(param_mqtt_per_register, custom_mqtt_per_register.getValue(), sizeof(param_mqtt_per_register));
+	strlcpy(param_syslog_host, custom_syslog_host.getValue(), sizeof(param_syslog_host));
+	strlcpy(param_syslog_port, custom_syslog_port.getValue(), sizeof(param_syslog_port));
+	strlcpy(param_syslog_raw, custom_syslog_raw.getValue(), sizeof(param_syslog_raw));
 
 	log(LOG_LEVEL_INFO, "The values in the file are: ");
 	log(LOG_LEVEL_INFO, "\tmqtt_server : " + String(param_mqtt_server));
 	log(LOG_LEVEL_INFO, "\tmqtt_port : " + String(param_mqtt_port));
 	log(LOG_LEVEL_INFO, "\tmqtt_topic : " + String(param_mqtt_topic));
+	log(LOG_LEVEL_INFO, "\tmqtt_per_register : " + String(param_mqtt_per_register));
+	log(LOG_LEVEL_INFO, "\tsyslog : " + String(param_syslog_host) + ":" + String(param_syslog_port) + " raw=" + String(param_syslog_raw));
 
 	// save the custom parameters to FS
 	if (shouldSaveConfig)
@@ -153,6 +178,10 @@ void setupWifiManager(bool forceConfigPortal)
 		json["mqtt_server"] = param_mqtt_server;
 		json["mqtt_port"] = param_mqtt_port;
 		json["mqtt_topic"] = param_mqtt_topic;
+		json["mqtt_per_register"] = param_mqtt_per_register;
+		json["syslog_host"] = param_syslog_host;
+		json["syslog_port"] = param_syslog_port;
+		json["syslog_raw"] = param_syslog_raw;
 		json.shrinkToFit();
 		if (LittleFS.begin())
 		{
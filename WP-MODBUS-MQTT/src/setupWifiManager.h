@@ -9,6 +9,13 @@
 extern char param_mqtt_server[40];
 extern char param_mqtt_port[6];
 extern char param_mqtt_topic[50];
+// "1" = geaenderte Werte einzeln auf <topic>/<host>/reg/<name> (Delta-Publish, ungueltig -> null); /data
+// dann nur noch bei Fehler-Aenderungen und als periodisches Vollbild. "0" = alles ueber /data.
+extern char param_mqtt_per_register[2];
+// UDP-Syslog-Ziel (log_syslog.h): Host leer = aus; "1" = kompaktes Binaerformat statt RFC 5424.
+extern char param_syslog_host[40];
+extern char param_syslog_port[6];
+extern char param_syslog_raw[2];
 
 void setupWifiManager(bool forceConfigPortal);
 
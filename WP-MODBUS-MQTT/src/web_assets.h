@@ -0,0 +1,287 @@
+// Generiert von tools/build_web.py aus web/ -- nicht von Hand aendern.
+#ifndef SRC_WEB_ASSETS_H_
+#define SRC_WEB_ASSETS_H_
+
+#include "Arduino.h"
+
+typedef struct
+{
+	const char *url;
+	const char *mime;
+	const uint8_t *gz; // gzip-komprimiert (Content-Encoding: gzip)
+	size_t len;
+	const char *etag; // stark, mit Anfuehrungszeichen
+} web_asset_t;
+
+static const uint8_t WEB_INDEX_HTML_GZ[] PROGMEM = {
+	0x1f, 0x8b, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0xff, 0xcd, 0x5a, 0x6d, 0x6f, 0xdb, 0x38,
+	0x12, 0xfe, 0xee, 0x5f, 0xc1, 0x55, 0x17, 0x90, 0x04, 0xdb, 0xb2, 0xd3, 0xdb, 0xdd, 0x3b, 0xd8,
+	0x96, 0x83, 0xb4, 0x49, 0xb6, 0x3d, 0xa4, 0x69, 0x2e, 0x4e, 0xb7, 0xb8, 0x2b, 0x8a, 0x80, 0x96,
+	0x68, 0x8b, 0x17, 0xea, 0x65, 0x29, 0xca, 0x6e, 0xe2, 0xe4, 0xbf, 0xdf, 0x0c, 0x29, 0xc9, 0x92,
+	0xe3, 0x64, 0xd3, 0xc5, 0xe1, 0x70, 0x1f, 0x6a, 0x49, 0x14, 0x39, 0x33, 0x9c, 0x79, 0xf8, 0xcc,
+	0x8c, 0xd2, 0xc9, 0x0f, 0xc7, 0x1f, 0xdf, 0x5e, 0xfd, 0xf3, 0xe2, 0x84, 0x44, 0x2a, 0x16, 0xd3,
+	0xce, 0x44, 0x5f, 0x26, 0x11, 0xa3, 0xe1, 0x74, 0x12, 0x33, 0x45, 0x49, 0x10, 0x51, 0x99, 0x33,
+	0xe5, 0x5b, 0x85, 0x5a, 0xf4, 0xff, 0x66, 0x95, 0xa3, 0x09, 0x8d, 0x99, 0x6f, 0xad, 0x38, 0x5b,
+	0x67, 0xa9, 0x54, 0x16, 0x09, 0xd2, 0x44, 0xb1, 0x04, 0x66, 0xad, 0x79, 0xa8, 0x22, 0x3f, 0x64,
+	0x2b, 0x1e, 0xb0, 0xbe, 0x7e, 0xe8, 0x11, 0x9e, 0x70, 0xc5, 0xa9, 0xe8, 0xe7, 0x01, 0x15, 0xcc,
+	0x3f, 0xb0, 0x40, 0x8d, 0xe0, 0xc9, 0x0d, 0x91, 0x4c, 0xf8, 0x16, 0x87, 0xa5, 0x16, 0x89, 0x24,
+	0x5b, 0xf8, 0x56, 0x48, 0x15, 0x1d, 0xf5, 0x40, 0x87, 0xe2, 0x4a, 0xb0, 0xe9, 0x87, 0x34, 0x9c,
+	0x17, 0x39, 0x79, 0x23, 0x79, 0xb8, 0x64, 0x93, 0x81, 0x19, 0xec, 0x4c, 0x72, 0x75, 0x8b, 0xd7,
+	0x79, 0x1a, 0xde, 0x6e, 0x16, 0xa0, 0xb7, 0xbf, 0xa0, 0x31, 0x17, 0xb7, 0xa3, 0x23, 0x09, 0x4a,
+	0xc6, 0x8a, 0x7d, 0x53, 0x7d, 0x2a, 0xf8, 0x32, 0x19, 0x05, 0x60, 0x11, 0x93, 0xe3, 0x98, 0xca,
+	0x25, 0x4f, 0x46, 0x07, 0x2c, 0x7e, 0xe8, 0x24, 0x74, 0x45, 0xe8, 0xa6, 0x1c, 0x19, 0x12, 0xef,
+	0x67, 0x1c, 0xcc, 0x59, 0xa0, 0x78, 0x9a, 0x6c, 0x42, 0x9e, 0x67, 0x82, 0xde, 0x8e, 0x92, 0x34,
+	0x61, 0xf5, 0xa8, 0xd7, 0x78, 0x31, 0x17, 0x69, 0x70, 0xf3, 0xd0, 0x11, 0x74, 0xce, 0xc4, 0xae,
+	0x10, 0x3d, 0xe8, 0xcd, 0xdb, 0x73, 0x5b, 0xba, 0x5f, 0xc5, 0xf9, 0x72, 0x13, 0xa4, 0x22, 0x95,
+	0xa3, 0x57, 0xc3, 0xbf, 0x0e, 0xc7, 0x31, 0x4f, 0xfa, 0x11, 0xe3, 0xcb, 0x48, 0x8d, 0x0e, 0xbc,
+	0xd7, 0xd5, 0x0c, 0x8f, 0x49, 0x59, 0xcd, 0x9a, 0x0f, 0x87, 0x0f, 0x9d, 0xc9, 0xa0, 0xdc, 0xf0,
+	0x64, 0x60, 0xc2, 0x82, 0x1b, 0x87, 0x27, 0xd8, 0xca, 0x74, 0x42, 0x4b, 0xcf, 0xbd, 0x8a, 0xd2,
+	0x98, 0x59, 0xd3, 0x77, 0xf0, 0x3b, 0x19, 0xd0, 0xc6, 0x38, 0x06, 0x46, 0xa6, 0xc2, 0x9a, 0xce,
+	0x14, 0x2b, 0x98, 0x2c, 0x92, 0x65, 0xfb, 0xbd, 0x48, 0x97, 0xb9, 0x35, 0x3d, 0x83, 0xdf, 0xf6,
+	0x38, 0x6c, 0x23, 0x48, 0x57, 0x4c, 0xde, 0x5a, 0xd3, 0xe3, 0xea, 0xb6, 0x3d, 0x03, 0x06, 0x33,
+	0x50, 0x39, 0xc3, 0x4b, 0xeb, 0xcd, 0x40, 0xf0, 0x15, 0xbc, 0x38, 0x83, 0xdf, 0x9d, 0x15, 0xb7,
+	0xb9, 0x62, 0x31, 0x2c, 0xd1, 0x57, 0xfd, 0x6e, 0x80, 0xbb, 0xe8, 0x4c, 0x32, 0xc2, 0x43, 0xdf,
+	0x82, 0xdd, 0x43, 0xec, 0x07, 0x19, 0xc6, 0xd8, 0x38, 0x5f, 0x0f, 0x9b, 0xad, 0x01, 0x34, 0x0f,
+	0x76, 0x11, 0x01, 0x23, 0xb0, 0x76, 0xaf, 0xe6, 0xfe, 0x51, 0x92, 0xf3, 0x20, 0x52, 0xa8, 0x85,
+	0x84, 0x4c, 0x92, 0x4b, 0xb6, 0xe4, 0xa0, 0x56, 0x12, 0x67, 0xc6, 0x24, 0xec, 0xa6, 0x3f, 0x03,
+	0x74, 0x90, 0x93, 0x15, 0xfc, 0xe6, 0xae, 0x67, 0xb4, 0x36, 0x45, 0xc5, 0x5a, 0x55, 0x58, 0xc4,
+	0x99, 0x35, 0xad, 0xd6, 0xe2, 0x93, 0x16, 0xe8, 0x0c, 0x3d, 0xef, 0xf5, 0x70, 0xd8, 0x23, 0x6f,
+	0x98, 0x64, 0xa0, 0x86, 0xac, 0x29, 0x8b, 0xc4, 0x9c, 0xca, 0x1e, 0xa1, 0x05, 0x3c, 0x52, 0x91,
+	0x93, 0xb7, 0xb3, 0xdf, 0x06, 0x7f, 0x9f, 0x7d, 0x3c, 0xdf, 0x23, 0xfc, 0x49, 0xef, 0x8e, 0xc8,
+	0x9a, 0x89, 0x20, 0x62, 0x5b, 0x6b, 0xe7, 0x6c, 0xcd, 0x96, 0x2c, 0x21, 0xb8, 0x99, 0xc3, 0xc7,
+	0x82, 0x76, 0x83, 0x80, 0x02, 0x12, 0xbe, 0x6c, 0x08, 0xc8, 0x53, 0x92, 0x07, 0x51, 0xc2, 0x84,
+	0x20, 0x6b, 0xce, 0x48, 0x9c, 0xb2, 0xa5, 0x40, 0x8b, 0x69, 0xb1, 0xb8, 0x43, 0xd3, 0x13, 0x96,
+	0xec, 0x31, 0xf0, 0x31, 0x6c, 0x72, 0x70, 0x48, 0xa1, 0x41, 0x42, 0x8a, 0x18, 0x24, 0x52, 0x01,
+	0x07, 0x9e, 0x38, 0xef, 0x98, 0x04, 0x35, 0x42, 0x80, 0x43, 0x8f, 0xb2, 0x8c, 0x0c, 0xc8, 0x87,
+	0x7f, 0x5c, 0x5d, 0xed, 0xdb, 0x72, 0x1b, 0x68, 0x84, 0x26, 0xa0, 0x1d, 0x36, 0xd6, 0x23, 0x30,
+	0xd4, 0x3f, 0x63, 0x2b, 0x26, 0x08, 0xd0, 0xcc, 0xdd, 0x5e, 0x6b, 0x2a, 0xe0, 0x9c, 0x72, 0x19,
+	0xaf, 0xa9, 0x64, 0xfd, 0x4f, 0x19, 0x50, 0x05, 0xeb, 0xc1, 0x2e, 0xc1, 0xd0, 0x05, 0x5f, 0x16,
+	0x12, 0x1e, 0xce, 0x59, 0x91, 0x2b, 0x2a, 0x95, 0x01, 0x16, 0xca, 0x88, 0xe4, 0x14, 0xe5, 0xe4,
+	0x31, 0x15, 0xa2, 0x5e, 0x4c, 0xc0, 0xd9, 0x39, 0x60, 0x6b, 0x44, 0x26, 0x79, 0x46, 0x0d, 0xc4,
+	0x16, 0x6b, 0x6b, 0xda, 0x87, 0x83, 0x06, 0xcf, 0xb0, 0xd4, 0xcc, 0x37, 0x22, 0x06, 0x25, 0x12,
+	0x77, 0x30, 0x59, 0xfb, 0x47, 0xc3, 0xf2, 0x91, 0x93, 0x34, 0x30, 0x17, 0xa9, 0x8c, 0x9b, 0x93,
+	0x4f, 0xe1, 0x59, 0x73, 0x1f, 0x32, 0x05, 0x09, 0x04, 0xcd, 0x73, 0xdf, 0x9a, 0x03, 0xe2, 0x79,
+	0x92, 0x15, 0x8a, 0xa8, 0xdb, 0x0c, 0x28, 0x55, 0xd2, 0x90, 0xa7, 0x56, 0xc9, 0xaf, 0x20, 0x8d,
+	0x59, 0x64, 0x45, 0x45, 0x81, 0x0f, 0xbf, 0x2b, 0x65, 0x4d, 0x49, 0xad, 0x8b, 0xac, 0x38, 0xd5,
+	0xde, 0x26, 0xce, 0xe7, 0x37, 0x97, 0x7f, 0x39, 0x86, 0x88, 0xe6, 0x3d, 0x72, 0x32, 0xbb, 0x20,
+	0x59, 0x2a, 0x84, 0x72, 0x27, 0x03, 0xad, 0xe8, 0xcf, 0x2b, 0xa4, 0x59, 0xf6, 0x48, 0xdf, 0x4e,
+	0xb8, 0x2b, 0xcd, 0x89, 0x56, 0xdc, 0xbf, 0x00, 0xc5, 0x24, 0x03, 0x3b, 0x38, 0x93, 0x4d, 0x03,
+	0x9a, 0xfa, 0xf2, 0x62, 0x1e, 0x73, 0x55, 0x2b, 0xf9, 0xc4, 0xe6, 0x4c, 0x26, 0x2c, 0x8a, 0x59,
+	0x82, 0xbe, 0x19, 0xa0, 0xd3, 0x9e, 0x76, 0xbb, 0x01, 0x91, 0xf6, 0xb9, 0x41, 0x52, 0xdb, 0xd1,
+	0xf8, 0xba, 0xf2, 0x72, 0x36, 0x3d, 0x06, 0x88, 0xf0, 0x7e, 0x0d, 0xaf, 0x11, 0x06, 0xb4, 0x64,
+	0x9a, 0x05, 0x17, 0x4c, 0x0f, 0xe6, 0x15, 0xe1, 0x84, 0x7c, 0xa5, 0xdf, 0x00, 0xd4, 0x40, 0x8a,
+	0x85, 0xb8, 0x99, 0xe9, 0xdb, 0xc7, 0x8b, 0xcd, 0x94, 0xe6, 0xf2, 0xc9, 0x00, 0x96, 0x3f, 0xbf,
+	0x4f, 0x83, 0xf0, 0x62, 0xff, 0x6e, 0xb3, 0xe9, 0xfb, 0xf3, 0xd3, 0x8f, 0x83, 0xe3, 0x93, 0x37,
+	0x9f, 0x7e, 0x25, 0x49, 0x21, 0xc9, 0x4d, 0x21, 0xef, 0xc8, 0x02, 0xfc, 0x4e, 0x8e, 0x39, 0x5d,
+	0x26, 0x69, 0xce, 0x60, 0x18, 0x0f, 0x07, 0x71, 0x4e, 0x21, 0x8c, 0x51, 0xff, 0x37, 0x88, 0x43,
+	0x10, 0x09, 0xc6, 0xf3, 0x9a, 0xbc, 0x4a, 0xb0, 0x6f, 0xb9, 0x30, 0x5d, 0x0e, 0x82, 0x42, 0x4a,
+	0x20, 0x38, 0x6b, 0x7a, 0x74, 0xa3, 0x0a, 0x0c, 0x5b, 0x8e, 0xc7, 0xad, 0x3e, 0x7c, 0xdb, 0x93,
+	0xb2, 0xbb, 0x30, 0x93, 0x90, 0xc1, 0xd3, 0xc2, 0x9c, 0x58, 0xb2, 0x4a, 0x25, 0x11, 0x70, 0x38,
+	0xe1, 0x10, 0xc2, 0x91, 0x9b, 0xa7, 0xa9, 0x22, 0x0e, 0xcc, 0xe8, 0x4b, 0xa6, 0x0f, 0x9c, 0xfb,
+	0x02, 0x81, 0x81, 0x04, 0xb3, 0x41, 0x9a, 0x96, 0x02, 0xe4, 0x88, 0x8f, 0x18, 0x1b, 0xe2, 0x5c,
+	0xd0, 0x84, 0x07, 0x83, 0xcf, 0x54, 0x05, 0x51, 0x98, 0x2e, 0x5f, 0x24, 0xcb, 0xec, 0xea, 0x50,
+	0x51, 0x2e, 0xfc, 0x83, 0xe1, 0xb0, 0x12, 0x4b, 0xe0, 0x9e, 0xfc, 0x8b, 0x41, 0x6c, 0xf5, 0x62,
+	0x72, 0x4f, 0xf6, 0xaf, 0x13, 0x18, 0x0b, 0xff, 0xb5, 0x35, 0x3d, 0x07, 0x57, 0x7f, 0xa6, 0x32,
+	0x01, 0x74, 0xb3, 0x64, 0x70, 0x0a, 0x14, 0xce, 0xe4, 0x56, 0xed, 0x13, 0x18, 0x6c, 0x70, 0xb7,
+	0x06, 0x62, 0x83, 0xc0, 0xdb, 0x68, 0xc4, 0x89, 0x06, 0x8d, 0x2d, 0x60, 0x44, 0x3c, 0x0c, 0x21,
+	0xfc, 0xe5, 0x89, 0xa3, 0x5a, 0x70, 0x0d, 0x13, 0xed, 0xcf, 0x9a, 0x24, 0x80, 0x58, 0xe0, 0x91,
+	0x94, 0xcb, 0xcd, 0x02, 0x33, 0x03, 0xf2, 0xc1, 0x1d, 0x3c, 0xfc, 0x5c, 0x2f, 0x1c, 0x22, 0x12,
+	0xcd, 0xa2, 0x72, 0xed, 0x51, 0x72, 0x47, 0x23, 0xd1, 0x5e, 0x1c, 0xa4, 0x45, 0x52, 0x2f, 0xfe,
+	0xa9, 0x5e, 0xfc, 0x7a, 0x78, 0xb0, 0x5d, 0x5e, 0xe9, 0xbe, 0x60, 0x92, 0x03, 0x1d, 0x10, 0x27,
+	0x77, 0xdb, 0x42, 0x32, 0xfd, 0xe2, 0xb1, 0x94, 0x5f, 0x1a, 0x36, 0x90, 0xe7, 0xce, 0x82, 0xde,
+	0xd5, 0xee, 0x09, 0x98, 0xcc, 0x0b, 0xa5, 0x1a, 0x2e, 0x9e, 0xa9, 0x14, 0xe8, 0xe7, 0x28, 0x31,
+	0x89, 0x66, 0x32, 0x30, 0xaf, 0x41, 0xf0, 0xce, 0xbc, 0xb3, 0x94, 0x86, 0x06, 0xdf, 0x50, 0xf4,
+	0x21, 0xf1, 0xb4, 0x26, 0xd7, 0xf1, 0xa7, 0x19, 0x1f, 0x34, 0x22, 0x87, 0x89, 0xb9, 0x01, 0xb0,
+	0x5a, 0xda, 0xfb, 0x64, 0x91, 0x56, 0x94, 0xa0, 0xe8, 0x5c, 0x30, 0x32, 0x4f, 0x25, 0x94, 0x0f,
+	0xbe, 0x75, 0x00, 0x1b, 0xc6, 0x3a, 0x0c, 0x48, 0xd2, 0xd4, 0x74, 0xb4, 0x50, 0x38, 0x55, 0x99,
+	0xa2, 0x4c, 0x49, 0xbc, 0xc5, 0x4a, 0x01, 0x0a, 0xd5, 0x48, 0xdf, 0x1f, 0xb1, 0x24, 0xd4, 0xcc,
+	0x89, 0x16, 0x95, 0x63, 0x1f, 0x78, 0xe3, 0x9e, 0x7e, 0xab, 0xef, 0x0d, 0x80, 0x65, 0xfd, 0x7c,
+	0x82, 0x34, 0x4b, 0x6a, 0x09, 0x18, 0x04, 0xf3, 0x6e, 0x80, 0x8a, 0x06, 0x95, 0x52, 0x2c, 0x05,
+	0x6b, 0xdb, 0x2f, 0xd3, 0xb5, 0xe6, 0x23, 0x3d, 0x8a, 0x57, 0xb4, 0xff, 0x69, 0x1c, 0x97, 0xa5,
+	0x83, 0x49, 0x60, 0xa6, 0x7e, 0x68, 0xe3, 0x57, 0x4f, 0xf8, 0x7f, 0x06, 0xf0, 0xeb, 0x7a, 0xf1,
+	0x1e, 0xf8, 0x9e, 0xb2, 0xc4, 0x94, 0x7b, 0xf1, 0x2e, 0x7e, 0xd7, 0x3c, 0x09, 0xd3, 0x75, 0x25,
+	0xe4, 0x97, 0xad, 0x90, 0xe1, 0x70, 0xf8, 0x52, 0x08, 0x1f, 0x15, 0x8b, 0x7d, 0x34, 0xde, 0x04,
+	0xa7, 0x76, 0xdf, 0x4b, 0x50, 0xac, 0x27, 0x3e, 0x07, 0xe3, 0x26, 0x48, 0xf5, 0xe4, 0x26, 0x4a,
+	0x9b, 0xe4, 0xa8, 0x5f, 0x62, 0x13, 0x65, 0x4d, 0xa1, 0xfa, 0x7c, 0xc4, 0x81, 0xf5, 0xeb, 0x43,
+	0x34, 0x98, 0x2a, 0xff, 0xdf, 0x39, 0x44, 0x6e, 0xf7, 0x2c, 0x4c, 0x3f, 0x43, 0x2d, 0x0b, 0xea,
+	0x43, 0x5d, 0x36, 0xe3, 0x46, 0x29, 0x6c, 0xb4, 0x4e, 0xeb, 0x7a, 0x34, 0xc1, 0xf5, 0x70, 0x38,
+	0x30, 0xe1, 0x7b, 0xcf, 0xb2, 0x65, 0x55, 0xba, 0x69, 0x98, 0xd5, 0x25, 0x98, 0xa9, 0xdf, 0x9a,
+	0x80, 0x83, 0xae, 0x32, 0x4a, 0x61, 0xfe, 0xc5, 0xc7, 0xd9, 0x95, 0x45, 0x0c, 0xa8, 0xc0, 0xe4,
+	0x22, 0x13, 0xe0, 0x98, 0x6a, 0x9d, 0x45, 0x58, 0x12, 0x98, 0x78, 0xc4, 0x85, 0x50, 0x3c, 0x03,
+	0x24, 0x69, 0xe7, 0xf7, 0xcd, 0xa6, 0xdb, 0x19, 0x18, 0x93, 0x7c, 0x85, 0xd2, 0x42, 0x2b, 0xb4,
+	0x9e, 0x0f, 0xaa, 0xb1, 0x8a, 0xd4, 0xda, 0x1a, 0xa1, 0x05, 0x43, 0x1b, 0xb5, 0xe6, 0x9e, 0xce,
+	0x43, 0x6e, 0xdf, 0x5a, 0x7a, 0xe3, 0x66, 0x00, 0x02, 0x41, 0x33, 0x05, 0xfd, 0x08, 0xb8, 0x4a,
+	0x2a, 0x0a, 0x35, 0xae, 0xe1, 0x3e, 0xd3, 0x45, 0x7c, 0x3e, 0x3b, 0x3a, 0xef, 0x0f, 0xb0, 0x86,
+	0xeb, 0x9f, 0xf0, 0x44, 0x17, 0x56, 0x9a, 0x2e, 0x48, 0xc2, 0x8a, 0xb2, 0x1a, 0x76, 0xcb, 0xe4,
+	0x7e, 0x30, 0xdd, 0x96, 0xb7, 0x95, 0xf2, 0x06, 0x86, 0xa4, 0xce, 0xca, 0x10, 0x4b, 0xe4, 0x11,
+	0xb3, 0xbc, 0x52, 0xd4, 0x02, 0x51, 0x33, 0x4a, 0x81, 0xe4, 0x99, 0x9a, 0x76, 0x56, 0x54, 0x92,
+	0xb3, 0x93, 0xdf, 0x4e, 0xce, 0x66, 0xfe, 0x17, 0xfb, 0xe8, 0xd3, 0xcc, 0xee, 0xd9, 0x27, 0x97,
+	0x97, 0x1f, 0x2f, 0xe1, 0xfa, 0xf9, 0xe8, 0xf2, 0xfc, 0xfd, 0xf9, 0xaf, 0x70, 0x87, 0xf5, 0x09,
+	0x5c, 0x74, 0x85, 0x62, 0x7f, 0xed, 0x81, 0x70, 0xc5, 0xfc, 0xcd, 0xc3, 0xb8, 0xb3, 0x28, 0x12,
+	0x13, 0xec, 0x1f, 0x1d, 0x1e, 0xba, 0x1b, 0xc9, 0x54, 0x21, 0x13, 0x12, 0xa6, 0x41, 0x01, 0x87,
+	0x43, 0x79, 0x4b, 0xa6, 0x4e, 0x04, 0xc3, 0xdb, 0x37, 0xb7, 0xef, 0x43, 0x9c, 0x32, 0x7e, 0xd8,
+	0xae, 0x81, 0x86, 0xcf, 0x51, 0x3d, 0x68, 0x78, 0xdd, 0xcd, 0x8f, 0x8e, 0x0d, 0x4f, 0xb6, 0xeb,
+	0x61, 0xff, 0xfe, 0xb6, 0xfc, 0x9a, 0xa0, 0xc6, 0xf5, 0xb0, 0xae, 0x5e, 0xcf, 0x31, 0x96, 0x30,
+	0xfd, 0xd0, 0x86, 0x1f, 0x7b, 0x64, 0xdb, 0x4d, 0x61, 0xba, 0x90, 0xcd, 0x1d, 0x26, 0x7a, 0x18,
+	0xf2, 0xde, 0x42, 0xa6, 0x71, 0x0f, 0x32, 0xbe, 0xbb, 0xd1, 0x3b, 0x8c, 0x7c, 0x98, 0x0d, 0xc1,
+	0x74, 0xf0, 0x41, 0xf8, 0xf8, 0x76, 0x2c, 0x26, 0xfe, 0x4f, 0x63, 0xd1, 0xed, 0xba, 0x9b, 0xa8,
+	0xeb, 0xdb, 0x25, 0x6f, 0x3c, 0x5d, 0x1c, 0xdb, 0x5d, 0xbc, 0x76, 0xed, 0x1a, 0x2f, 0x76, 0x57,
+	0xc0, 0x93, 0xdd, 0x75, 0x84, 0xef, 0x83, 0xa6, 0x43, 0x9b, 0x40, 0xeb, 0x16, 0xdc, 0xb0, 0x10,
+	0x4d, 0x73, 0xbb, 0xf6, 0x94, 0xd8, 0x5d, 0xe3, 0xd9, 0x2f, 0xe2, 0x6b, 0xd7, 0xae, 0x88, 0x05,
+	0xad, 0x66, 0xc2, 0xe3, 0x49, 0xc2, 0xe4, 0xbb, 0xab, 0x0f, 0x67, 0x7e, 0xd4, 0xdc, 0x46, 0x1e,
+	0xa5, 0x6b, 0x60, 0xfb, 0x4d, 0xc7, 0xf8, 0x38, 0x47, 0x17, 0x2c, 0xd6, 0x3b, 0x8e, 0xc9, 0xbd,
+	0x45, 0x09, 0xd2, 0x71, 0xa7, 0xf6, 0xf5, 0xef, 0x50, 0x2f, 0xde, 0xce, 0x98, 0x80, 0x08, 0xa7,
+	0xf2, 0x48, 0x08, 0xc7, 0x7e, 0xd5, 0xe8, 0x3c, 0x88, 0xde, 0xd7, 0x17, 0xbd, 0x15, 0x2c, 0xf3,
+	0xbf, 0x82, 0x48, 0xf0, 0xc7, 0x09, 0x0d, 0x22, 0xa7, 0x52, 0xee, 0x70, 0x77, 0xc3, 0xbd, 0x72,
+	0x13, 0xbe, 0xc3, 0x3d, 0xb3, 0x51, 0xdf, 0x86, 0x56, 0xc0, 0x76, 0x7d, 0x50, 0x0b, 0x37, 0xd7,
+	0xa5, 0xd0, 0xf1, 0x83, 0x3b, 0xee, 0x94, 0x4e, 0x47, 0x1b, 0xeb, 0x92, 0xda, 0x76, 0x7b, 0xb6,
+	0x2e, 0xb1, 0xec, 0xde, 0x41, 0x0f, 0x2d, 0x15, 0xec, 0x1a, 0xca, 0xaf, 0x6b, 0x3d, 0x06, 0x6b,
+	0x60, 0xb2, 0x29, 0xa1, 0xc1, 0x02, 0x9d, 0x52, 0xbd, 0xf2, 0x9b, 0x09, 0xc8, 0x37, 0x2f, 0xae,
+	0xf1, 0xfc, 0xaf, 0xd8, 0xa1, 0x0d, 0x8e, 0xc4, 0x8f, 0x31, 0xf6, 0xb8, 0xc3, 0x17, 0xce, 0xce,
+	0x5b, 0x77, 0xab, 0xbb, 0x59, 0x91, 0xa3, 0xf6, 0x72, 0x5e, 0x69, 0xc4, 0xb0, 0x57, 0xaf, 0x2c,
+	0x4d, 0x68, 0xb8, 0x1b, 0xe9, 0xc5, 0x71, 0x37, 0x0b, 0x06, 0xe5, 0xa7, 0x63, 0xeb, 0x32, 0x41,
+	0x3b, 0x1e, 0x1d, 0x1e, 0xb1, 0x64, 0xeb, 0x1a, 0x59, 0x83, 0x5b, 0x7a, 0xc8, 0x9b, 0x0e, 0x88,
+	0x29, 0xe7, 0x60, 0xc8, 0x00, 0xa1, 0x58, 0xc1, 0x6e, 0xe7, 0xbb, 0x1b, 0x44, 0xb7, 0x0d, 0x09,
+	0x50, 0x15, 0x39, 0x49, 0xf0, 0x5b, 0x04, 0xd4, 0xd0, 0xf9, 0x9c, 0x4a, 0x70, 0x0b, 0xae, 0x6d,
+	0x5a, 0x91, 0xa5, 0xb9, 0x72, 0x0a, 0x29, 0x7a, 0x48, 0x37, 0xbd, 0x10, 0xb6, 0x0c, 0x00, 0x30,
+	0x36, 0xe1, 0xe8, 0xc6, 0xb0, 0xe3, 0xc8, 0x46, 0x76, 0xb4, 0x7b, 0x98, 0xdf, 0x47, 0x09, 0x5b,
+	0x93, 0x4f, 0x97, 0x67, 0x33, 0x46, 0x65, 0x10, 0x5d, 0x50, 0x49, 0xe3, 0xdc, 0xc1, 0x31, 0x8c,
+	0x35, 0x74, 0x3e, 0xd4, 0x41, 0x51, 0xae, 0xfb, 0xe0, 0x76, 0x1e, 0x6f, 0x04, 0x9c, 0xf9, 0x83,
+	0xf4, 0xd2, 0x1b, 0x57, 0x45, 0x32, 0x5d, 0x13, 0x39, 0x7e, 0x6a, 0x67, 0xf5, 0x22, 0x00, 0x64,
+	0x09, 0xcc, 0x31, 0x6e, 0x4b, 0x5b, 0x38, 0x46, 0xd9, 0xfb, 0x77, 0x6d, 0x4a, 0x69, 0x32, 0x67,
+	0x3c, 0x26, 0xb3, 0x0c, 0x3f, 0x33, 0x40, 0xdb, 0xb3, 0xdd, 0x37, 0x84, 0xac, 0x81, 0x4c, 0x70,
+	0x75, 0x9a, 0x18, 0x2a, 0xf6, 0x6b, 0x41, 0xe0, 0x00, 0xe6, 0x61, 0x17, 0x02, 0xc8, 0x3e, 0x66,
+	0x0b, 0x0a, 0x74, 0x0f, 0x76, 0x69, 0x3f, 0x99, 0x28, 0x95, 0x02, 0xec, 0x9e, 0x8a, 0x78, 0xde,
+	0xb3, 0x77, 0x5a, 0x70, 0xb2, 0x64, 0x54, 0x17, 0x4f, 0xca, 0x06, 0x85, 0x1a, 0x73, 0x55, 0x73,
+	0xf8, 0xe7, 0xd4, 0xe1, 0xea, 0x4a, 0xd7, 0xf6, 0x8b, 0xc5, 0x63, 0x2d, 0x86, 0xf6, 0xb5, 0x8e,
+	0x40, 0xf0, 0xe0, 0xc6, 0x6f, 0xb8, 0xa6, 0xf4, 0xb2, 0x4e, 0x14, 0x32, 0x76, 0x6c, 0x4d, 0xff,
+	0x6d, 0xe2, 0xbf, 0x2b, 0x64, 0x01, 0xa7, 0xcf, 0x70, 0x3f, 0x29, 0x20, 0x09, 0xef, 0xcf, 0x1f,
+	0x87, 0x0d, 0x85, 0xc8, 0xfc, 0xfb, 0x15, 0x62, 0x9c, 0x6b, 0x6d, 0xf8, 0x65, 0x60, 0xcd, 0xe5,
+	0x8d, 0xfe, 0xfa, 0xd3, 0xc8, 0x10, 0x20, 0xca, 0x35, 0x96, 0x8d, 0x3b, 0xd5, 0x31, 0x28, 0x85,
+	0xee, 0x00, 0xef, 0x11, 0x2a, 0xca, 0x68, 0x1f, 0x43, 0xa8, 0x51, 0xba, 0x11, 0xa8, 0xd3, 0x4f,
+	0x8f, 0xcc, 0x18, 0x87, 0x5c, 0xca, 0x13, 0xc2, 0xe0, 0x5f, 0x46, 0x81, 0x75, 0x67, 0xec, 0x06,
+	0x36, 0x54, 0x66, 0x37, 0x41, 0xe1, 0xce, 0xb3, 0x0d, 0x20, 0x1a, 0x69, 0x04, 0x0b, 0x59, 0x07,
+	0x12, 0x09, 0x6e, 0xad, 0x2a, 0xc8, 0x77, 0xc8, 0x2f, 0xf4, 0xb4, 0x22, 0xdf, 0x4f, 0x0a, 0x21,
+	0x0e, 0xed, 0xf3, 0x14, 0xf7, 0xa3, 0xcf, 0xd7, 0x92, 0x95, 0x26, 0x78, 0xf6, 0xc8, 0x09, 0xbd,
+	0x8a, 0x45, 0xce, 0x28, 0x2b, 0x16, 0x0a, 0xb8, 0xe4, 0x08, 0x7c, 0x6c, 0x2a, 0x31, 0xa4, 0xe7,
+	0xd1, 0xf6, 0x23, 0x99, 0xdd, 0x2d, 0x85, 0x76, 0x6d, 0xcf, 0x03, 0x42, 0xaf, 0x9e, 0x42, 0x4f,
+	0x17, 0x9c, 0xfd, 0x03, 0xb7, 0xdb, 0xb1, 0x7b, 0x84, 0x42, 0x07, 0xad, 0xe7, 0x9a, 0x16, 0xe8,
+	0x3a, 0xef, 0xda, 0x24, 0xef, 0x99, 0xd5, 0x09, 0xcd, 0xe0, 0x84, 0x28, 0x1c, 0x9a, 0x55, 0xf7,
+	0xb8, 0x7d, 0x7c, 0x09, 0xb8, 0x4c, 0x78, 0xb2, 0x6c, 0xce, 0x8f, 0xa1, 0x11, 0x09, 0xe1, 0x51,
+	0x7f, 0xdf, 0x53, 0x66, 0x2c, 0x01, 0x4c, 0xc9, 0x6b, 0x09, 0xa5, 0x3d, 0xbc, 0x48, 0x38, 0x83,
+	0xfd, 0x00, 0x63, 0x80, 0xb1, 0xe3, 0x6d, 0x0a, 0x03, 0xd3, 0x64, 0x69, 0x75, 0x7e, 0x7f, 0xff,
+	0xe5, 0xeb, 0x1e, 0x12, 0x97, 0x65, 0x3e, 0xd3, 0x2d, 0x49, 0x38, 0xb5, 0xbb, 0x12, 0x97, 0x60,
+	0xfe, 0x51, 0x61, 0x3d, 0x12, 0x44, 0x14, 0x9c, 0x91, 0xef, 0x8c, 0xc6, 0x3c, 0xd9, 0x1d, 0xa1,
+	0xdf, 0x76, 0x46, 0x20, 0x11, 0xab, 0xd6, 0x90, 0x23, 0x31, 0x1b, 0xe5, 0xea, 0xda, 0xc8, 0xbc,
+	0x8e, 0xf3, 0x01, 0x96, 0xd2, 0x10, 0xb4, 0xf4, 0x94, 0x7f, 0x63, 0xa1, 0x03, 0xde, 0x2b, 0xe7,
+	0x63, 0xf7, 0x62, 0xeb, 0xc4, 0x51, 0x86, 0x17, 0x7b, 0x16, 0x08, 0xef, 0x13, 0xb9, 0x10, 0x67,
+	0x5c, 0xe0, 0x19, 0x44, 0xc6, 0x2b, 0x69, 0xb1, 0xc9, 0xd4, 0x75, 0x43, 0x67, 0xef, 0xa5, 0x48,
+	0xfc, 0xf9, 0x2f, 0xf1, 0x1f, 0x20, 0xb2, 0x44, 0xe6, 0x8b, 0xf8, 0xaf, 0xfe, 0x26, 0x30, 0x82,
+	0x33, 0xbc, 0x2c, 0x18, 0xd4, 0xaa, 0x4b, 0x80, 0x59, 0xf9, 0xb5, 0xb8, 0x45, 0x84, 0xd5, 0x57,
+	0x82, 0xef, 0xa0, 0xa5, 0xda, 0x2d, 0x7f, 0x98, 0x03, 0x90, 0xaf, 0x5c, 0x48, 0x88, 0xb5, 0x3d,
+	0xdb, 0x23, 0x52, 0x13, 0x48, 0xd5, 0x6c, 0xef, 0xa7, 0x90, 0x67, 0x75, 0x6d, 0x4c, 0x9d, 0x3e,
+	0xb2, 0x73, 0x5c, 0xff, 0xd0, 0x52, 0x44, 0x1b, 0x67, 0xad, 0xa1, 0x09, 0xfb, 0x9c, 0xfd, 0x9a,
+	0xf6, 0x07, 0xf6, 0x3b, 0xd2, 0x30, 0x2e, 0x6a, 0x93, 0x89, 0x6e, 0x78, 0x2a, 0x36, 0xa9, 0x3b,
+	0xa7, 0x7d, 0x74, 0xa2, 0xb0, 0xca, 0xe1, 0xa1, 0x60, 0x76, 0x49, 0x28, 0x37, 0x40, 0x5b, 0xac,
+	0xee, 0x7e, 0x0c, 0x9f, 0x54, 0xf3, 0xca, 0xe3, 0x6c, 0x37, 0x98, 0xe5, 0x14, 0x72, 0x00, 0x87,
+	0x36, 0x1d, 0x8f, 0x31, 0x64, 0x84, 0xae, 0xed, 0xfe, 0x39, 0x86, 0xd1, 0xd3, 0x68, 0x9c, 0x09,
+	0x3c, 0x9a, 0x64, 0x85, 0x35, 0x32, 0xfd, 0xe6, 0xe9, 0xe1, 0x80, 0x66, 0x34, 0xe0, 0xea, 0x16,
+	0x09, 0xc6, 0xcc, 0x30, 0xf4, 0x02, 0xa2, 0xc2, 0x42, 0x52, 0xdc, 0xf0, 0x75, 0xb1, 0x7b, 0xf4,
+	0x86, 0x60, 0x05, 0x94, 0xd9, 0x7a, 0x16, 0xcc, 0x61, 0xd7, 0xd1, 0x1d, 0x94, 0xa9, 0xda, 0xcc,
+	0xf2, 0xb1, 0x75, 0x4a, 0xc9, 0xbb, 0x3b, 0xb7, 0x2c, 0x5e, 0x8d, 0x2d, 0x50, 0x67, 0xa7, 0x12,
+	0x4d, 0x31, 0x19, 0xdd, 0x14, 0x62, 0x8f, 0x3d, 0xe1, 0x42, 0xc2, 0xba, 0xe2, 0x31, 0x4b, 0x0b,
+	0xe5, 0xb4, 0xf3, 0x8f, 0x48, 0x03, 0x6d, 0x9a, 0x17, 0xd1, 0x3c, 0x82, 0x15, 0xe6, 0x2f, 0x16,
+	0xb6, 0x5b, 0x05, 0xa4, 0x8d, 0x07, 0x8c, 0x66, 0x4f, 0xef, 0xa0, 0x55, 0x12, 0xe3, 0xc4, 0xe7,
+	0x78, 0xc0, 0xc8, 0xfc, 0x1f, 0x70, 0x40, 0x05, 0xa8, 0x17, 0x91, 0x80, 0xfe, 0xa8, 0xb2, 0x97,
+	0x00, 0x48, 0xda, 0x6a, 0xad, 0x85, 0x46, 0x11, 0xfe, 0x99, 0x26, 0x6d, 0x17, 0x49, 0xf5, 0x17,
+	0x98, 0xef, 0x20, 0x87, 0xad, 0xb3, 0x5e, 0xcc, 0x0e, 0xb5, 0x21, 0x8f, 0xc9, 0xa1, 0xfe, 0x88,
+	0xb1, 0xff, 0xcc, 0x3e, 0xaf, 0xec, 0x31, 0x3d, 0xd4, 0x9a, 0xf6, 0xb0, 0xc3, 0x1e, 0x38, 0x3c,
+	0x45, 0x0f, 0x25, 0x86, 0xbe, 0xa3, 0x42, 0xc7, 0x05, 0x6d, 0x6e, 0x90, 0x80, 0x55, 0x06, 0x72,
+	0x31, 0xb3, 0x42, 0x07, 0xdd, 0x06, 0xea, 0xfd, 0xbd, 0xad, 0xff, 0xa2, 0x8a, 0x1d, 0x4a, 0x31,
+	0xcf, 0x95, 0x04, 0x90, 0xc3, 0x01, 0x19, 0x23, 0x68, 0x74, 0xa3, 0x7b, 0x7f, 0xaf, 0x2f, 0x9e,
+	0xa2, 0x4b, 0x6c, 0x4a, 0x7f, 0xf0, 0xed, 0xd9, 0xc9, 0xdb, 0xab, 0xf7, 0x1f, 0xcf, 0x6d, 0x17,
+	0x84, 0xd9, 0x7a, 0xed, 0xb3, 0xad, 0x59, 0xd9, 0x87, 0xef, 0x6b, 0xc2, 0xb0, 0xd6, 0x6e, 0xf4,
+	0xbb, 0xb9, 0x07, 0x12, 0x7d, 0x1e, 0x1e, 0xda, 0x30, 0x5d, 0xf7, 0xbc, 0x06, 0x7e, 0x70, 0x4a,
+	0xf5, 0x69, 0xc4, 0xb7, 0x76, 0x83, 0x30, 0xf7, 0x12, 0xad, 0xd3, 0x98, 0xfb, 0x87, 0x27, 0xb0,
+	0x63, 0xbe, 0x90, 0xc1, 0x10, 0xfa, 0xc2, 0x64, 0x75, 0x5f, 0xfb, 0x6b, 0x5c, 0x7a, 0x6d, 0x6c,
+	0xda, 0xa6, 0x31, 0x7e, 0x50, 0x28, 0x3f, 0x23, 0x4c, 0x06, 0xe5, 0x67, 0x47, 0xfd, 0x3f, 0x08,
+	0xfe, 0x03, 0x50, 0x55, 0xe3, 0x28, 0x58, 0x20, 0x00, 0x00,
+};
+
+static const uint8_t WEB_LIVE_HTML_GZ[] PROGMEM = {
+	0x1f, 0x8b, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0xff, 0x95, 0x56, 0x6d, 0x6f, 0xdb, 0x36,
+	0x10, 0xfe, 0xae, 0x5f, 0xc1, 0x2a, 0x40, 0x29, 0x21, 0xb2, 0x1c, 0xf7, 0x43, 0x90, 0xe9, 0x2d,
+	0x58, 0xda, 0x6c, 0xd9, 0x90, 0x35, 0x43, 0x92, 0x6d, 0xd8, 0x8a, 0xa0, 0xa0, 0xa5, 0x93, 0xcd,
+	0x9a, 0x26, 0x05, 0x92, 0x72, 0x12, 0x38, 0xfe, 0xef, 0x3b, 0x4a, 0x72, 0x62, 0x77, 0x48, 0xd1,
+	0x01, 0x06, 0x74, 0x3c, 0x1e, 0xef, 0xb9, 0x7b, 0xee, 0x78, 0x74, 0xf6, 0xe6, 0xc3, 0xd5, 0xfb,
+	0xdb, 0xbf, 0x7f, 0x3f, 0x27, 0x73, 0xbb, 0x14, 0x85, 0x97, 0x75, 0x9f, 0x6c, 0x0e, 0xac, 0x2a,
+	0xb2, 0x25, 0x58, 0x46, 0xca, 0x39, 0xd3, 0x06, 0x6c, 0xee, 0xb7, 0xb6, 0x1e, 0x9d, 0xf8, 0x83,
+	0x56, 0xb2, 0x25, 0xe4, 0xfe, 0x8a, 0xc3, 0x7d, 0xa3, 0xb4, 0xf5, 0x49, 0xa9, 0xa4, 0x05, 0x89,
+	0x56, 0xf7, 0xbc, 0xb2, 0xf3, 0xbc, 0x82, 0x15, 0x2f, 0x61, 0xd4, 0x2d, 0x22, 0xc2, 0x25, 0xb7,
+	0x9c, 0x89, 0x91, 0x29, 0x99, 0x80, 0x7c, 0xe2, 0x23, 0x8c, 0xe0, 0x72, 0x41, 0x34, 0x88, 0xdc,
+	0xe7, 0x78, 0xd4, 0x27, 0x73, 0x0d, 0x75, 0xee, 0x57, 0xcc, 0xb2, 0x24, 0x42, 0x0c, 0xcb, 0xad,
+	0x80, 0xe2, 0x92, 0xaf, 0x20, 0x1b, 0xf7, 0xb2, 0x97, 0x19, 0xfb, 0xe8, 0xbe, 0x53, 0x55, 0x3d,
+	0xae, 0x6b, 0x84, 0x1b, 0xd5, 0x6c, 0xc9, 0xc5, 0x63, 0xf2, 0xa3, 0x46, 0xdf, 0xe9, 0x92, 0xe9,
+	0x19, 0x97, 0xc9, 0x04, 0x96, 0x1b, 0xcf, 0xb2, 0xa9, 0x80, 0xf5, 0x54, 0xe9, 0x0a, 0xf4, 0xa8,
+	0x54, 0x42, 0xb0, 0xc6, 0x40, 0xb2, 0x15, 0x70, 0xbf, 0x8a, 0xec, 0x7c, 0xd8, 0x4f, 0x26, 0xcd,
+	0x03, 0x31, 0x4a, 0xf0, 0x8a, 0x1c, 0x94, 0x65, 0x99, 0x36, 0xac, 0xaa, 0xb8, 0x9c, 0x25, 0xef,
+	0x50, 0x7d, 0xd2, 0x3c, 0xa4, 0x16, 0x1e, 0xec, 0x88, 0x09, 0x3e, 0x93, 0x89, 0x80, 0xda, 0xba,
+	0xc3, 0xf1, 0x6a, 0xbd, 0xa3, 0xd5, 0x7c, 0x36, 0xb7, 0xe9, 0x6e, 0x40, 0x4b, 0x25, 0x95, 0x69,
+	0x58, 0xe9, 0x90, 0x74, 0x3c, 0x57, 0x96, 0xd8, 0x6a, 0x3d, 0x65, 0xe5, 0x62, 0xa6, 0x55, 0x2b,
+	0xab, 0xe4, 0xa0, 0xae, 0xe1, 0x07, 0x76, 0xb2, 0xf1, 0x0e, 0x8c, 0x5d, 0x63, 0x54, 0x4a, 0x27,
+	0x07, 0xc7, 0xc7, 0xc7, 0x1b, 0x2f, 0x56, 0x75, 0xbd, 0x55, 0x4c, 0x8f, 0x8e, 0xd0, 0xa0, 0xee,
+	0x33, 0xbd, 0x07, 0x07, 0x92, 0x4c, 0x95, 0xa8, 0x36, 0x5e, 0x36, 0x1e, 0x98, 0xc8, 0xc6, 0x7d,
+	0x99, 0x1c, 0x23, 0x58, 0xb2, 0xc9, 0xc0, 0x17, 0x0a, 0x5e, 0xd6, 0x10, 0x5e, 0xe5, 0xbe, 0xb1,
+	0x7e, 0xf1, 0x27, 0xe8, 0x29, 0x97, 0x15, 0xc4, 0x71, 0x9c, 0x8d, 0x9b, 0x22, 0x6b, 0x8a, 0x9f,
+	0x60, 0x2e, 0x30, 0x71, 0x92, 0x61, 0x90, 0xb2, 0xb3, 0xab, 0xfd, 0x62, 0x84, 0x6e, 0x71, 0x59,
+	0x38, 0x1b, 0x2f, 0xeb, 0x18, 0xc4, 0x32, 0xf4, 0x00, 0x56, 0x3b, 0xb1, 0xb8, 0x86, 0x19, 0x37,
+	0x16, 0x34, 0x96, 0x64, 0xde, 0x29, 0xfe, 0x02, 0x6d, 0x9f, 0x17, 0x3f, 0x03, 0x03, 0x84, 0xd9,
+	0x6a, 0xc6, 0xee, 0xd0, 0x78, 0xeb, 0xc0, 0x85, 0xd8, 0x21, 0x69, 0xdf, 0x69, 0xfb, 0x88, 0xc7,
+	0x3d, 0x0a, 0x06, 0x5b, 0x64, 0x6c, 0xe8, 0x80, 0xb1, 0x5f, 0x5c, 0xa8, 0x25, 0x66, 0xc1, 0x86,
+	0x48, 0x4c, 0xa9, 0x79, 0x63, 0x0b, 0x6f, 0xc5, 0x34, 0xd1, 0xea, 0xde, 0xe4, 0xeb, 0x4d, 0xe4,
+	0x8e, 0xe7, 0x95, 0x2a, 0xdb, 0x25, 0xb6, 0x5c, 0x3c, 0x03, 0x7b, 0x2e, 0xc0, 0x89, 0x67, 0x8f,
+	0xbf, 0x54, 0x01, 0xd5, 0x34, 0x8c, 0x8c, 0x7d, 0x7d, 0xdf, 0x58, 0x1a, 0xa6, 0x5e, 0xdd, 0xca,
+	0xd2, 0x72, 0x25, 0x09, 0xf6, 0x76, 0xb0, 0x88, 0x56, 0xe1, 0xba, 0x87, 0xc8, 0x1d, 0xc8, 0xa7,
+	0xc5, 0x5d, 0xea, 0xf1, 0x3a, 0x78, 0xa3, 0xc3, 0xb5, 0x7e, 0xf1, 0x54, 0x6a, 0x60, 0x16, 0x06,
+	0x67, 0x01, 0xb5, 0x88, 0x94, 0xea, 0x98, 0x4b, 0x09, 0xfa, 0xe2, 0xf6, 0xb7, 0xcb, 0x9c, 0x66,
+	0xb6, 0x72, 0x69, 0xb9, 0x8c, 0x2b, 0x52, 0x0a, 0x66, 0x0c, 0xde, 0x11, 0xff, 0x59, 0xd5, 0x0b,
+	0x34, 0xf5, 0x74, 0x5c, 0x82, 0x10, 0xe6, 0xd3, 0xd1, 0x5d, 0xec, 0x3a, 0xe9, 0xfd, 0x70, 0x79,
+	0x16, 0xe9, 0x00, 0x9e, 0xeb, 0xd4, 0x05, 0xb3, 0x30, 0xf9, 0xd5, 0xf4, 0x0b, 0x94, 0x36, 0x5e,
+	0xc0, 0xa3, 0x09, 0xdc, 0x66, 0x18, 0x1b, 0xbc, 0x6f, 0x41, 0x98, 0x3a, 0x0e, 0x10, 0xda, 0x20,
+	0xe1, 0x67, 0x50, 0x2b, 0x0d, 0x81, 0x8e, 0xfa, 0xd3, 0xee, 0x17, 0xbb, 0x8a, 0x3f, 0x5c, 0xd5,
+	0xc1, 0x22, 0x3c, 0x9c, 0xdc, 0xdd, 0x3d, 0x3d, 0xc9, 0x56, 0x88, 0x30, 0xdd, 0x74, 0x39, 0xda,
+	0x7c, 0x95, 0xe7, 0xb9, 0xd3, 0x9c, 0xd2, 0xf3, 0xeb, 0x6b, 0x9a, 0xdc, 0x58, 0x8d, 0x2d, 0x1f,
+	0xac, 0xc2, 0x14, 0x73, 0xde, 0xc6, 0x36, 0xd9, 0x8f, 0x2d, 0xcf, 0x6d, 0xa8, 0xc1, 0xb6, 0x5a,
+	0xa6, 0xaf, 0x58, 0xd8, 0x97, 0xbc, 0xde, 0xed, 0xef, 0x48, 0xb8, 0x27, 0x1f, 0x90, 0xb9, 0x20,
+	0x8c, 0xad, 0xba, 0x54, 0x6e, 0x0a, 0xdc, 0xf2, 0x25, 0x0c, 0xb0, 0x8e, 0xc3, 0x8e, 0xab, 0x8f,
+	0x6e, 0xa6, 0x50, 0xbc, 0x2f, 0x34, 0xc5, 0xa2, 0x38, 0x0b, 0xd5, 0xda, 0x60, 0x5b, 0xa8, 0x00,
+	0x4b, 0xb1, 0x6b, 0x47, 0xd3, 0x4d, 0x74, 0x72, 0x74, 0xe4, 0x92, 0x7a, 0xae, 0xa5, 0x86, 0x99,
+	0x09, 0x54, 0x88, 0x97, 0x46, 0x07, 0x1d, 0x81, 0x38, 0x7a, 0x88, 0x0a, 0xfb, 0x12, 0x2b, 0x24,
+	0x76, 0xcf, 0xba, 0x66, 0xad, 0xb0, 0x9d, 0xbd, 0xb3, 0xad, 0x5f, 0xef, 0x98, 0x1a, 0xeb, 0x5c,
+	0xef, 0x65, 0xa4, 0xe2, 0xfe, 0xf0, 0xdb, 0xb7, 0x5b, 0x29, 0x16, 0x20, 0x67, 0x76, 0x7e, 0xfa,
+	0xbc, 0xfe, 0xa2, 0xb8, 0x0c, 0x68, 0x44, 0x68, 0x98, 0xd0, 0x05, 0x70, 0x09, 0x14, 0x7d, 0xbc,
+	0xc4, 0x3f, 0xd8, 0x7d, 0x66, 0x18, 0xcb, 0x0a, 0x4e, 0x29, 0x5e, 0x7d, 0x9a, 0xb8, 0xa4, 0xba,
+	0x12, 0x81, 0xe9, 0x48, 0x3b, 0x5f, 0x21, 0xd8, 0x8d, 0x6a, 0x75, 0x09, 0x01, 0x1d, 0x83, 0x5b,
+	0x19, 0xd7, 0xbc, 0x60, 0x62, 0x1c, 0x53, 0xdd, 0xee, 0xa5, 0xbb, 0x92, 0xd8, 0x80, 0xd8, 0xd7,
+	0x12, 0xa7, 0x9b, 0x63, 0x2f, 0x7a, 0xa6, 0x0c, 0xfa, 0xd4, 0x54, 0xfe, 0xeb, 0xcd, 0xd5, 0xc7,
+	0xb8, 0x71, 0x83, 0x3c, 0x80, 0xd8, 0x4d, 0x59, 0x24, 0xbd, 0xe3, 0x2a, 0x76, 0x1f, 0xcc, 0x6e,
+	0x4b, 0x45, 0xba, 0x79, 0xcd, 0xbd, 0x33, 0xdc, 0x77, 0xdd, 0x79, 0xf8, 0xaf, 0xe7, 0x6f, 0xf8,
+	0xe8, 0x60, 0xf6, 0x9d, 0x0c, 0xc8, 0xff, 0xcb, 0x8d, 0xb1, 0xcc, 0xb6, 0xe6, 0x3b, 0xf3, 0x34,
+	0x76, 0xbf, 0x6b, 0x3c, 0x54, 0xec, 0x96, 0x92, 0xfe, 0xd1, 0x58, 0x6c, 0x35, 0x42, 0x0f, 0x55,
+	0xdc, 0x76, 0xe2, 0x67, 0x73, 0x48, 0x89, 0x89, 0xc8, 0x05, 0xb0, 0xa6, 0x53, 0xe3, 0x10, 0x6b,
+	0x50, 0x75, 0x16, 0x91, 0xb3, 0xd6, 0x24, 0xa8, 0x42, 0xde, 0xa6, 0xad, 0x79, 0x7a, 0xa2, 0x23,
+	0x1a, 0x1e, 0x62, 0x8d, 0xdf, 0x0b, 0xee, 0x4a, 0xd3, 0x19, 0x97, 0xbd, 0xfc, 0x0d, 0x12, 0xf0,
+	0xe2, 0xed, 0xc4, 0x1e, 0xae, 0xd1, 0xaa, 0x14, 0x0a, 0x43, 0xfe, 0x3a, 0x58, 0xd7, 0x13, 0xe9,
+	0xd7, 0xe1, 0xfe, 0xd3, 0x12, 0x7c, 0x76, 0x05, 0x10, 0x37, 0xed, 0x47, 0x5b, 0xe4, 0x15, 0x4e,
+	0x79, 0x7c, 0x5b, 0x40, 0xc6, 0x74, 0x8b, 0xac, 0x10, 0x4d, 0x2b, 0x9d, 0xef, 0x20, 0x7d, 0x87,
+	0xfb, 0xe1, 0xb9, 0x68, 0xe5, 0x8c, 0xb4, 0xa8, 0xd2, 0x53, 0xad, 0xca, 0x39, 0xc8, 0xa8, 0x43,
+	0x70, 0x53, 0x85, 0x48, 0x68, 0xf1, 0x2d, 0x41, 0x98, 0xd4, 0x3d, 0x45, 0xfd, 0x78, 0xce, 0xc6,
+	0xc3, 0x48, 0xef, 0xfe, 0x3e, 0xfc, 0x0b, 0xbb, 0x6e, 0x49, 0x15, 0x55, 0x08, 0x00, 0x00,
+};
+
+static const web_asset_t webAssets[] = {
+	{"/", "text/html", WEB_INDEX_HTML_GZ, sizeof(WEB_INDEX_HTML_GZ), "\"9ee3d9eadf625739\""},
+	{"/live", "text/html", WEB_LIVE_HTML_GZ, sizeof(WEB_LIVE_HTML_GZ), "\"2dbbdb5a0f9788b9\""},
+};
+
+#endif // SRC_WEB_ASSETS_H_
@@ -0,0 +1,177 @@
+#include "web_live.h"
+#include "modbus_base.h"
+
+// Je verbundenem Browser der zuletzt an IHN gesendete Stand (Delta-Basis, siehe web_live.h).
+typedef struct
+{
+	AsyncEventSourceClient *client; // nullptr = Platz frei
+	bool fresh;						// Vollbild steht noch aus
+	uint32_t statusMs;				// millis() des letzten "status" (0 = noch nie)
+	uint16_t values[MODBUS_NUM_REGISTERS];
+	uint16_t faultValue[MODBUS_NUM_FAULT_REGS];
+	bool faultValid[MODBUS_NUM_FAULT_REGS];
+} live_client_t;
+
+static AsyncEventSource liveEvents("/events");
+// Plaetze werden im AsyncTCP-Task belegt/freigegeben (onConnect/onDisconnect) und im Loop-Task
+// beschickt -> Mutex, damit der Loop nie an einen gerade geloeschten Client sendet.
+static live_client_t liveClients[LIVE_MAX_CLIENTS];
+static SemaphoreHandle_t liveMutex = nullptr;
+static volatile uint8_t liveClientCount = 0;
+// Ab hier nur Loop-Task.
+static uint32_t lastPushMs = 0;
+static register_snapshot_t liveSnap;
+static char liveJson[kModbusDataJsonMax + 64];
+
+// Serialisiert doc und stellt es dem Client zu. false = nicht gesendet (Stand bleibt -> naechste Runde).
+static bool sendJson(live_client_t &c, const char *event, const JsonDocument &doc)
+{
+	size_t n = serializeJson(doc, liveJson, sizeof(liveJson));
+	if (n == 0 || n >= sizeof(liveJson) - 1)
+	{
+		LOGF(LOG_LEVEL_ERROR, "Live-Event %s: JSON abgeschnitten (%u Bytes)", event, (unsigned)n);
+		return false;
+	}
+	return c.client->send(liveJson, event, liveSnap.generation);
+}
+
+static void pushSnapshot(live_client_t &c)
+{
+	if (c.fresh)
+	{
+		JsonDocument doc;
+		writeRegisterValuesToJson(liveSnap, doc["regs"].to<JsonObject>());
+		writeFaultStatusToJson(liveSnap, doc);
+		if (sendJson(c, "snapshot", doc))
+		{
+			memcpy(c.values, liveSnap.values, sizeof(c.values));
+			memcpy(c.faultValue, liveSnap.faultValue, sizeof(c.faultValue));
+			memcpy(c.faultValid, liveSnap.faultValid, sizeof(c.faultValid));
+			c.fresh = false;
+		}
+		return;
+	}
+	static bool changed[MODBUS_NUM_REGISTERS];
+	bool any = false;
+	for (size_t i = 0; i < MODBUS_NUM_REGISTERS; ++i)
+	{
+		changed[i] = c.values[i] != liveSnap.values[i]; // exakt, ohne Totband: Live-Ansicht
+		any |= changed[i];
+	}
+	if (any)
+	{
+		JsonDocument doc;
+		writeRegisterValuesToJson(liveSnap, doc, changed);
+		for (size_t i = 0; i < MODBUS_NUM_REGISTERS; ++i)
+		{
+			// Ungueltige Werte laesst writeRegisterValuesToJson weg; im Delta als null melden.
+			if (changed[i] && liveSnap.values[i] == 0xFFFF && registers[i].type != REGISTER_TYPE_BITFIELD)
+			{
+				doc[registers[i].name] = nullptr;
+			}
+		}
+		if (doc.size() == 0 || sendJson(c, "regs", doc))
+		{
+			memcpy(c.values, liveSnap.values, sizeof(c.values));
+		}
+	}
+	if (memcmp(c.faultValue, liveSnap.faultValue, sizeof(c.faultValue)) != 0 ||
+		memcmp(c.faultValid, liveSnap.faultValid, sizeof(c.faultValid)) != 0)
+	{
+		JsonDocument doc;
+		writeFaultStatusToJson(liveSnap, doc);
+		if (sendJson(c, "fault", doc))
+		{
+			memcpy(c.faultValue, liveSnap.faultValue, sizeof(c.faultValue));
+			memcpy(c.faultValid, liveSnap.faultValid, sizeof(c.faultValid));
+		}
+	}
+}
+
+static void pushStatus(live_client_t &c, uint32_t nowMs)
+{
+	JsonDocument doc;
+	doc["uptime_s"] = nowMs / 1000;
+	doc["heap"] = ESP.getFreeHeap();
+	doc["bus"] = getModbusState();
+	doc["clients"] = liveClientCount;
+	if (sendJson(c, "status", doc))
+	{
+		c.statusMs = nowMs | 1; // nie 0 (= "noch nie")
+	}
+}
+
+void initLiveEvents(AsyncWebServer &server)
+{
+	if (liveMutex == nullptr)
+	{
+		liveMutex = xSemaphoreCreateMutex();
+	}
+	liveEvents.onConnect([](AsyncEventSourceClient *client)
+						 {
+							 bool placed = false;
+							 xSemaphoreTake(liveMutex, portMAX_DELAY);
+							 for (live_client_t &c : liveClients)
+							 {
+								 if (c.client == nullptr)
+								 {
+									 memset(&c, 0, sizeof(c));
+									 c.client = client;
+									 c.fresh = true;
+									 liveClientCount++;
+									 placed = true;
+									 break;
+								 }
+							 }
+							 xSemaphoreGive(liveMutex);
+							 if (!placed)
+							 {
+								 // Nicht im Callback schliessen (die Lib haelt den Client noch); die Seite
+								 // schliesst ihre EventSource selbst, Reconnect fruehestens nach 60 s.
+								 client->send("{}", "full", 0, 60000);
+							 } });
+	liveEvents.onDisconnect([](AsyncEventSourceClient *client)
+							{
+								xSemaphoreTake(liveMutex, portMAX_DELAY);
+								for (live_client_t &c : liveClients)
+								{
+									if (c.client == client)
+									{
+										c.client = nullptr;
+										liveClientCount--;
+									}
+								}
+								xSemaphoreGive(liveMutex); });
+	server.addHandler(&liveEvents);
+}
+
+void loopLiveEvents()
+{
+	uint32_t nowMs = millis();
+	if (liveClientCount == 0 || (uint32_t)(nowMs - lastPushMs) < LIVE_PUSH_INTERVAL_MS)
+	{
+		return;
+	}
+	lastPushMs = nowMs;
+	bool haveSnap = readRegisterSnapshot(liveSnap);
+	if (xSemaphoreTake(liveMutex, pdMS_TO_TICKS(50)) != pdTRUE)
+	{
+		return;
+	}
+	for (live_client_t &c : liveClients)
+	{
+		if (c.client == nullptr || c.client->packetsWaiting() > LIVE_CLIENT_MAX_QUEUED)
+		{
+			continue; // frei bzw. haengt hinterher -> naechste Runde ein Delta gegen seinen Stand
+		}
+		if (haveSnap)
+		{
+			pushSnapshot(c);
+		}
+		if (c.statusMs == 0 || (uint32_t)(nowMs - c.statusMs) >= LIVE_STATUS_INTERVAL_MS)
+		{
+			pushStatus(c, nowMs);
+		}
+	}
+	xSemaphoreGive(liveMutex);
+}
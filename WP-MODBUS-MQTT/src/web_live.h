@@ -0,0 +1,31 @@
+#ifndef SRC_WEB_LIVE_H_
+#define SRC_WEB_LIVE_H_
+
+#include <ESPAsyncWebServer.h>
+
+// Live-Ansicht per Server-Sent Events. Bisher gab es keine Live-Daten im Web-UI. Jetzt:
+// /events (AsyncEventSource) schiebt Aenderungen des Register-Snapshots (readRegisterSnapshot) an
+// die verbundenen Browser, /live (web/live.html, statisch ueber web_assets.h) ist ein kleines Dashboard dazu.
+//
+// Ereignisse (data = JSON, id = Snapshot-Generation):
+//   snapshot  Vollbild {"regs":{...},"faults":[...],"fault_active":b} beim Verbinden
+//   regs      nur die seit dem letzten Senden an DIESEN Client geaenderten Register (ungueltig = null)
+//   fault     Fehlerstatus, sobald er sich gegenueber dem Client-Stand aendert (Flanke)
+//   status    Uptime/Heap/Bus-Status alle LIVE_STATUS_INTERVAL_MS (haelt die Verbindung offen)
+//
+// Gesendet wird aus dem Loop-Task (loopLiveEvents), hoechstens alle LIVE_PUSH_INTERVAL_MS. Jeder
+// Client hat seinen eigenen "zuletzt gesendet"-Stand: haengt er hinterher (mehr als
+// LIVE_CLIENT_MAX_QUEUED Nachrichten in seiner Sendequeue), wird er in dieser Runde uebersprungen
+// und bekommt danach EIN Delta gegen seinen Stand -> langsame Clients sehen nur den juengsten Stand,
+// keine aufgestauten Zwischenwerte, und bremsen die anderen nicht.
+#define LIVE_MAX_CLIENTS          4
+#define LIVE_PUSH_INTERVAL_MS     250
+#define LIVE_STATUS_INTERVAL_MS   10000
+#define LIVE_CLIENT_MAX_QUEUED    2
+
+// Registriert /events am Server (aus setupWebserver).
+void initLiveEvents(AsyncWebServer &server);
+// Aus dem Loop-Task (loopWebserver): Aenderungen an die Clients verteilen.
+void loopLiveEvents();
+
+#endif // SRC_WEB_LIVE_H_
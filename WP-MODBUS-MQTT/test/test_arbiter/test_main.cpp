@@ -0,0 +1,240 @@
+// Host-Test fuer BusArbiter (modbus_arbiter.h): pio test -e native
+//
+// Simuliert wird der Bus mit einem fremden Master (Display), der mit fester Periode plus Jitter
+// pollt: Anfrage-Frame, Slave-Latenz, Antwort-Frame = ein Burst. Der eigene "Worker" sendet mit
+// kurzen Pausen (Poll-Plan, Bus-Gap) und verhaelt sich wie busArbiterWait(): Leitung belegt -> bis
+// Frame-Ende mithoeren, sonst deferUs() abwarten (frueher aufwachen, sobald ein Fremd-Frame zu Ende ist).
+// Was waehrend einer eigenen Transaktion auf dem Bus liegt, ist kollidiert und wird nicht gehoert.
+// Nach dem Einrasten darf keine eigene Transaktion mehr einen Burst ueberlappen.
+//
+// Der Zufall ist fest geseedet; die Grenzen unten halten fuer die Seeds 1..1000 (vor dem Einrasten
+// kollidiert der Worker, dabei gehen Fremd-Frames unter und das Einrasten zieht sich hin).
+
+#include <unity.h>
+#include <vector>
+#include "modbus_arbiter.h"
+
+struct SimFrame
+{
+	int64_t start;
+	int64_t end;
+	uint32_t burst; // Index des Bursts, zu dem das Frame gehoert
+	bool missed;	// kollidiert mit einer eigenen Transaktion -> nicht gehoert
+};
+
+struct SimBurst
+{
+	int64_t start;
+	int64_t end;
+};
+
+struct SimResult
+{
+	uint32_t sent;			   // eigene Transaktionen gesamt
+	uint32_t sentLocked;	   // davon mit eingerastetem Arbiter gestartet
+	uint32_t overlapsLocked;   // davon mit Burst-Ueberlappung (muss 0 sein)
+	int64_t lastOverlapUs;	   // Start der letzten davon (-1 = keine)
+	int64_t firstLockUs;	   // erste Transaktion mit eingerastetem Arbiter (-1 = nie)
+	int64_t maxWaitUs;		   // laengste Rueckstellung einer Transaktion
+	int64_t lastPeriodUs;	   // gelernte Periode am Ende
+};
+
+// Deterministischer Zufall (LCG), damit der Test reproduzierbar bleibt.
+static uint32_t rngState;
+static int64_t rnd(int64_t lo, int64_t hi)
+{
+	rngState = rngState * 1664525u + 1013904223u;
+	return lo + (int64_t)((rngState >> 8) % (uint32_t)(hi - lo + 1));
+}
+
+// Fremder Master: bis horizon alle Bursts; ab switchUs (falls > 0) mit periodB statt periodA.
+// Bei 9600 Baud: Anfrage 8 Byte ~ 9 ms, Antwort je nach Blockgroesse 15..45 ms, Slave-Latenz 20..80 ms.
+static void buildMaster(std::vector<SimFrame> &frames, std::vector<SimBurst> &bursts, int64_t periodA,
+						int64_t periodB, int64_t switchUs, int64_t jitterUs, int64_t horizon)
+{
+	int64_t nominal = 300000;
+	while (nominal < horizon)
+	{
+		int64_t period = (switchUs > 0 && nominal >= switchUs) ? periodB : periodA;
+		int64_t reqStart = nominal + rnd(-jitterUs, jitterUs);
+		int64_t reqEnd = reqStart + 9000;
+		int64_t respStart = reqEnd + rnd(20000, 80000);
+		int64_t respEnd = respStart + rnd(15000, 45000);
+		uint32_t b = (uint32_t)bursts.size();
+		bursts.push_back({reqStart, respEnd});
+		frames.push_back({reqStart, reqEnd, b, false});
+		frames.push_back({respStart, respEnd, b, false});
+		nominal += period;
+	}
+}
+
+static SimResult simulate(int64_t periodA, int64_t periodB, int64_t switchUs, int64_t jitterUs, int64_t horizon)
+{
+	std::vector<SimFrame> frames;
+	std::vector<SimBurst> bursts;
+	buildMaster(frames, bursts, periodA, periodB, switchUs, jitterUs, horizon);
+
+	BusArbiter arb;
+	SimResult r = {0, 0, 0, -1, -1, 0, 0};
+	size_t heard = 0; // frames[0..heard) sind vorbei
+	int64_t now = 0;
+	const int64_t gapUs = 50000; // Bus-Gap zwischen eigenen Transaktionen (MODBUS_GAP_MIN_MS)
+	while (now < horizon - 2000000)
+	{
+		// Einzel-Read bzw. Dump-Chunk im Wechsel.
+		int64_t tx = (r.sent % 3 == 0) ? 120000 : 40000;
+		int64_t requested = now;
+		for (;;)
+		{
+			while (heard < frames.size() && frames[heard].end <= now)
+			{
+				if (!frames[heard].missed)
+				{
+					arb.onForeignFrame(frames[heard].start, frames[heard].end);
+				}
+				heard++;
+			}
+			if (heard < frames.size() && frames[heard].start <= now)
+			{
+				now = frames[heard].end; // rtuLineBusy(): Frame zu Ende hoeren
+				continue;
+			}
+			int64_t d = arb.deferUs(now, tx);
+			if (d == 0)
+			{
+				break;
+			}
+			int64_t wake = now + d;
+			if (heard < frames.size() && frames[heard].end < wake)
+			{
+				wake = frames[heard].end; // rtuListen kehrt mit dem naechsten Frame zurueck
+			}
+			now = wake;
+		}
+		if (now - requested > r.maxWaitUs)
+		{
+			r.maxWaitUs = now - requested;
+		}
+
+		bool isLocked = arb.locked(now);
+		bool overlap = false;
+		for (size_t i = heard; i < frames.size() && frames[i].start < now + tx; ++i)
+		{
+			frames[i].missed = true;
+		}
+		for (const SimBurst &b : bursts)
+		{
+			if (b.start < now + tx && b.end > now)
+			{
+				overlap = true;
+				break;
+			}
+		}
+		r.sent++;
+		if (isLocked)
+		{
+			if (r.firstLockUs < 0)
+			{
+				r.firstLockUs = now;
+			}
+			r.sentLocked++;
+			if (overlap)
+			{
+				r.overlapsLocked++;
+				r.lastOverlapUs = now;
+			}
+		}
+		now += tx + gapUs + rnd(0, 250000);
+	}
+	r.lastPeriodUs = arb.periodUs();
+	return r;
+}
+
+void setUp()
+{
+	rngState = 12345;
+}
+
+void tearDown()
+{
+}
+
+// Display mit 1 s +-20 ms: rastet ein, danach keine Kollision mehr, und es bleibt genug Durchsatz
+// (das Ziel ist Ausweichen, nicht Schweigen).
+void test_no_overlap_after_lock_jittered_master()
+{
+	SimResult r = simulate(1000000, 0, 0, 20000, 120000000);
+	TEST_ASSERT_TRUE_MESSAGE(r.firstLockUs >= 0, "Arbiter rastet nie ein");
+	TEST_ASSERT_TRUE_MESSAGE(r.firstLockUs < 40000000, "Einrasten dauert laenger als 40 Perioden");
+	TEST_ASSERT_EQUAL_UINT32_MESSAGE(0, r.overlapsLocked, "Kollision trotz eingerastetem Arbiter");
+	TEST_ASSERT_TRUE_MESSAGE(r.sentLocked > 2 * 100, "zu wenig Durchsatz (< 2 Transaktionen je Periode)");
+	TEST_ASSERT_TRUE_MESSAGE(r.maxWaitUs < (int64_t)ARBITER_MAX_DEFER_MS * 1000, "Rueckstellung erreicht ARBITER_MAX_DEFER_MS");
+	TEST_ASSERT_TRUE_MESSAGE(r.lastPeriodUs > 980000 && r.lastPeriodUs < 1020000, "gelernte Periode weicht ab");
+}
+
+// Schnelleres Display (500 ms +-10 ms): das freie Fenster je Periode ist klein, trotzdem
+// kollisionsfrei und nicht ausgehungert.
+void test_no_overlap_fast_master()
+{
+	SimResult r = simulate(500000, 0, 0, 10000, 60000000);
+	TEST_ASSERT_TRUE_MESSAGE(r.firstLockUs >= 0, "Arbiter rastet nie ein");
+	TEST_ASSERT_EQUAL_UINT32_MESSAGE(0, r.overlapsLocked, "Kollision trotz eingerastetem Arbiter");
+	TEST_ASSERT_TRUE_MESSAGE(r.sentLocked > 60, "zu wenig Durchsatz (< 1 Transaktion je 2 Perioden)");
+}
+
+// Display wechselt mitten im Lauf den Takt (1 s -> 700 ms, Bursts im neuen Takt ab ~31.0 s): ein zu
+// frueher Burst ist nicht vorhersagbar und darf eine schon laufende Transaktion treffen; geht seine
+// Anfrage dabei unter, trifft es auch die Antwort und ggf. den naechsten Burst (31.7 s). Sobald einer
+// gehoert wird, faellt die Vorhersage weg, der Arbiter rastet auf den neuen Takt ein und kollidiert
+// nicht mehr (auch nicht auf einem Vielfachen davon).
+void test_relock_after_period_change()
+{
+	SimResult r = simulate(1000000, 700000, 30000000, 15000, 90000000);
+	TEST_ASSERT_TRUE_MESSAGE(r.overlapsLocked <= 3, "mehr als drei Kollisionen beim Taktwechsel");
+	TEST_ASSERT_TRUE_MESSAGE(r.lastOverlapUs < 32000000, "Kollision nach dem zweiten Burst im neuen Takt");
+	TEST_ASSERT_TRUE_MESSAGE(r.lastPeriodUs > 680000 && r.lastPeriodUs < 720000, "neue Periode nicht gelernt");
+}
+
+// Master ohne Antworten (Slave schweigt, jeder Burst nur ein Frame): wird trotzdem gelernt, nur
+// einen Burst spaeter.
+void test_locks_on_master_without_responses()
+{
+	BusArbiter arb;
+	int64_t t = 0;
+	for (int i = 0; i < 12; ++i)
+	{
+		t = 1000000LL * i + rnd(-10000, 10000);
+		arb.onForeignFrame(t, t + 9000);
+	}
+	TEST_ASSERT_TRUE(arb.locked(t + 100000));
+	TEST_ASSERT_TRUE(arb.periodUs() > 980000 && arb.periodUs() < 1020000);
+}
+
+// Verstummt der fremde Master, faellt die Vorhersage nach ARBITER_STALE_PERIODS weg und es wird
+// nicht mehr zurueckgestellt.
+void test_unlocks_when_master_goes_silent()
+{
+	BusArbiter arb;
+	int64_t t = 0;
+	for (int i = 0; i < 10; ++i)
+	{
+		t = 1000000LL * i + rnd(-10000, 10000);
+		arb.onForeignFrame(t, t + 9000);
+		arb.onForeignFrame(t + 50000, t + 80000);
+	}
+	TEST_ASSERT_TRUE(arb.locked(t + 100000));
+	int64_t later = t + (ARBITER_STALE_PERIODS + 1) * 1000000LL;
+	TEST_ASSERT_FALSE(arb.locked(later));
+	TEST_ASSERT_TRUE(arb.deferUs(later, 100000) == 0);
+}
+
+int main(int, char **)
+{
+	UNITY_BEGIN();
+	RUN_TEST(test_no_overlap_after_lock_jittered_master);
+	RUN_TEST(test_no_overlap_fast_master);
+	RUN_TEST(test_relock_after_period_change);
+	RUN_TEST(test_locks_on_master_without_responses);
+	RUN_TEST(test_unlocks_when_master_goes_silent);
+	return UNITY_END();
+}
@@ -0,0 +1,103 @@
+#!/usr/bin/env python3
+"""Packt die statische Web-Oberflaeche (web/*.html) gzip-komprimiert in src/web_assets.h.
+
+Laeuft als PlatformIO-Pre-Script (platformio.ini: extra_scripts = pre:tools/build_web.py) vor
+jedem Build und laesst sich auch direkt aufrufen:
+
+    python3 tools/build_web.py
+
+Je Datei: Einrueckung, Leerzeilen und HTML-Kommentare entfernen, gzip (-9, mtime 0 -> das
+Ergebnis haengt nur vom Inhalt ab), als PROGMEM-Array plus starkem ETag (SHA-256 der gzip-
+Bytes). Die Header-Datei wird nur neu geschrieben, wenn sich etwas geaendert hat (sonst baute
+PlatformIO jedes Mal setupWebserver.cpp neu).
+"""
+
+import gzip
+import hashlib
+import io
+import os
+import re
+
+# Datei in web/ -> (URL, MIME-Typ)
+ASSETS = [
+    ('index.html', '/', 'text/html'),
+    ('live.html', '/live', 'text/html'),
+]
+
+
+def minify(text):
+    text = re.sub(r'<!--.*?-->', '', text, flags=re.S)
+    lines = (line.strip() for line in text.splitlines())
+    return '\n'.join(line for line in lines if line)
+
+
+def gzip_bytes(data):
+    buf = io.BytesIO()
+    with gzip.GzipFile(fileobj=buf, mode='wb', compresslevel=9, mtime=0) as f:
+        f.write(data)
+    return buf.getvalue()
+
+
+def c_name(filename):
+    return 'WEB_' + re.sub(r'[^A-Za-z0-9]', '_', filename).upper()
+
+
+def render(project_dir):
+    out = [
+        '// Generiert von tools/build_web.py aus web/ -- nicht von Hand aendern.',
+        '#ifndef SRC_WEB_ASSETS_H_',
+        '#define SRC_WEB_ASSETS_H_',
+        '',
+        '#include "Arduino.h"',
+        '',
+        'typedef struct',
+        '{',
+        '\tconst char *url;',
+        '\tconst char *mime;',
+        '\tconst uint8_t *gz; // gzip-komprimiert (Content-Encoding: gzip)',
+        '\tsize_t len;',
+        '\tconst char *etag; // stark, mit Anfuehrungszeichen',
+        '} web_asset_t;',
+        '',
+    ]
+    table = []
+    for filename, url, mime in ASSETS:
+        with open(os.path.join(project_dir, 'web', filename), encoding='utf-8') as f:
+            raw = minify(f.read()).encode('utf-8')
+        gz = gzip_bytes(raw)
+        name = c_name(filename)
+        etag = '"' + hashlib.sha256(gz).hexdigest()[:16] + '"'
+        out.append('static const uint8_t %s_GZ[] PROGMEM = {' % name)
+        for i in range(0, len(gz), 16):
+            out.append('\t' + ', '.join('0x%02x' % b for b in gz[i:i + 16]) + ',')
+        out.append('};')
+        out.append('')
+        table.append('\t{"%s", "%s", %s_GZ, sizeof(%s_GZ), "%s"},' % (url, mime, name, name, etag.replace('"', '\\"')))
+    out.append('static const web_asset_t webAssets[] = {')
+    out.extend(table)
+    out.append('};')
+    out.append('')
+    out.append('#endif // SRC_WEB_ASSETS_H_')
+    return '\n'.join(out) + '\n'
+
+
+def build(project_dir):
+    target = os.path.join(project_dir, 'src', 'web_assets.h')
+    content = render(project_dir)
+    try:
+        with open(target, encoding='utf-8') as f:
+            if f.read() == content:
+                return
+    except FileNotFoundError:
+        pass
+    with open(target, 'w', encoding='utf-8') as f:
+        f.write(content)
+    print('build_web: %s aktualisiert' % os.path.relpath(target, project_dir))
+
+
+try:
+    Import('env')  # noqa: F821 -- von PlatformIO/SCons bereitgestellt
+    build(env.subst('$PROJECT_DIR'))  # noqa: F821
+except NameError:
+    if __name__ == '__main__':
+        build(os.path.join(os.path.dirname(os.path.abspath(__file__)), '..'))
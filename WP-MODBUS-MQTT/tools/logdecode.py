@@ -0,0 +1,228 @@
+#!/usr/bin/env python3
+"""Dekodiert binaere Log-Sets (src/log_record.h) zu Text.
+
+Eingabe: Download von /log/current?raw=1 (bzw. previous/crash) oder einzelne Segmentdateien.
+Die Formatstrings holt sich das Skript aus den LOGF-Aufrufen in src/ und bildet dieselben
+Meldungs-IDs wie logFmtId() (FNV-1a) -> das Skript muss zum Stand der Firmware passen.
+
+    python3 tools/logdecode.py log.bin
+    curl -s http://<ip>/log/crash?raw=1 | python3 tools/logdecode.py -
+    python3 tools/logdecode.py --udp 5514    # Syslog-Senke im kompakten Format (syslog_raw=1)
+"""
+
+import argparse
+import datetime
+import os
+import re
+import socket
+import struct
+import sys
+
+RECORD_MARK = 0xB0
+MSG_TEXT = 0
+MSG_TIME_SYNC = 1
+
+# Level = beliebiger Ausdruck bis zum ersten Stringliteral (auch LOG_LEVEL_X + 1 o.ae.), sonst fehlt
+# das Format in der Tabelle und die Records erscheinen nur als Rohwerte.
+LOGF_RE = re.compile(r'LOGF\s*\(\s*[^";]*?,\s*((?:"(?:[^"\\]|\\.)*"\s*)+)', re.S)
+STRING_RE = re.compile(r'"((?:[^"\\]|\\.)*)"')
+SPEC_RE = re.compile(r'%([-+ #0]*)(\*|\d+)?(?:\.(\*|\d*))?(hh|h|ll|l|L|j|z|t)?([a-zA-Z%])')
+ESCAPES = {'n': '\n', 't': '\t', 'r': '\r', '\\': '\\', '"': '"', "'": "'", '0': '\0'}
+
+
+def unescape(text):
+    """C-Stringliteral -> Bytes (die in src/ vorkommenden Escapes)."""
+    out = bytearray()
+    i = 0
+    while i < len(text):
+        c = text[i]
+        if c == '\\' and i + 1 < len(text):
+            n = text[i + 1]
+            if n == 'x':
+                m = re.match(r'[0-9a-fA-F]+', text[i + 2:])
+                out.append(int(m.group(0), 16) & 0xFF)
+                i += 2 + len(m.group(0))
+                continue
+            out += ESCAPES.get(n, n).encode('utf-8')
+            i += 2
+            continue
+        out += c.encode('utf-8')
+        i += 1
+    return bytes(out)
+
+
+def fmt_id(fmt):
+    h = 2166136261
+    for b in fmt:
+        h = ((h ^ b) * 16777619) & 0xFFFFFFFF
+    return h + 2 if h <= MSG_TIME_SYNC else h
+
+
+def load_formats(src_dir):
+    table = {}
+    for root, _, files in os.walk(src_dir):
+        for name in files:
+            if not name.endswith(('.cpp', '.h')):
+                continue
+            with open(os.path.join(root, name), encoding='utf-8', errors='replace') as f:
+                code = f.read()
+            for m in LOGF_RE.finditer(code):
+                fmt = b''.join(unescape(s) for s in STRING_RE.findall(m.group(1)))
+                table[fmt_id(fmt)] = fmt.decode('utf-8', errors='replace')
+    return table
+
+
+class Reader:
+    def __init__(self, data):
+        self.data = data
+        self.pos = 0
+
+    def varint(self):
+        v = 0
+        shift = 0
+        while True:
+            if self.pos >= len(self.data) or shift >= 70:
+                raise EOFError
+            b = self.data[self.pos]
+            self.pos += 1
+            v |= (b & 0x7F) << shift
+            if not b & 0x80:
+                return v
+            shift += 7
+
+    def take(self, n):
+        if self.pos + n > len(self.data):
+            raise EOFError
+        chunk = self.data[self.pos:self.pos + n]
+        self.pos += n
+        return chunk
+
+
+def unzigzag(v):
+    return (v >> 1) ^ -(v & 1)
+
+
+def format_message(fmt, payload):
+    """Gegenstueck zu logRecordFormat(): Argumente in der Reihenfolge der %-Angaben."""
+    r = Reader(payload)
+    out = []
+    last = 0
+    for m in SPEC_RE.finditer(fmt):
+        out.append(fmt[last:m.start()])
+        last = m.end()
+        flags, width, prec, _, conv = m.groups()
+        if conv == '%':
+            out.append('%')
+            continue
+        try:
+            if width == '*':
+                width = str(unzigzag(r.varint()))
+            if prec == '*':
+                prec = str(unzigzag(r.varint()))
+            spec = '%' + flags + (width or '') + ('.' + prec if prec is not None else '')
+            if conv in 'di':
+                out.append((spec + 'd') % unzigzag(r.varint()))
+            elif conv in 'uoxX':
+                out.append((spec + ('d' if conv == 'u' else conv)) % r.varint())
+            elif conv == 'c':
+                out.append((spec + 'c') % chr(r.varint()))
+            elif conv in 'fFeEgGaA':
+                value = struct.unpack('<f', r.take(4))[0]
+                out.append(value.hex() if conv in 'aA' else (spec + conv) % value)
+            elif conv == 's':
+                out.append((spec + 's') % r.take(r.varint()).decode('utf-8', errors='replace'))
+            elif conv == 'p':
+                out.append('0x%x' % r.varint())
+            else:
+                out.append(m.group(0))
+        except EOFError:
+            out.append('?')  # beim Kodieren abgeschnitten
+    out.append(fmt[last:])
+    return ''.join(out)
+
+
+def parse_record(data, pos):
+    """(level, uptime_ms, msg_id, payload, next_pos); None = kein Record an pos."""
+    b = data[pos]
+    if b & 0xF0 != RECORD_MARK or b & 0x0F > 4:
+        return None
+    r = Reader(data)
+    r.pos = pos + 1
+    try:
+        uptime = r.varint()
+        msg_id = struct.unpack('<I', r.take(4))[0]
+        length_pos = r.pos
+        length = r.varint()
+        if uptime > 0xFFFFFFFF or length > 0x3FFF or r.pos - length_pos > 2:
+            return None
+        payload = r.take(length)
+    except EOFError:
+        return None
+    return b & 0x0F, uptime, msg_id, payload, r.pos
+
+
+def decode(data, formats, utc, out):
+    sync = None  # (uptime_ms, epoch_s)
+    pos = 0
+    skipped = 0
+    while pos < len(data):
+        rec = parse_record(data, pos)
+        if rec is None:
+            pos += 1
+            skipped += 1
+            continue
+        level, uptime, msg_id, payload, pos = rec
+        if msg_id == MSG_TIME_SYNC:
+            epoch = Reader(payload).varint() if payload else 0
+            sync = (uptime, epoch) if epoch else None
+            continue
+        if msg_id == MSG_TEXT:
+            text = payload.decode('utf-8', errors='replace')
+        elif msg_id in formats:
+            text = format_message(formats[msg_id], payload)
+        else:
+            text = '[#%08x] %s' % (msg_id, payload.hex(' '))
+        if level == 0:
+            out.write(text + '\n')
+            continue
+        if sync:
+            t = sync[1] + int((uptime - sync[0]) / 1000)
+            when = datetime.datetime.fromtimestamp(t, datetime.timezone.utc if utc else None)
+            ts = when.strftime('%Y-%m-%d %H:%M:%S')
+        else:
+            ts = '+%dms' % uptime
+        out.write('%s [%d] %s\n' % (ts, level, text))
+    if skipped:
+        sys.stderr.write('logdecode: %d Byte ohne gueltigen Record uebersprungen\n' % skipped)
+
+
+def main():
+    here = os.path.dirname(os.path.abspath(__file__))
+    ap = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    ap.add_argument('files', nargs='*', help="Log-Sets/Segmente in Reihenfolge ('-' = stdin)")
+    ap.add_argument('--udp', type=int, metavar='PORT', help='Datagramme der Syslog-Senke empfangen und live dekodieren')
+    ap.add_argument('--src', default=os.path.join(here, '..', 'src'), help='Quellverzeichnis mit den LOGF-Aufrufen')
+    ap.add_argument('--utc', action='store_true', help='Zeitstempel in UTC statt lokaler Zeit')
+    args = ap.parse_args()
+    formats = load_formats(args.src)
+    if args.udp:
+        # Jedes Datagramm beginnt mit einem Zeit-Sync und ist fuer sich dekodierbar.
+        sock = socket.socket(socket.AF_INET, socket.SOCK_DGRAM)
+        sock.bind(('', args.udp))
+        while True:
+            data, _ = sock.recvfrom(65535)
+            decode(data, formats, args.utc, sys.stdout)
+            sys.stdout.flush()
+    if not args.files:
+        ap.error('keine Eingabe (Dateien oder --udp)')
+    for name in args.files:
+        if name == '-':
+            data = sys.stdin.buffer.read()
+        else:
+            with open(name, 'rb') as f:
+                data = f.read()
+        decode(data, formats, args.utc, sys.stdout)
+
+
+if __name__ == '__main__':
+    main()